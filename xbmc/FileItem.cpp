@@ -62,6 +62,7 @@
 #include <algorithm>
 #include <cstdlib>
 #include <mutex>
+#include <unordered_set>
 
 using namespace KODI;
 using namespace XFILE;
@@ -330,6 +331,7 @@ CFileItem::CFileItem(const CGenre& genre)
 
 CFileItem::CFileItem(const CFileItem& item)
   : CGUIListItem(item),
+    m_mimetype(&StringUtils::Empty),
     m_musicInfoTag(NULL),
     m_videoInfoTag(NULL),
     m_pictureInfoTag(NULL),
@@ -536,6 +538,7 @@ CFileItem& CFileItem::operator=(const CFileItem& item)
 
 void CFileItem::Initialize()
 {
+  m_mimetype = &StringUtils::Empty;
   m_musicInfoTag = NULL;
   m_videoInfoTag = NULL;
   m_pictureInfoTag = NULL;
@@ -575,7 +578,7 @@ void CFileItem::Reset()
   m_strDynPath.clear();
   m_dateTime.Reset();
   m_strLockCode.clear();
-  m_mimetype.clear();
+  m_mimetype = &StringUtils::Empty;
   delete m_musicInfoTag;
   m_musicInfoTag=NULL;
   delete m_videoInfoTag;
@@ -623,7 +626,7 @@ void CFileItem::Archive(CArchive& ar)
     ar << m_iBadPwdCount;
 
     ar << m_bCanQueue;
-    ar << m_mimetype;
+    ar << *m_mimetype;
     ar << m_extrainfo;
     ar << m_specialSort;
     ar << m_doContentLookup;
@@ -680,7 +683,9 @@ void CFileItem::Archive(CArchive& ar)
     ar >> m_iBadPwdCount;
 
     ar >> m_bCanQueue;
-    ar >> m_mimetype;
+    std::string mimetype;
+    ar >> mimetype;
+    SetMimeType(mimetype);
     ar >> m_extrainfo;
     ar >> temp;
     m_specialSort = (SortSpecial)temp;
@@ -714,7 +719,7 @@ void CFileItem::Serialize(CVariant& value) const
   value["size"] = m_dwSize;
   value["DVDLabel"] = m_strDVDLabel;
   value["title"] = m_strTitle;
-  value["mimetype"] = m_mimetype;
+  value["mimetype"] = *m_mimetype;
   value["extrainfo"] = m_extrainfo;
 
   if (m_musicInfoTag)
@@ -871,7 +876,7 @@ bool CFileItem::Exists(bool bUseCache /* = true */) const
 bool CFileItem::IsVideo() const
 {
   /* check preset mime type */
-  if(StringUtils::StartsWithNoCase(m_mimetype, "video/"))
+  if(StringUtils::StartsWithNoCase(*m_mimetype, "video/"))
     return true;
 
   if (HasVideoInfoTag())
@@ -898,9 +903,9 @@ bool CFileItem::IsVideo() const
     return true;
 
   std::string extension;
-  if(StringUtils::StartsWithNoCase(m_mimetype, "application/"))
+  if(StringUtils::StartsWithNoCase(*m_mimetype, "application/"))
   { /* check for some standard types */
-    extension = m_mimetype.substr(12);
+    extension = m_mimetype->substr(12);
     if( StringUtils::EqualsNoCase(extension, "ogg")
      || StringUtils::EqualsNoCase(extension, "mp4")
      || StringUtils::EqualsNoCase(extension, "mxf") )
@@ -967,7 +972,7 @@ bool CFileItem::IsDiscStub() const
 bool CFileItem::IsAudio() const
 {
   /* check preset mime type */
-  if(StringUtils::StartsWithNoCase(m_mimetype, "audio/"))
+  if(StringUtils::StartsWithNoCase(*m_mimetype, "audio/"))
     return true;
 
   if (HasMusicInfoTag())
@@ -985,9 +990,9 @@ bool CFileItem::IsAudio() const
   if (IsCDDA())
     return true;
 
-  if(StringUtils::StartsWithNoCase(m_mimetype, "application/"))
+  if(StringUtils::StartsWithNoCase(*m_mimetype, "application/"))
   { /* check for some standard types */
-    std::string extension = m_mimetype.substr(12);
+    std::string extension = m_mimetype->substr(12);
     if( StringUtils::EqualsNoCase(extension, "ogg")
      || StringUtils::EqualsNoCase(extension, "mp4")
      || StringUtils::EqualsNoCase(extension, "mxf") )
@@ -1038,7 +1043,7 @@ bool CFileItem::IsGame() const
 
 bool CFileItem::IsPicture() const
 {
-  if (StringUtils::StartsWithNoCase(m_mimetype, "image/"))
+  if (StringUtils::StartsWithNoCase(*m_mimetype, "image/"))
     return true;
 
   if (HasPictureInfoTag())
@@ -1246,7 +1251,7 @@ bool CFileItem::IsRSS() const
 {
   return StringUtils::StartsWithNoCase(m_strPath, "rss://") || URIUtils::HasExtension(m_strPath, ".rss")
       || StringUtils::StartsWithNoCase(m_strPath, "rsss://")
-      || m_mimetype == "application/rss+xml";
+      || *m_mimetype == "application/rss+xml";
 }
 
 bool CFileItem::IsAndroidApp() const
@@ -1576,15 +1581,41 @@ bool CFileItem::IsParentFolder() const
   return m_bIsParentFolder;
 }
 
+namespace
+{
+/*!
+ \brief Get the shared copy of a mime type
+ There are only a few distinct mime types but every item of a list has one, so they are stored
+ once and never freed.
+ */
+const std::string& InternMimeType(const std::string& mimetype)
+{
+  if (mimetype.empty())
+    return StringUtils::Empty;
+
+  static std::mutex lock;
+  static std::unordered_set<std::string> mimetypes;
+
+  std::unique_lock<std::mutex> guard(lock);
+  return *mimetypes.insert(mimetype).first;
+}
+} // namespace
+
+void CFileItem::SetMimeType(const std::string& mimetype)
+{
+  m_mimetype = &InternMimeType(mimetype);
+}
+
 void CFileItem::FillInMimeType(bool lookup /*= true*/)
 {
   //! @todo adapt this to use CMime::GetMimeType()
-  if (m_mimetype.empty())
+  if (m_mimetype->empty())
   {
+    std::string mimetype;
     if (m_bIsFolder)
-      m_mimetype = "x-directory/normal";
+      mimetype = "x-directory/normal";
     else if (HasPVRChannelInfoTag())
-      m_mimetype = GetPVRChannelInfoTag()->MimeType();
+      mimetype = GetPVRChannelInfoTag()->MimeType();
     else if (StringUtils::StartsWithNoCase(GetDynPath(), "shout://") ||
              StringUtils::StartsWithNoCase(GetDynPath(), "http://") ||
              StringUtils::StartsWithNoCase(GetDynPath(), "https://"))
@@ -1593,32 +1624,34 @@ void CFileItem::FillInMimeType(bool lookup /*= true*/)
       if (!lookup)
         return;
 
-      CCurlFile::GetMimeType(GetDynURL(), m_mimetype);
+      CCurlFile::GetMimeType(GetDynURL(), mimetype);
 
       // try to get mime-type again but with an NSPlayer User-Agent
       // in order for server to provide correct mime-type.  Allows us
       // to properly detect an MMS stream
-      if (StringUtils::StartsWithNoCase(m_mimetype, "video/x-ms-"))
-        CCurlFile::GetMimeType(GetDynURL(), m_mimetype, "NSPlayer/11.00.6001.7000");
+      if (StringUtils::StartsWithNoCase(mimetype, "video/x-ms-"))
+        CCurlFile::GetMimeType(GetDynURL(), mimetype, "NSPlayer/11.00.6001.7000");
 
       // make sure there are no options set in mime-type
       // mime-type can look like "video/x-ms-asf ; charset=utf8"
-      size_t i = m_mimetype.find(';');
+      size_t i = mimetype.find(';');
       if(i != std::string::npos)
-        m_mimetype.erase(i, m_mimetype.length() - i);
-      StringUtils::Trim(m_mimetype);
+        mimetype.erase(i, mimetype.length() - i);
+      StringUtils::Trim(mimetype);
     }
     else
-      m_mimetype = CMime::GetMimeType(*this);
+      mimetype = CMime::GetMimeType(*this);
 
     // if it's still empty set to an unknown type
-    if (m_mimetype.empty())
-      m_mimetype = "application/octet-stream";
+    if (mimetype.empty())
+      mimetype = "application/octet-stream";
+
+    SetMimeType(mimetype);
   }
 
   // change protocol to mms for the following mime-type.  Allows us to create proper FileMMS.
-  if(StringUtils::StartsWithNoCase(m_mimetype, "application/vnd.ms.wms-hdr.asfv1") ||
-     StringUtils::StartsWithNoCase(m_mimetype, "application/x-mms-framed"))
+  if(StringUtils::StartsWithNoCase(*m_mimetype, "application/vnd.ms.wms-hdr.asfv1") ||
+     StringUtils::StartsWithNoCase(*m_mimetype, "application/x-mms-framed"))
   {
     if (m_strDynPath.empty())
       m_strDynPath = m_strPath;
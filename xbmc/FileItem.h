@@ -528,10 +528,10 @@ public:
   bool LoadDetails();
 
   /* Returns the content type of this item if known */
-  const std::string& GetMimeType() const { return m_mimetype; }
+  const std::string& GetMimeType() const { return *m_mimetype; }
 
   /* sets the mime-type if known beforehand */
-  void SetMimeType(const std::string& mimetype) { m_mimetype = mimetype; } ;
+  void SetMimeType(const std::string& mimetype);
 
   /*! \brief Resolve the MIME type based on file extension or a web lookup
    If m_mimetype is already set (non-empty), this function has no effect. For
@@ -648,13 +648,8 @@ private:
   std::string m_strPath;            ///< complete path to item
   std::string m_strDynPath;
 
-  SortSpecial m_specialSort;
-  bool m_bIsParentFolder;
-  bool m_bCanQueue;
-  bool m_bLabelPreformatted;
-  std::string m_mimetype;
+  const std::string* m_mimetype;    ///< shared by all items with the same mime type
   std::string m_extrainfo;
-  bool m_doContentLookup;
   MUSIC_INFO::CMusicInfoTag* m_musicInfoTag;
   CVideoInfoTag* m_videoInfoTag;
   std::shared_ptr<PVR::CPVREpgInfoTag> m_epgInfoTag;
@@ -666,11 +661,18 @@ private:
   std::shared_ptr<const ADDON::IAddon> m_addonInfo;
   KODI::GAME::CGameInfoTag* m_gameInfoTag;
   EventPtr m_eventLogEntry;
-  bool m_bIsAlbum;
   int64_t m_lStartOffset;
   int64_t m_lEndOffset;
 
   CCueDocumentPtr m_cueDocument;
+
+  // kept together to avoid padding between the larger members
+  SortSpecial m_specialSort;
+  bool m_bIsParentFolder;
+  bool m_bCanQueue;
+  bool m_bLabelPreformatted;
+  bool m_doContentLookup;
+  bool m_bIsAlbum;
 };
 
 /*!
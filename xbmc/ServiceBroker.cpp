@@ -267,6 +267,11 @@ CDatabaseManager& CServiceBroker::GetDatabaseManager()
   return g_application.m_ServiceManager->GetDatabaseManager();
 }
 
+CSmartPlaylistCache& CServiceBroker::GetSmartPlaylistCache()
+{
+  return g_application.m_ServiceManager->GetSmartPlaylistCache();
+}
+
 CEventLog* CServiceBroker::GetEventLog()
 {
   if (!g_serviceBroker.m_pSettingsComponent)
@@ -68,6 +68,7 @@ class CPowerManager;
 class CWeatherManager;
 class CPlayerCoreFactory;
 class CDatabaseManager;
+class CSmartPlaylistCache;
 class CEventLog;
 class CGUIComponent;
 class CAppInboundProtocol;
@@ -163,6 +164,7 @@ public:
   static CWeatherManager& GetWeatherManager();
   static CPlayerCoreFactory& GetPlayerCoreFactory();
   static CDatabaseManager& GetDatabaseManager();
+  static CSmartPlaylistCache& GetSmartPlaylistCache();
   static CEventLog* GetEventLog();
   static CMediaManager& GetMediaManager();
   static CComponentContainer<IApplicationComponent>& GetAppComponents();
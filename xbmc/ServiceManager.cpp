@@ -29,6 +29,7 @@
 #include "interfaces/python/XBPython.h"
 #include "network/Network.h"
 #include "peripherals/Peripherals.h"
+#include "playlists/SmartPlaylistCache.h"
 #if defined(HAS_FILESYSTEM_SMB)
 #include "network/IWSDiscovery.h"
 #if defined(TARGET_WINDOWS)
@@ -67,6 +68,7 @@ bool CServiceManager::InitForTesting()
   m_network = CNetworkBase::GetNetwork();
 
   m_databaseManager.reset(new CDatabaseManager);
+  m_smartPlaylistCache.reset(new CSmartPlaylistCache);
 
   m_binaryAddonManager.reset(new ADDON::CBinaryAddonManager());
   m_addonMgr.reset(new ADDON::CAddonMgr());
@@ -90,6 +92,7 @@ void CServiceManager::DeinitTesting()
   m_extsMimeSupportList.reset();
   m_binaryAddonManager.reset();
   m_addonMgr.reset();
+  m_smartPlaylistCache.reset();
   m_databaseManager.reset();
   m_network.reset();
 }
@@ -119,6 +122,10 @@ bool CServiceManager::InitStageTwo(const std::string& profilesUserDataFolder)
   // Initialize the addon database (must be before the addon manager is init'd)
   m_databaseManager.reset(new CDatabaseManager);
 
+  // smart playlist listings are cached until the library announces changes
+  m_smartPlaylistCache.reset(new CSmartPlaylistCache);
+  m_smartPlaylistCache->Initialize();
+
   m_binaryAddonManager.reset(
       new ADDON::
           CBinaryAddonManager()); /* Need to constructed before, GetRunningInstance() of binary CAddonDll need to call them */
@@ -256,6 +263,7 @@ void CServiceManager::DeinitStageTwo()
   m_repositoryUpdater.reset();
   m_binaryAddonManager.reset();
   m_addonMgr.reset();
+  m_smartPlaylistCache.reset();
   m_databaseManager.reset();
 
   m_mediaManager->Stop();
@@ -436,6 +444,11 @@ CDatabaseManager& CServiceManager::GetDatabaseManager()
   return *m_databaseManager;
 }
 
+CSmartPlaylistCache& CServiceManager::GetSmartPlaylistCache()
+{
+  return *m_smartPlaylistCache;
+}
+
 CMediaManager& CServiceManager::GetMediaManager()
 {
   return *m_mediaManager;
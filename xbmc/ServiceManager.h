@@ -82,6 +82,7 @@ class CInputManager;
 class CFileExtensionProvider;
 class CPlayerCoreFactory;
 class CDatabaseManager;
+class CSmartPlaylistCache;
 class CProfileManager;
 class CEventLog;
 class CMediaManager;
@@ -141,6 +142,8 @@ public:
 
   CDatabaseManager& GetDatabaseManager();
 
+  CSmartPlaylistCache& GetSmartPlaylistCache();
+
   CMediaManager& GetMediaManager();
 
 #if !defined(TARGET_WINDOWS) && defined(HAS_DVD_DRIVE)
@@ -193,6 +196,7 @@ protected:
   std::unique_ptr<CWeatherManager> m_weatherManager;
   std::unique_ptr<CPlayerCoreFactory> m_playerCoreFactory;
   std::unique_ptr<CDatabaseManager> m_databaseManager;
+  std::unique_ptr<CSmartPlaylistCache> m_smartPlaylistCache;
   std::unique_ptr<CMediaManager> m_mediaManager;
 #if !defined(TARGET_WINDOWS) && defined(HAS_DVD_DRIVE)
   std::unique_ptr<MEDIA_DETECT::CDetectDVDMedia> m_DetectDVDType;
@@ -17,12 +17,14 @@ using namespace ActiveAE;
 #include "ActiveAEStream.h"
 #include "ServiceBroker.h"
 #include "cores/AudioEngine/Interfaces/IAudioCallback.h"
+#include "cores/AudioEngine/Utils/AEMixKernels.h"
 #include "cores/AudioEngine/Utils/AEUtil.h"
 #include "cores/AudioEngine/Utils/AEStreamData.h"
 #include "cores/AudioEngine/Utils/AEStreamInfo.h"
 #include "cores/AudioEngine/AEResampleFactory.h"
 #include "cores/AudioEngine/Encoders/AEEncoderFFmpeg.h"
 
+#include "settings/AdvancedSettings.h"
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
 #include "windowing/WinSystem.h"
@@ -35,6 +37,10 @@ namespace
 constexpr float MAX_CACHE_LEVEL = 0.4f; // total cache time of stream in seconds;
 constexpr float MAX_WATER_LEVEL = 0.2f; // buffered time after stream stages in seconds;
 constexpr double MAX_BUFFER_TIME = 0.1; // max time of a buffer in seconds;
+
+// in low latency mode the limits above are derived from the configured period time
+constexpr float LOWLATENCY_CACHE_PERIODS = 8.0f;
+constexpr float LOWLATENCY_WATER_PERIODS = 3.0f;
 } // unnamed namespace
 
 void CEngineStats::Reset(unsigned int sampleRate, bool pcm)
@@ -229,12 +235,56 @@ float CEngineStats::GetCacheTime(CActiveAEStream *stream)
 
 float CEngineStats::GetCacheTotal()
 {
-  return MAX_CACHE_LEVEL;
+  std::unique_lock<CCriticalSection> lock(m_lock);
+  return m_maxCacheLevel;
+}
+
+float CEngineStats::GetMaxDelay()
+{
+  std::unique_lock<CCriticalSection> lock(m_lock);
+  return m_maxCacheLevel + m_maxWaterLevel + m_sinkCacheTotal;
+}
+
+float CEngineStats::GetOutputLatency()
+{
+  std::unique_lock<CCriticalSection> lock(m_lock);
+  return m_maxWaterLevel + m_sinkCacheTotal + m_sinkLatency;
+}
+
+float CEngineStats::GetMaxWaterLevel()
+{
+  std::unique_lock<CCriticalSection> lock(m_lock);
+  return m_maxWaterLevel;
+}
+
+double CEngineStats::GetMaxBufferTime()
+{
+  std::unique_lock<CCriticalSection> lock(m_lock);
+  return m_maxBufferTime;
+}
+
+void CEngineStats::SetBufferLimits(bool lowLatency, unsigned int period)
+{
+  std::unique_lock<CCriticalSection> lock(m_lock);
+  if (lowLatency)
+  {
+    const float periodTime = period / 1000.0f;
+    m_maxCacheLevel = std::min(MAX_CACHE_LEVEL, LOWLATENCY_CACHE_PERIODS * periodTime);
+    m_maxWaterLevel = std::min(MAX_WATER_LEVEL, LOWLATENCY_WATER_PERIODS * periodTime);
+    m_maxBufferTime = std::min(MAX_BUFFER_TIME, static_cast<double>(periodTime));
+  }
+  else
+  {
+    m_maxCacheLevel = MAX_CACHE_LEVEL;
+    m_maxWaterLevel = MAX_WATER_LEVEL;
+    m_maxBufferTime = MAX_BUFFER_TIME;
+  }
 }
 
-float CEngineStats::GetMaxDelay() const
+void CEngineStats::SetSinkLatency(float time)
 {
-  return MAX_CACHE_LEVEL + MAX_WATER_LEVEL + m_sinkCacheTotal;
+  std::unique_lock<CCriticalSection> lock(m_lock);
+  m_sinkLatency = time;
 }
 
 float CEngineStats::GetWaterLevel()
@@ -293,6 +343,12 @@ CActiveAE::CActiveAE() :
   m_aeGUISoundForce = false;
   m_stats.Reset(44100, true);
   m_streamIdGen = 0;
+  m_stats.SetBufferLimits(false, 0);
+  m_maxCacheLevel = m_stats.GetCacheTotal();
+  m_maxWaterLevel = m_stats.GetMaxWaterLevel();
+  m_maxBufferTime = m_stats.GetMaxBufferTime();
+  m_stats.SetSinkCacheTotal(0);
+  m_stats.SetSinkLatency(0);
 
   m_settingsHandler.reset(new CActiveAESettings(*this));
 }
@@ -1194,6 +1250,7 @@ void CActiveAE::Configure(AEAudioFormat *desiredFmt)
 
   m_sinkRequestFormat = inputFormat;
   ApplySettingsToFormat(m_sinkRequestFormat, m_settings, (int*)&m_mode);
+  UpdateBufferLimits();
   m_extKeepConfig = 0ms;
 
   std::string device = (m_sinkRequestFormat.m_dataFormat == AE_FMT_RAW) ? m_settings.passthroughdevice : m_settings.device;
@@ -1216,14 +1273,22 @@ void CActiveAE::Configure(AEAudioFormat *desiredFmt)
     {
       // limit buffer size in case of sink returns large buffer
       double buffertime = (double)m_sinkFormat.m_frames / m_sinkFormat.m_sampleRate;
-      if (buffertime > MAX_BUFFER_TIME)
+      if (buffertime > m_maxBufferTime)
       {
         CLog::Log(LOGWARNING,
                   "ActiveAE::{} - sink returned large period time of {} ms, reducing to {} ms",
-                  __FUNCTION__, (int)(buffertime * 1000), (int)(MAX_BUFFER_TIME * 1000));
-        m_sinkFormat.m_frames = MAX_BUFFER_TIME * m_sinkFormat.m_sampleRate;
+                  __FUNCTION__, (int)(buffertime * 1000), (int)(m_maxBufferTime * 1000));
+        m_sinkFormat.m_frames = m_maxBufferTime * m_sinkFormat.m_sampleRate;
       }
     }
+
+    CLog::Log(LOGINFO,
+              "ActiveAE::{} - output latency {} ms (period {} ms, engine {} ms, sink {} ms){}",
+              __FUNCTION__, static_cast<int>(m_stats.GetOutputLatency() * 1000),
+              m_sinkFormat.m_frames * 1000 / std::max(m_sinkFormat.m_sampleRate, 1u),
+              static_cast<int>(m_maxWaterLevel * 1000),
+              static_cast<int>((m_stats.GetOutputLatency() - m_maxWaterLevel) * 1000),
+              m_settings.lowLatency ? ", low latency mode" : "");
   }
 
   if (m_silenceBuffers)
@@ -1245,7 +1310,7 @@ void CActiveAE::Configure(AEAudioFormat *desiredFmt)
     inputFormat.m_frameSize = inputFormat.m_channelLayout.Count() *
                               (CAEUtil::DataFormatToBits(inputFormat.m_dataFormat) >> 3);
     m_silenceBuffers = new CActiveAEBufferPool(inputFormat);
-    m_silenceBuffers->Create(MAX_WATER_LEVEL*1000);
+    m_silenceBuffers->Create(m_maxWaterLevel*1000);
     sinkInputFormat = inputFormat;
     m_internalFormat = inputFormat;
 
@@ -1325,7 +1390,7 @@ void CActiveAE::Configure(AEAudioFormat *desiredFmt)
         if (!m_encoderBuffers)
         {
           m_encoderBuffers = new CActiveAEBufferPool(format);
-          m_encoderBuffers->Create(MAX_WATER_LEVEL*1000);
+          m_encoderBuffers->Create(m_maxWaterLevel*1000);
         }
       }
 
@@ -1367,7 +1432,7 @@ void CActiveAE::Configure(AEAudioFormat *desiredFmt)
 
         // create buffer pool
         (*it)->m_inputBuffers = new CActiveAEBufferPool((*it)->m_format);
-        (*it)->m_inputBuffers->Create(MAX_CACHE_LEVEL*1000);
+        (*it)->m_inputBuffers->Create(m_maxCacheLevel*1000);
         (*it)->m_streamSpace = (*it)->m_format.m_frameSize * (*it)->m_format.m_frames;
 
         // if input format does not follow ffmpeg channel mask, we may need to remap channels
@@ -1386,7 +1451,7 @@ void CActiveAE::Configure(AEAudioFormat *desiredFmt)
         (*it)->m_processingBuffers = new CActiveAEStreamBuffers((*it)->m_inputBuffers->m_format, outputFormat, m_settings.resampleQuality);
         (*it)->m_processingBuffers->ForceResampler((*it)->m_forceResampler);
 
-        (*it)->m_processingBuffers->Create(MAX_CACHE_LEVEL*1000, false, m_settings.stereoupmix, m_settings.normalizelevels);
+        (*it)->m_processingBuffers->Create(m_maxCacheLevel*1000, false, m_settings.stereoupmix, m_settings.normalizelevels);
       }
       if (m_mode == MODE_TRANSCODE || m_streams.size() > 1)
         (*it)->m_processingBuffers->FillBuffer();
@@ -1447,7 +1512,7 @@ void CActiveAE::Configure(AEAudioFormat *desiredFmt)
   if (!m_sinkBuffers)
   {
     m_sinkBuffers = new CActiveAEBufferPoolResample(sinkInputFormat, m_sinkFormat, m_settings.resampleQuality);
-    m_sinkBuffers->Create(MAX_WATER_LEVEL*1000, true, false);
+    m_sinkBuffers->Create(m_maxWaterLevel*1000, true, false);
   }
 
   // reset gui sounds
@@ -1617,7 +1682,7 @@ void CActiveAE::ClearDiscardedBuffers()
       rbuf->Flush();
     }
     // if all buffers have returned, we can delete the buffer pool
-    if ((*it)->m_allSamples.size() == (*it)->m_freeSamples.size())
+    if ((*it)->AllBuffersFree())
     {
       delete (*it);
       CLog::Log(LOGDEBUG, "CActiveAE::ClearDiscardedBuffers - buffer pool deleted");
@@ -1812,6 +1877,7 @@ bool CActiveAE::InitSink()
   config.stats = &m_stats;
   config.device = (m_sinkRequestFormat.m_dataFormat == AE_FMT_RAW) ? &m_settings.passthroughdevice :
                                                                      &m_settings.device;
+  config.lowLatency = m_settings.lowLatency;
 
   // send message to sink
   m_sink.m_controlPort.SendOutMessage(CSinkControlProtocol::SETNOISETYPE, &m_settings.streamNoise, sizeof(bool));
@@ -1943,8 +2009,8 @@ bool CActiveAE::RunStages()
       float buftime = (float)(*it)->m_inputBuffers->m_format.m_frames / (*it)->m_inputBuffers->m_format.m_sampleRate;
       if ((*it)->m_inputBuffers->m_format.m_dataFormat == AE_FMT_RAW)
         buftime = (*it)->m_inputBuffers->m_format.m_streamInfo.GetDuration() / 1000;
-      while ((time < MAX_CACHE_LEVEL || (*it)->m_streamIsBuffering) &&
-             !(*it)->m_inputBuffers->m_freeSamples.empty())
+      while ((time < m_maxCacheLevel || (*it)->m_streamIsBuffering) &&
+             (*it)->m_inputBuffers->HasFreeBuffer())
       {
         buffer = (*it)->m_inputBuffers->GetFreeBuffer();
         (*it)->m_processingSamples.push_back(buffer);
@@ -1988,8 +2054,8 @@ bool CActiveAE::RunStages()
   const bool ignoreWL =
       (m_mode == MODE_RAW && m_sinkFormat.m_streamInfo.m_type == CAEStreamInfo::STREAM_TYPE_TRUEHD);
 
-  if ((m_stats.GetWaterLevel() < (MAX_WATER_LEVEL + 0.0001f) || ignoreWL) &&
-      (m_mode != MODE_TRANSCODE || (m_encoderBuffers && !m_encoderBuffers->m_freeSamples.empty())))
+  if ((m_stats.GetWaterLevel() < (m_maxWaterLevel + 0.0001f) || ignoreWL) &&
+      (m_mode != MODE_TRANSCODE || (m_encoderBuffers && m_encoderBuffers->HasFreeBuffer())))
   {
     // calculate sync error
     for (it = m_streams.begin(); it != m_streams.end(); ++it)
@@ -2030,7 +2096,7 @@ bool CActiveAE::RunStages()
       CSampleBuffer *out = NULL;
       if (!m_sounds_playing.empty() && m_streams.empty())
       {
-        if (m_silenceBuffers && !m_silenceBuffers->m_freeSamples.empty())
+        if (m_silenceBuffers && m_silenceBuffers->HasFreeBuffer())
         {
           out = m_silenceBuffers->GetFreeBuffer();
           for (int i=0; i<out->pkt->planes; i++)
@@ -2139,15 +2205,8 @@ bool CActiveAE::RunStages()
 
               for(int j=0; j<out->pkt->planes; j++)
               {
-#if defined(HAVE_SSE) && defined(__SSE__)
-                CAEUtil::SSEMulArray((float*)out->pkt->data[j]+i*nb_floats, volume, nb_floats);
-#else
-                float* fbuffer = (float*) out->pkt->data[j]+i*nb_floats;
-                for (int k = 0; k < nb_floats; ++k)
-                {
-                  fbuffer[k] *= volume;
-                }
-#endif
+                CAEMixKernels::MulArray((float*)out->pkt->data[j] + i * nb_floats, volume,
+                                        nb_floats);
               }
             }
           }
@@ -2208,24 +2267,8 @@ bool CActiveAE::RunStages()
               {
                 float *dst = (float*)out->pkt->data[j]+i*nb_floats;
                 float *src = (float*)mix->pkt->data[j]+i*nb_floats;
-#if defined(HAVE_SSE) && defined(__SSE__)
-                CAEUtil::SSEMulAddArray(dst, src, volume, nb_floats);
-                for (int k = 0; k < nb_floats; ++k)
-                {
-                  if (fabs(dst[k]) > 1.0f)
-                  {
-                    needClamp = true;
-                    break;
-                  }
-                }
-#else
-                for (int k = 0; k < nb_floats; ++k)
-                {
-                  dst[k] += src[k] * volume;
-                  if (fabs(dst[k]) > 1.0f)
-                    needClamp = true;
-                }
-#endif
+                if (CAEMixKernels::MulAddArray(dst, src, volume, nb_floats))
+                  needClamp = true;
               }
             }
             mix->Return();
@@ -2240,7 +2283,7 @@ bool CActiveAE::RunStages()
         int nb_floats = out->pkt->nb_samples * out->pkt->config.channels / out->pkt->planes;
         for (int i=0; i<out->pkt->planes; i++)
         {
-          CAEUtil::ClampArray((float*)out->pkt->data[i], nb_floats);
+          CAEMixKernels::ClampArray((float*)out->pkt->data[i], nb_floats);
         }
       }
 
@@ -2260,7 +2303,7 @@ bool CActiveAE::RunStages()
               m_vizInitialized = true;
             }
 
-            if (!m_vizBuffersInput->m_freeSamples.empty())
+            if (m_vizBuffersInput->HasFreeBuffer())
             {
               // copy the samples into the viz input buffer
               CSampleBuffer *viz = m_vizBuffersInput->GetFreeBuffer();
@@ -2614,12 +2657,7 @@ void CActiveAE::MixSounds(CSoundPacket &dstSample)
       out = (float*)dstSample.data[j];
       sample_buffer = (float*)(it->sound->GetSound(false)->data[j]+start);
       int nb_floats = mix_samples * dstSample.config.channels / dstSample.planes;
-#if defined(HAVE_SSE) && defined(__SSE__)
-      CAEUtil::SSEMulAddArray(out, sample_buffer, volume, nb_floats);
-#else
-      for (int k = 0; k < nb_floats; ++k)
-        *out++ += *sample_buffer++ * volume;
-#endif
+      CAEMixKernels::MulAddArray(out, sample_buffer, volume, nb_floats);
     }
 
     it->samples_played += mix_samples;
@@ -2644,13 +2682,7 @@ void CActiveAE::Deamplify(CSoundPacket &dstSample)
     for(int j=0; j<dstSample.planes; j++)
     {
       float* buffer = reinterpret_cast<float*>(dstSample.data[j]);
-#if defined(HAVE_SSE) && defined(__SSE__)
-      CAEUtil::SSEMulArray(buffer, volume, nb_floats);
-#else
-      float *fbuffer = buffer;
-      for (int i = 0; i < nb_floats; i++)
-        *fbuffer++ *= volume;
-#endif
+      CAEMixKernels::MulArray(buffer, volume, nb_floats);
     }
   }
 }
@@ -2690,10 +2722,44 @@ void CActiveAE::LoadSettings()
   m_settings.atempoThreshold = settings->GetInt(CSettings::SETTING_AUDIOOUTPUT_ATEMPOTHRESHOLD) / 100.0;
   m_settings.streamNoise = settings->GetBool(CSettings::SETTING_AUDIOOUTPUT_STREAMNOISE);
   m_settings.silenceTimeoutMinutes = settings->GetInt(CSettings::SETTING_AUDIOOUTPUT_STREAMSILENCE);
+
+  const std::shared_ptr<CAdvancedSettings> advancedSettings =
+      CServiceBroker::GetSettingsComponent()->GetAdvancedSettings();
+  m_settings.lowLatency = advancedSettings->m_audioLowLatency;
+  m_settings.lowLatencyPeriod = advancedSettings->m_audioLowLatencyPeriod;
+
+  if (m_settings.lowLatency && !m_lowLatencyPriority)
+  {
+    // only called from the engine thread
+    m_lowLatencyPriority = true;
+    const bool realtime = CAEUtil::SetRealtimePriority();
+    if (!realtime)
+      SetPriority(ThreadPriority::HIGHEST);
+    CLog::Log(LOGINFO, "ActiveAE::{} - low latency mode, period {} ms, {} engine thread",
+              __FUNCTION__, m_settings.lowLatencyPeriod, realtime ? "realtime" : "high priority");
+  }
+}
+
+float CActiveAE::GetOutputLatency()
+{
+  return m_stats.GetOutputLatency();
+}
+
+void CActiveAE::UpdateBufferLimits()
+{
+  // passthrough packets are too large for the small low latency buffers
+  m_stats.SetBufferLimits(m_settings.lowLatency && m_mode == MODE_PCM,
+                          m_settings.lowLatencyPeriod);
+  m_maxCacheLevel = m_stats.GetCacheTotal();
+  m_maxWaterLevel = m_stats.GetMaxWaterLevel();
+  m_maxBufferTime = m_stats.GetMaxBufferTime();
 }
 
 void CActiveAE::Start()
 {
+  CLog::Log(LOGINFO, "ActiveAE::{} - using {} mixing kernels", __FUNCTION__,
+            CAEMixKernels::GetImplName(CAEMixKernels::GetImpl()));
+
   Create();
   Message *reply;
   if (m_controlPort.SendOutMessageSync(CActiveAEControlProtocol::INIT,
@@ -62,6 +62,8 @@ struct AudioSettings
   double atempoThreshold;
   bool streamNoise;
   int silenceTimeoutMinutes;
+  bool lowLatency;
+  unsigned int lowLatencyPeriod; // ms
 };
 
 class CActiveAEControlProtocol : public Protocol
@@ -192,16 +194,28 @@ public:
   void GetSyncInfo(CAESyncInfo& info, CActiveAEStream *stream);
   float GetCacheTime(CActiveAEStream *stream);
   float GetCacheTotal();
-  float GetMaxDelay() const;
+  float GetMaxDelay();
+  float GetOutputLatency();
   float GetWaterLevel();
+  float GetMaxWaterLevel();
+  double GetMaxBufferTime();
+  /*!
+   * \brief Set the cache and buffer limits of the engine
+   * \param lowLatency derive the limits from the period time instead of using the defaults
+   * \param period period time of the sink in ms, used in low latency mode only
+   */
+  void SetBufferLimits(bool lowLatency, unsigned int period);
   void SetSuspended(bool state);
   void SetCurrentSinkFormat(const AEAudioFormat& SinkFormat);
   void SetSinkCacheTotal(float time) { m_sinkCacheTotal = time; }
-  void SetSinkLatency(float time) { m_sinkLatency = time; }
+  void SetSinkLatency(float time);
   void SetSinkNeedIec(bool needIEC) { m_sinkNeedIecPack = needIEC; }
   bool IsSuspended();
   AEAudioFormat GetCurrentSinkFormat();
 protected:
+  float m_maxCacheLevel;
+  float m_maxWaterLevel;
+  double m_maxBufferTime;
   float m_sinkCacheTotal;
   float m_sinkLatency;
   int m_bufferedSamples;
@@ -267,6 +281,7 @@ public:
   void DeviceChange() override;
   void DeviceCountChange(const std::string& driver) override;
   bool GetCurrentSinkFormat(AEAudioFormat &SinkFormat) override;
+  float GetOutputLatency() override;
 
   void RegisterAudioCallback(IAudioCallback* pCallback) override;
   void UnregisterAudioCallback(IAudioCallback* pCallback) override;
@@ -307,6 +322,7 @@ protected:
   void UnconfigureSink();
   void Dispose();
   void LoadSettings();
+  void UpdateBufferLimits();
   bool NeedReconfigureBuffers();
   bool NeedReconfigureSink();
   void ApplySettingsToFormat(AEAudioFormat& format,
@@ -364,6 +380,10 @@ protected:
   AEAudioFormat m_internalFormat;
   AEAudioFormat m_inputFormat;
   AudioSettings m_settings;
+  float m_maxCacheLevel; // total cache time of stream in seconds
+  float m_maxWaterLevel; // buffered time after stream stages in seconds
+  double m_maxBufferTime; // max time of a buffer in seconds
+  bool m_lowLatencyPriority = false;
   CEngineStats m_stats;
   IAEEncoder *m_encoder;
   std::string m_currDevice;
@@ -13,6 +13,8 @@
 #include "cores/AudioEngine/AEResampleFactory.h"
 #include "cores/AudioEngine/Utils/AEUtil.h"
 
+#include <algorithm>
+
 using namespace ActiveAE;
 
 CSoundPacket::CSoundPacket(const SampleConfig& conf, int samples) : config(conf)
@@ -36,14 +38,14 @@ CSampleBuffer::~CSampleBuffer()
 
 CSampleBuffer* CSampleBuffer::Acquire()
 {
-  refCount++;
+  refCount.fetch_add(1, std::memory_order_relaxed);
   return this;
 }
 
 void CSampleBuffer::Return()
 {
-  refCount--;
-  if (pool && refCount <= 0)
+  // only the thread dropping the last reference may hand the buffer back
+  if (refCount.fetch_sub(1, std::memory_order_acq_rel) <= 1 && pool)
     pool->ReturnBuffer(this);
 }
 
@@ -73,13 +75,24 @@ CSampleBuffer* CActiveAEBufferPool::GetFreeBuffer()
 {
   CSampleBuffer* buf = NULL;
 
-  if (!m_freeSamples.empty())
+  uint64_t head = m_freeHead.load(std::memory_order_acquire);
+  do
   {
-    buf = m_freeSamples.front();
-    m_freeSamples.pop_front();
-    buf->refCount = 1;
-    buf->centerMixLevel = M_SQRT1_2;
-  }
+    const uint32_t slot = static_cast<uint32_t>(head);
+    if (slot == 0)
+      return NULL;
+
+    buf = m_allSamples[slot - 1];
+    const uint64_t next = ((head >> 32) + 1) << 32 | buf->nextFree.load(std::memory_order_relaxed);
+    if (m_freeHead.compare_exchange_weak(head, next, std::memory_order_acq_rel,
+                                         std::memory_order_acquire))
+      break;
+  } while (true);
+
+  m_freeCount.fetch_sub(1, std::memory_order_relaxed);
+  buf->refCount.store(1, std::memory_order_relaxed);
+  buf->centerMixLevel = M_SQRT1_2;
+  buf->acquireTime = std::chrono::steady_clock::now();
   return buf;
 }
 
@@ -87,7 +100,26 @@ void CActiveAEBufferPool::ReturnBuffer(CSampleBuffer *buffer)
 {
   buffer->pkt->nb_samples = 0;
   buffer->pkt->pause_burst_ms = 0;
-  m_freeSamples.push_back(buffer);
+
+  const uint64_t slot = buffer->poolIndex + 1;
+  uint64_t head = m_freeHead.load(std::memory_order_relaxed);
+  do
+  {
+    buffer->nextFree.store(static_cast<uint32_t>(head), std::memory_order_relaxed);
+  } while (!m_freeHead.compare_exchange_weak(head, ((head >> 32) + 1) << 32 | slot,
+                                             std::memory_order_release,
+                                             std::memory_order_relaxed));
+  m_freeCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool CActiveAEBufferPool::HasFreeBuffer() const
+{
+  return static_cast<uint32_t>(m_freeHead.load(std::memory_order_acquire)) != 0;
+}
+
+bool CActiveAEBufferPool::AllBuffersFree() const
+{
+  return m_freeCount.load(std::memory_order_acquire) == m_allSamples.size();
 }
 
 bool CActiveAEBufferPool::Create(unsigned int totaltime)
@@ -113,9 +145,10 @@ bool CActiveAEBufferPool::Create(unsigned int totaltime)
     buffer = new CSampleBuffer();
     buffer->pool = this;
     buffer->pkt = new CSoundPacket(config, m_format.m_frames);
+    buffer->poolIndex = static_cast<uint32_t>(m_allSamples.size());
 
     m_allSamples.push_back(buffer);
-    m_freeSamples.push_back(buffer);
+    ReturnBuffer(buffer);
     time += buffertime;
     n++;
   }
@@ -231,7 +264,7 @@ bool CActiveAEBufferPoolResample::ResampleBuffers(int64_t timestamp)
       busy = true;
     }
   }
-  else if (m_procSample || !m_freeSamples.empty())
+  else if (m_procSample || HasFreeBuffer())
   {
     int free_samples;
     if (m_procSample)
@@ -296,6 +329,9 @@ bool CActiveAEBufferPoolResample::ResampleBuffers(int64_t timestamp)
 
       if (in)
       {
+        // latency is measured from the oldest audio in the buffer
+        m_procSample->acquireTime = std::min(m_procSample->acquireTime, in->acquireTime);
+
         if (!timestamp)
         {
           if (in->timestamp)
@@ -512,7 +548,7 @@ bool CActiveAEBufferPoolAtempo::ProcessBuffers()
       busy = true;
     }
   }
-  else if (m_procSample || !m_freeSamples.empty())
+  else if (m_procSample || HasFreeBuffer())
   {
     bool skipInput = false;
 
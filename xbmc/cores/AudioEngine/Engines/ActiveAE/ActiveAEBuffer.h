@@ -10,6 +10,8 @@
 
 #include "cores/AudioEngine/Utils/AEAudioFormat.h"
 #include "cores/AudioEngine/Interfaces/AE.h"
+#include <atomic>
+#include <chrono>
 #include <cmath>
 #include <deque>
 #include <memory>
@@ -42,6 +44,11 @@ public:
 
 class CActiveAEBufferPool;
 
+/**
+ * Buffers are handed between the engine, stream and sink threads. Reference counting
+ * is atomic and the last Return() puts the buffer back to the lock-free free list of
+ * its pool, so it is safe from any thread.
+ */
 class CSampleBuffer
 {
 public:
@@ -53,8 +60,13 @@ public:
   CActiveAEBufferPool *pool = nullptr;
   int64_t timestamp;
   int pkt_start_offset = 0;
-  int refCount = 0;
+  std::atomic_int refCount{0};
   double centerMixLevel;
+  // time the audio in this buffer entered the engine, used for latency stats
+  std::chrono::steady_clock::time_point acquireTime;
+  // index in the pool and link of the free list
+  uint32_t poolIndex = 0;
+  std::atomic<uint32_t> nextFree{0};
 };
 
 class CActiveAEBufferPool
@@ -65,9 +77,15 @@ public:
   virtual bool Create(unsigned int totaltime);
   CSampleBuffer *GetFreeBuffer();
   void ReturnBuffer(CSampleBuffer *buffer);
+  bool HasFreeBuffer() const;
+  bool AllBuffersFree() const;
   AEAudioFormat m_format;
   std::deque<CSampleBuffer*> m_allSamples;
-  std::deque<CSampleBuffer*> m_freeSamples;
+
+protected:
+  // head of the free list: ABA tag in the upper, poolIndex + 1 in the lower 32 bits
+  std::atomic<uint64_t> m_freeHead{0};
+  std::atomic<size_t> m_freeCount{0};
 };
 
 class IAEResample;
@@ -9,6 +9,7 @@
 #include "ActiveAESink.h"
 
 #include "ActiveAE.h"
+#include "ServiceBroker.h"
 #include "cores/AudioEngine/AEResampleFactory.h"
 #include "cores/AudioEngine/Utils/AEBitstreamPacker.h"
 #include "cores/AudioEngine/Utils/AEStreamInfo.h"
@@ -265,6 +266,12 @@ void CActiveAESink::StateMachine(int signal, Protocol *port, Message *msg)
             m_requestedFormat = data->format;
             m_stats = data->stats;
             m_device = *(data->device);
+            if (data->lowLatency && !m_lowLatencyPriority)
+            {
+              m_lowLatencyPriority = true;
+              if (!CAEUtil::SetRealtimePriority())
+                SetPriority(ThreadPriority::HIGHEST);
+            }
           }
           m_extError = false;
           m_extSilenceTimer.Set(0ms);
@@ -1081,9 +1088,43 @@ unsigned int CActiveAESink::OutputSamples(CSampleBuffer* samples)
   if (m_requestedFormat.m_dataFormat == AE_FMT_RAW)
     m_stats->UpdateSinkDelay(status, samples->pool ? 1 : 0);
 
+  UpdateBufferLatency(samples);
+
   return status.delay * 1000;
 }
 
+void CActiveAESink::UpdateBufferLatency(const CSampleBuffer* samples)
+{
+  // silence generated by the sink itself does not come from a pool
+  if (!samples->pool)
+    return;
+
+  const auto now = std::chrono::steady_clock::now();
+  const auto latency =
+      std::chrono::duration_cast<std::chrono::microseconds>(now - samples->acquireTime);
+  m_bufferLatency.total += latency;
+  m_bufferLatency.max = std::max(m_bufferLatency.max, latency);
+  m_bufferLatency.count++;
+
+  if (now - m_bufferLatency.lastReport < std::chrono::seconds(10))
+    return;
+
+  if (CServiceBroker::GetLogging().CanLogComponent(LOGAUDIO))
+  {
+    CLog::Log(LOGDEBUG,
+              "CActiveAESink::{} - buffer acquire to sink write latency over {} buffers: "
+              "avg {} ms, max {} ms",
+              __FUNCTION__, m_bufferLatency.count,
+              m_bufferLatency.total.count() / m_bufferLatency.count / 1000.0,
+              m_bufferLatency.max.count() / 1000.0);
+  }
+
+  m_bufferLatency.lastReport = now;
+  m_bufferLatency.total = std::chrono::microseconds::zero();
+  m_bufferLatency.max = std::chrono::microseconds::zero();
+  m_bufferLatency.count = 0;
+}
+
 void CActiveAESink::SwapInit(CSampleBuffer* samples)
 {
   if ((m_requestedFormat.m_dataFormat == AE_FMT_RAW) && CAEUtil::S16NeedsByteSwap(AE_FMT_S16NE, m_sinkFormat.m_dataFormat))
@@ -17,6 +17,7 @@
 #include "threads/Thread.h"
 #include "utils/ActorProtocol.h"
 
+#include <chrono>
 #include <utility>
 
 class CAEBitstreamPacker;
@@ -32,6 +33,7 @@ struct SinkConfig
   AEAudioFormat format;
   CEngineStats *stats;
   const std::string *device;
+  bool lowLatency;
 };
 
 struct SinkReply
@@ -116,6 +118,7 @@ protected:
 
   unsigned int OutputSamples(CSampleBuffer* samples);
   void SwapInit(CSampleBuffer* samples);
+  void UpdateBufferLatency(const CSampleBuffer* samples);
 
   void GenerateNoise();
 
@@ -126,6 +129,7 @@ protected:
   std::chrono::milliseconds m_extTimeout;
   std::chrono::minutes m_silenceTimeOut{std::chrono::minutes::zero()};
   bool m_extError;
+  bool m_lowLatencyPriority = false;
   std::chrono::milliseconds m_extSilenceTimeout;
   bool m_extAppFocused;
   bool m_extStreaming;
@@ -153,6 +157,15 @@ protected:
   CAEBitstreamPacker *m_packer;
   bool m_needIecPack{false};
   bool m_streamNoise;
+
+  // time from buffer acquire in the engine until it was written to the sink
+  struct
+  {
+    std::chrono::steady_clock::time_point lastReport;
+    std::chrono::microseconds total{0};
+    std::chrono::microseconds max{0};
+    unsigned int count = 0;
+  } m_bufferLatency;
 };
 
 }
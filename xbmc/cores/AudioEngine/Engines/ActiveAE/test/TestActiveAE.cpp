@@ -0,0 +1,69 @@
+/*
+ *  Copyright (C) 2023 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/AudioEngine/Engines/ActiveAE/ActiveAE.h"
+
+#include <gtest/gtest.h>
+
+using namespace ActiveAE;
+
+namespace
+{
+// a null sink that keeps four periods of the given time in its buffer and
+// reports no additional device latency, like ALSA:null
+void ConfigureNullSink(CEngineStats& stats, unsigned int period)
+{
+  stats.Reset(48000, true);
+  stats.SetSinkCacheTotal(4 * period / 1000.0f);
+  stats.SetSinkLatency(0);
+}
+} // unnamed namespace
+
+TEST(TestActiveAE, DefaultBufferLimits)
+{
+  CEngineStats stats;
+  ConfigureNullSink(stats, 50);
+  stats.SetBufferLimits(false, 10);
+
+  EXPECT_FLOAT_EQ(0.4f, stats.GetCacheTotal());
+  EXPECT_FLOAT_EQ(0.2f, stats.GetMaxWaterLevel());
+  EXPECT_NEAR(0.1, stats.GetMaxBufferTime(), 1e-6);
+  EXPECT_FLOAT_EQ(0.4f + 0.2f + 0.2f, stats.GetMaxDelay());
+  EXPECT_FLOAT_EQ(0.2f + 0.2f, stats.GetOutputLatency());
+}
+
+TEST(TestActiveAE, LowLatencyBufferLimits)
+{
+  CEngineStats stats;
+  ConfigureNullSink(stats, 10);
+  stats.SetBufferLimits(true, 10);
+
+  // cache and water level are derived from the period time
+  EXPECT_FLOAT_EQ(0.08f, stats.GetCacheTotal());
+  EXPECT_FLOAT_EQ(0.03f, stats.GetMaxWaterLevel());
+  EXPECT_NEAR(0.01, stats.GetMaxBufferTime(), 1e-6);
+  EXPECT_FLOAT_EQ(0.08f + 0.03f + 0.04f, stats.GetMaxDelay());
+  EXPECT_FLOAT_EQ(0.03f + 0.04f, stats.GetOutputLatency());
+
+  // switching back restores the defaults
+  stats.SetBufferLimits(false, 10);
+  EXPECT_FLOAT_EQ(0.4f, stats.GetCacheTotal());
+  EXPECT_FLOAT_EQ(0.2f, stats.GetMaxWaterLevel());
+}
+
+TEST(TestActiveAE, LowLatencyBufferLimitsCapped)
+{
+  CEngineStats stats;
+  ConfigureNullSink(stats, 50);
+  stats.SetBufferLimits(true, 50);
+
+  // long periods never exceed the default limits
+  EXPECT_FLOAT_EQ(0.4f, stats.GetCacheTotal());
+  EXPECT_FLOAT_EQ(0.15f, stats.GetMaxWaterLevel());
+  EXPECT_NEAR(0.05, stats.GetMaxBufferTime(), 1e-6);
+}
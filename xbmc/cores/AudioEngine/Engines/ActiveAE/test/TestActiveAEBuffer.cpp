@@ -0,0 +1,166 @@
+/*
+ *  Copyright (C) 2023 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/AudioEngine/Engines/ActiveAE/ActiveAEBuffer.h"
+
+#include <atomic>
+#include <memory>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace ActiveAE;
+
+namespace
+{
+constexpr int THREADS = 4;
+
+std::unique_ptr<CActiveAEBufferPool> CreatePool()
+{
+  AEAudioFormat format;
+  format.m_dataFormat = AE_FMT_FLOAT;
+  format.m_sampleRate = 48000;
+  format.m_channelLayout = AE_CH_LAYOUT_2_0;
+  format.m_frames = 240;
+  format.m_frameSize = 2 * sizeof(float);
+
+  auto pool = std::make_unique<CActiveAEBufferPool>(format);
+  // 5 ms per buffer
+  pool->Create(50);
+  return pool;
+}
+
+// takes every free buffer off the pool and hands them back, false if one came up twice
+bool CheckFreeList(CActiveAEBufferPool& pool)
+{
+  std::vector<CSampleBuffer*> buffers;
+  std::set<CSampleBuffer*> unique;
+  while (CSampleBuffer* buffer = pool.GetFreeBuffer())
+  {
+    if (!unique.insert(buffer).second || buffers.size() > pool.m_allSamples.size())
+      return false;
+    buffers.push_back(buffer);
+  }
+  for (CSampleBuffer* buffer : buffers)
+    buffer->Return();
+  return buffers.size() == pool.m_allSamples.size();
+}
+} // unnamed namespace
+
+TEST(TestActiveAEBuffer, Create)
+{
+  auto pool = CreatePool();
+  ASSERT_EQ(10u, pool->m_allSamples.size());
+  EXPECT_TRUE(pool->HasFreeBuffer());
+  EXPECT_TRUE(pool->AllBuffersFree());
+  EXPECT_TRUE(CheckFreeList(*pool));
+  EXPECT_TRUE(pool->AllBuffersFree());
+}
+
+TEST(TestActiveAEBuffer, AcquireReturnStress)
+{
+  auto pool = CreatePool();
+  const size_t size = pool->m_allSamples.size();
+
+  // a buffer handed out twice is found by its in use flag
+  std::vector<std::atomic<bool>> inUse(size);
+  std::atomic<int> duplicates{0};
+  std::atomic<int> acquired{0};
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < THREADS; i++)
+  {
+    threads.emplace_back([&pool, &inUse, &duplicates, &acquired]() {
+      std::vector<CSampleBuffer*> held;
+      for (int n = 0; n < 20000; n++)
+      {
+        // hold a few buffers at a time, so the free list is drained every now and then
+        if (held.size() < 3)
+        {
+          CSampleBuffer* buffer = pool->GetFreeBuffer();
+          if (buffer)
+          {
+            if (inUse[buffer->poolIndex].exchange(true))
+              duplicates++;
+            acquired++;
+            held.push_back(buffer);
+            continue;
+          }
+        }
+        if (held.empty())
+        {
+          std::this_thread::yield();
+          continue;
+        }
+        CSampleBuffer* buffer = held.back();
+        held.pop_back();
+        inUse[buffer->poolIndex] = false;
+        buffer->Return();
+      }
+      for (CSampleBuffer* buffer : held)
+      {
+        inUse[buffer->poolIndex] = false;
+        buffer->Return();
+      }
+    });
+  }
+  for (auto& thread : threads)
+    thread.join();
+
+  EXPECT_EQ(0, duplicates);
+  EXPECT_LT(0, acquired);
+  EXPECT_TRUE(pool->AllBuffersFree());
+  EXPECT_TRUE(CheckFreeList(*pool));
+}
+
+TEST(TestActiveAEBuffer, LastReturn)
+{
+  auto pool = CreatePool();
+
+  for (int n = 0; n < 1000; n++)
+  {
+    // a buffer shared by several holders, e.g. the engine and the visualizer
+    CSampleBuffer* buffer = pool->GetFreeBuffer();
+    ASSERT_NE(nullptr, buffer);
+    for (int i = 1; i < THREADS; i++)
+      buffer->Acquire();
+
+    std::atomic<bool> start{false};
+    std::vector<std::thread> threads;
+    for (int i = 0; i < THREADS; i++)
+    {
+      threads.emplace_back([buffer, &start]() {
+        while (!start)
+          std::this_thread::yield();
+        buffer->Return();
+      });
+    }
+    EXPECT_FALSE(pool->AllBuffersFree());
+    start = true;
+    for (auto& thread : threads)
+      thread.join();
+
+    // only the last Return() hands the buffer back to the pool
+    ASSERT_TRUE(pool->AllBuffersFree());
+  }
+  EXPECT_TRUE(CheckFreeList(*pool));
+
+  // holders returning one after the other
+  CSampleBuffer* buffer = pool->GetFreeBuffer();
+  ASSERT_NE(nullptr, buffer);
+  buffer->Acquire();
+  buffer->Acquire();
+  buffer->Return();
+  buffer->Return();
+  EXPECT_FALSE(pool->AllBuffersFree());
+  buffer->Return();
+  EXPECT_TRUE(pool->AllBuffersFree());
+  EXPECT_TRUE(CheckFreeList(*pool));
+}
@@ -266,6 +266,16 @@ public:
    */
   virtual bool GetCurrentSinkFormat(AEAudioFormat &SinkFormat) { return false; }
 
+  /*!
+   * \brief Get the output latency the engine achieved with the current sink
+   *
+   * This is the time from a sample leaving the stream buffers until it is played,
+   * i.e. engine water level, sink buffer and the latency reported by the device.
+   *
+   * \return Latency in seconds, 0 if not configured
+   */
+  virtual float GetOutputLatency() { return 0.0f; }
+
 private:
   friend class IAEStreamDeleter;
   friend class IAESoundDeleter;
@@ -17,6 +17,8 @@
 #include "cores/AudioEngine/Utils/AEELDParser.h"
 #include "cores/AudioEngine/Utils/AEUtil.h"
 #include "platform/Platform.h"
+#include "settings/AdvancedSettings.h"
+#include "settings/SettingsComponent.h"
 #include "utils/XTimeUtils.h"
 #include "utils/log.h"
 
@@ -737,8 +739,24 @@ bool CAESinkALSA::InitializeHW(const ALSAConfig &inconfig, ALSAConfig &outconfig
    will cause problems with menu sounds. Buffer will be increased
    after those are fixed.
   */
-  periodSize  = std::min(periodSize, (snd_pcm_uframes_t) sampleRate / 20);
-  bufferSize  = std::min(bufferSize, (snd_pcm_uframes_t) sampleRate / 5);
+  const std::shared_ptr<CAdvancedSettings> advancedSettings =
+      CServiceBroker::GetSettingsComponent()->GetAdvancedSettings();
+  const bool lowLatency = advancedSettings->m_audioLowLatency && !m_passthrough;
+  if (lowLatency)
+  {
+    /*
+     In low latency mode ask for periods of the configured time, the buffer
+     holds just enough of them to not underrun when the engine is scheduled late.
+    */
+    periodSize = std::min(periodSize, static_cast<snd_pcm_uframes_t>(
+                                          sampleRate * advancedSettings->m_audioLowLatencyPeriod / 1000));
+    bufferSize = std::min(bufferSize, periodSize * 4);
+  }
+  else
+  {
+    periodSize = std::min(periodSize, (snd_pcm_uframes_t)sampleRate / 20);
+    bufferSize = std::min(bufferSize, (snd_pcm_uframes_t)sampleRate / 5);
+  }
 
   /*
    According to upstream we should set buffer size first - so make sure it is always at least
@@ -816,9 +834,11 @@ bool CAESinkALSA::InitializeHW(const ALSAConfig &inconfig, ALSAConfig &outconfig
   /* if periodSize is too small Audio Engine might starve */
   m_fragmented = false;
   unsigned int fragments = 1;
-  if (periodSize < AE_MIN_PERIODSIZE)
+  const snd_pcm_uframes_t minPeriodSize =
+      lowLatency ? AE_MIN_PERIODSIZE_LOWLATENCY : AE_MIN_PERIODSIZE;
+  if (periodSize < minPeriodSize)
   {
-    fragments = std::ceil((double) AE_MIN_PERIODSIZE / periodSize);
+    fragments = std::ceil((double)minPeriodSize / periodSize);
     CLog::Log(LOGDEBUG, "Audio Driver reports too low periodSize {} - will use {} fragments",
               (int)periodSize, (int)fragments);
     m_fragmented = true;
@@ -832,6 +852,9 @@ bool CAESinkALSA::InitializeHW(const ALSAConfig &inconfig, ALSAConfig &outconfig
   m_timeout    = std::ceil((double)(bufferSize * 1000) / (double)sampleRate);
 
   CLog::Log(LOGDEBUG, "CAESinkALSA::InitializeHW - Setting timeout to {} ms", m_timeout);
+  if (lowLatency)
+    CLog::Log(LOGINFO, "CAESinkALSA::InitializeHW - low latency mode, period {} ms, buffer {} ms",
+              outconfig.periodSize * 1000 / sampleRate, bufferSize * 1000 / sampleRate);
 
   return true;
 }
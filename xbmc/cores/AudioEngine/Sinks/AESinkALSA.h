@@ -17,6 +17,7 @@
 #include <alsa/asoundlib.h>
 
 #define AE_MIN_PERIODSIZE 256
+#define AE_MIN_PERIODSIZE_LOWLATENCY 64
 
 class CAESinkALSA : public IAESink
 {
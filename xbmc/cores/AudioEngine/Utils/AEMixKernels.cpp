@@ -0,0 +1,384 @@
+/*
+ *  Copyright (C) 2023 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "AEMixKernels.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+#if defined(HAVE_SSE2) && defined(__SSE2__)
+#include <emmintrin.h>
+#define AE_KERNELS_SSE2
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define AE_KERNELS_AVX2
+#define AE_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define AE_KERNELS_NEON
+#endif
+
+namespace
+{
+
+struct KernelTable
+{
+  CAEMixKernels::Impl impl;
+  void (*mul)(float* data, float mul, uint32_t count);
+  bool (*mulAdd)(float* data, const float* add, float mul, uint32_t count);
+  void (*clamp)(float* data, uint32_t count);
+};
+
+//-----------------------------------------------------------------------------
+// Scalar reference implementation
+//-----------------------------------------------------------------------------
+
+namespace scalar
+{
+
+inline float SoftClamp(float x)
+{
+  // pade approximation of tanh with tweaked coefficients,
+  // see http://www.musicdsp.org/showone.php?id=238
+  if (x < -3.0f)
+    return -1.0f;
+  else if (x > 3.0f)
+    return 1.0f;
+  const float y = x * x;
+  return x * (27.0f + y) / (27.0f + 9.0f * y);
+}
+
+void Mul(float* data, float mul, uint32_t count)
+{
+  for (uint32_t i = 0; i < count; ++i)
+    data[i] *= mul;
+}
+
+bool MulAdd(float* data, const float* add, float mul, uint32_t count)
+{
+  bool needClamp = false;
+  for (uint32_t i = 0; i < count; ++i)
+  {
+    data[i] += add[i] * mul;
+    if (std::fabs(data[i]) > 1.0f)
+      needClamp = true;
+  }
+  return needClamp;
+}
+
+void Clamp(float* data, uint32_t count)
+{
+  for (uint32_t i = 0; i < count; ++i)
+    data[i] = SoftClamp(data[i]);
+}
+
+constexpr KernelTable table = {CAEMixKernels::Impl::SCALAR, Mul, MulAdd, Clamp};
+
+} // namespace scalar
+
+//-----------------------------------------------------------------------------
+// SSE2
+//-----------------------------------------------------------------------------
+
+#if defined(AE_KERNELS_SSE2)
+namespace sse2
+{
+
+void Mul(float* data, float mul, uint32_t count)
+{
+  const __m128 m = _mm_set1_ps(mul);
+  uint32_t i = 0;
+  for (; i + 4 <= count; i += 4)
+    _mm_storeu_ps(data + i, _mm_mul_ps(_mm_loadu_ps(data + i), m));
+  scalar::Mul(data + i, mul, count - i);
+}
+
+bool MulAdd(float* data, const float* add, float mul, uint32_t count)
+{
+  const __m128 m = _mm_set1_ps(mul);
+  const __m128 one = _mm_set1_ps(1.0f);
+  const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+  __m128 over = _mm_setzero_ps();
+  uint32_t i = 0;
+  for (; i + 4 <= count; i += 4)
+  {
+    const __m128 out =
+        _mm_add_ps(_mm_loadu_ps(data + i), _mm_mul_ps(_mm_loadu_ps(add + i), m));
+    _mm_storeu_ps(data + i, out);
+    over = _mm_or_ps(over, _mm_cmpgt_ps(_mm_and_ps(out, absMask), one));
+  }
+  const bool needClamp = scalar::MulAdd(data + i, add + i, mul, count - i);
+  return needClamp || _mm_movemask_ps(over) != 0;
+}
+
+void Clamp(float* data, uint32_t count)
+{
+  const __m128 c1 = _mm_set1_ps(27.0f);
+  const __m128 c2 = _mm_set1_ps(9.0f);
+  const __m128 lo = _mm_set1_ps(-3.0f);
+  const __m128 hi = _mm_set1_ps(3.0f);
+  uint32_t i = 0;
+  for (; i + 4 <= count; i += 4)
+  {
+    const __m128 x = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(data + i), lo), hi);
+    const __m128 y = _mm_mul_ps(x, x);
+    const __m128 num = _mm_mul_ps(x, _mm_add_ps(c1, y));
+    const __m128 den = _mm_add_ps(c1, _mm_mul_ps(c2, y));
+    _mm_storeu_ps(data + i, _mm_div_ps(num, den));
+  }
+  scalar::Clamp(data + i, count - i);
+}
+
+constexpr KernelTable table = {CAEMixKernels::Impl::SSE2, Mul, MulAdd, Clamp};
+
+} // namespace sse2
+#endif
+
+//-----------------------------------------------------------------------------
+// AVX2, compiled for the avx2 target and only selected if the cpu supports it
+//-----------------------------------------------------------------------------
+
+#if defined(AE_KERNELS_AVX2)
+namespace avx2
+{
+
+AE_TARGET_AVX2 void Mul(float* data, float mul, uint32_t count)
+{
+  const __m256 m = _mm256_set1_ps(mul);
+  uint32_t i = 0;
+  for (; i + 8 <= count; i += 8)
+    _mm256_storeu_ps(data + i, _mm256_mul_ps(_mm256_loadu_ps(data + i), m));
+  sse2::Mul(data + i, mul, count - i);
+}
+
+AE_TARGET_AVX2 bool MulAdd(float* data, const float* add, float mul, uint32_t count)
+{
+  const __m256 m = _mm256_set1_ps(mul);
+  const __m256 one = _mm256_set1_ps(1.0f);
+  const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+  __m256 over = _mm256_setzero_ps();
+  uint32_t i = 0;
+  for (; i + 8 <= count; i += 8)
+  {
+    const __m256 out =
+        _mm256_add_ps(_mm256_loadu_ps(data + i), _mm256_mul_ps(_mm256_loadu_ps(add + i), m));
+    _mm256_storeu_ps(data + i, out);
+    over = _mm256_or_ps(over, _mm256_cmp_ps(_mm256_and_ps(out, absMask), one, _CMP_GT_OQ));
+  }
+  const bool needClamp = sse2::MulAdd(data + i, add + i, mul, count - i);
+  return needClamp || _mm256_movemask_ps(over) != 0;
+}
+
+AE_TARGET_AVX2 void Clamp(float* data, uint32_t count)
+{
+  const __m256 c1 = _mm256_set1_ps(27.0f);
+  const __m256 c2 = _mm256_set1_ps(9.0f);
+  const __m256 lo = _mm256_set1_ps(-3.0f);
+  const __m256 hi = _mm256_set1_ps(3.0f);
+  uint32_t i = 0;
+  for (; i + 8 <= count; i += 8)
+  {
+    const __m256 x = _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(data + i), lo), hi);
+    const __m256 y = _mm256_mul_ps(x, x);
+    const __m256 num = _mm256_mul_ps(x, _mm256_add_ps(c1, y));
+    const __m256 den = _mm256_add_ps(c1, _mm256_mul_ps(c2, y));
+    _mm256_storeu_ps(data + i, _mm256_div_ps(num, den));
+  }
+  sse2::Clamp(data + i, count - i);
+}
+
+constexpr KernelTable table = {CAEMixKernels::Impl::AVX2, Mul, MulAdd, Clamp};
+
+} // namespace avx2
+#endif
+
+//-----------------------------------------------------------------------------
+// NEON
+//-----------------------------------------------------------------------------
+
+#if defined(AE_KERNELS_NEON)
+namespace neon
+{
+
+inline bool AnyLaneSet(uint32x4_t v)
+{
+#if defined(__aarch64__) || defined(_M_ARM64)
+  return vmaxvq_u32(v) != 0;
+#else
+  const uint32x2_t r = vorr_u32(vget_low_u32(v), vget_high_u32(v));
+  return (vget_lane_u32(r, 0) | vget_lane_u32(r, 1)) != 0;
+#endif
+}
+
+inline float32x4_t Div(float32x4_t num, float32x4_t den)
+{
+#if defined(__aarch64__) || defined(_M_ARM64)
+  return vdivq_f32(num, den);
+#else
+  // reciprocal estimate refined by two newton-raphson steps
+  float32x4_t r = vrecpeq_f32(den);
+  r = vmulq_f32(vrecpsq_f32(den, r), r);
+  r = vmulq_f32(vrecpsq_f32(den, r), r);
+  return vmulq_f32(num, r);
+#endif
+}
+
+void Mul(float* data, float mul, uint32_t count)
+{
+  uint32_t i = 0;
+  for (; i + 4 <= count; i += 4)
+    vst1q_f32(data + i, vmulq_n_f32(vld1q_f32(data + i), mul));
+  scalar::Mul(data + i, mul, count - i);
+}
+
+bool MulAdd(float* data, const float* add, float mul, uint32_t count)
+{
+  const float32x4_t one = vdupq_n_f32(1.0f);
+  uint32x4_t over = vdupq_n_u32(0);
+  uint32_t i = 0;
+  for (; i + 4 <= count; i += 4)
+  {
+    const float32x4_t out = vaddq_f32(vld1q_f32(data + i), vmulq_n_f32(vld1q_f32(add + i), mul));
+    vst1q_f32(data + i, out);
+    over = vorrq_u32(over, vcgtq_f32(vabsq_f32(out), one));
+  }
+  const bool needClamp = scalar::MulAdd(data + i, add + i, mul, count - i);
+  return needClamp || AnyLaneSet(over);
+}
+
+void Clamp(float* data, uint32_t count)
+{
+  const float32x4_t c1 = vdupq_n_f32(27.0f);
+  const float32x4_t lo = vdupq_n_f32(-3.0f);
+  const float32x4_t hi = vdupq_n_f32(3.0f);
+  uint32_t i = 0;
+  for (; i + 4 <= count; i += 4)
+  {
+    const float32x4_t x = vminq_f32(vmaxq_f32(vld1q_f32(data + i), lo), hi);
+    const float32x4_t y = vmulq_f32(x, x);
+    const float32x4_t num = vmulq_f32(x, vaddq_f32(c1, y));
+    const float32x4_t den = vaddq_f32(c1, vmulq_n_f32(y, 9.0f));
+    vst1q_f32(data + i, Div(num, den));
+  }
+  scalar::Clamp(data + i, count - i);
+}
+
+constexpr KernelTable table = {CAEMixKernels::Impl::NEON, Mul, MulAdd, Clamp};
+
+} // namespace neon
+#endif
+
+//-----------------------------------------------------------------------------
+// Dispatch
+//-----------------------------------------------------------------------------
+
+const KernelTable* GetTable(CAEMixKernels::Impl impl)
+{
+  switch (impl)
+  {
+    case CAEMixKernels::Impl::SCALAR:
+      return &scalar::table;
+#if defined(AE_KERNELS_SSE2)
+    case CAEMixKernels::Impl::SSE2:
+      return &sse2::table;
+#endif
+#if defined(AE_KERNELS_AVX2)
+    case CAEMixKernels::Impl::AVX2:
+      if (__builtin_cpu_supports("avx2"))
+        return &avx2::table;
+      return nullptr;
+#endif
+#if defined(AE_KERNELS_NEON)
+    case CAEMixKernels::Impl::NEON:
+      return &neon::table;
+#endif
+    default:
+      return nullptr;
+  }
+}
+
+const KernelTable* GetBestTable()
+{
+  for (auto impl : {CAEMixKernels::Impl::AVX2, CAEMixKernels::Impl::NEON,
+                    CAEMixKernels::Impl::SSE2})
+  {
+    const KernelTable* table = GetTable(impl);
+    if (table)
+      return table;
+  }
+  return &scalar::table;
+}
+
+std::atomic<const KernelTable*> s_table{nullptr};
+
+inline const KernelTable& Kernels()
+{
+  const KernelTable* table = s_table.load(std::memory_order_acquire);
+  if (!table)
+  {
+    table = GetBestTable();
+    s_table.store(table, std::memory_order_release);
+  }
+  return *table;
+}
+
+} // unnamed namespace
+
+CAEMixKernels::Impl CAEMixKernels::GetImpl()
+{
+  return Kernels().impl;
+}
+
+bool CAEMixKernels::SetImpl(Impl impl)
+{
+  const KernelTable* table = GetTable(impl);
+  if (!table)
+    return false;
+
+  s_table.store(table, std::memory_order_release);
+  return true;
+}
+
+bool CAEMixKernels::IsSupported(Impl impl)
+{
+  return GetTable(impl) != nullptr;
+}
+
+const char* CAEMixKernels::GetImplName(Impl impl)
+{
+  switch (impl)
+  {
+    case Impl::SSE2:
+      return "SSE2";
+    case Impl::AVX2:
+      return "AVX2";
+    case Impl::NEON:
+      return "NEON";
+    default:
+      return "scalar";
+  }
+}
+
+void CAEMixKernels::MulArray(float* data, float mul, uint32_t count)
+{
+  Kernels().mul(data, mul, count);
+}
+
+bool CAEMixKernels::MulAddArray(float* data, const float* add, float mul, uint32_t count)
+{
+  return Kernels().mulAdd(data, add, mul, count);
+}
+
+void CAEMixKernels::ClampArray(float* data, uint32_t count)
+{
+  Kernels().clamp(data, count);
+}
@@ -0,0 +1,56 @@
+/*
+ *  Copyright (C) 2023 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+/*!
+ * \brief Vectorized sample processing kernels used by ActiveAE.
+ *
+ * Every kernel has a scalar reference implementation and SSE2, AVX2 and NEON
+ * variants where the target supports them. The best variant is chosen at
+ * runtime on first use. None of the kernels require aligned buffers.
+ */
+class CAEMixKernels
+{
+public:
+  enum class Impl
+  {
+    SCALAR,
+    SSE2,
+    AVX2,
+    NEON
+  };
+
+  /*!
+   * \brief Get the implementation currently used by the kernels
+   */
+  static Impl GetImpl();
+
+  /*!
+   * \brief Force a specific implementation, used by tests and benchmarks
+   * \return false if the implementation is not supported on this cpu
+   */
+  static bool SetImpl(Impl impl);
+
+  static bool IsSupported(Impl impl);
+  static const char* GetImplName(Impl impl);
+
+  /*! \brief data[i] *= mul */
+  static void MulArray(float* data, float mul, uint32_t count);
+
+  /*!
+   * \brief data[i] += add[i] * mul
+   * \return true if any resulting sample exceeds the range -1..1 and needs clamping
+   */
+  static bool MulAddArray(float* data, const float* add, float mul, uint32_t count);
+
+  /*! \brief Soft clamp all samples to the range -1..1 */
+  static void ClampArray(float* data, uint32_t count);
+};
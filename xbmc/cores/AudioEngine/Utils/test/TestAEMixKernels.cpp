@@ -0,0 +1,150 @@
+/*
+ *  Copyright (C) 2023 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/AudioEngine/Utils/AEMixKernels.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+using Impl = CAEMixKernels::Impl;
+
+// odd sizes to exercise the scalar tails of the vector loops
+constexpr uint32_t COUNTS[] = {0, 1, 3, 7, 8, 17, 64, 1021};
+
+std::vector<float> RandomSamples(uint32_t count, float range, unsigned int seed)
+{
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<float> dist(-range, range);
+  std::vector<float> samples(count);
+  for (auto& s : samples)
+    s = dist(gen);
+  return samples;
+}
+
+class TestAEMixKernels : public ::testing::TestWithParam<Impl>
+{
+protected:
+  void SetUp() override
+  {
+    m_previous = CAEMixKernels::GetImpl();
+    if (!CAEMixKernels::SetImpl(GetParam()))
+      GTEST_SKIP() << CAEMixKernels::GetImplName(GetParam()) << " not supported";
+  }
+
+  void TearDown() override { CAEMixKernels::SetImpl(m_previous); }
+
+  // run f with the scalar reference implementation
+  template<typename F>
+  void Reference(F f)
+  {
+    CAEMixKernels::SetImpl(Impl::SCALAR);
+    f();
+    CAEMixKernels::SetImpl(GetParam());
+  }
+
+  Impl m_previous = Impl::SCALAR;
+};
+
+} // namespace
+
+TEST_P(TestAEMixKernels, MulArray)
+{
+  for (uint32_t count : COUNTS)
+  {
+    std::vector<float> data = RandomSamples(count, 1.0f, count);
+    std::vector<float> ref = data;
+    Reference([&] { CAEMixKernels::MulArray(ref.data(), 0.7f, count); });
+    CAEMixKernels::MulArray(data.data(), 0.7f, count);
+    for (uint32_t i = 0; i < count; ++i)
+      EXPECT_FLOAT_EQ(ref[i], data[i]);
+  }
+}
+
+TEST_P(TestAEMixKernels, MulAddArray)
+{
+  for (uint32_t count : COUNTS)
+  {
+    std::vector<float> data = RandomSamples(count, 0.5f, count);
+    const std::vector<float> add = RandomSamples(count, 0.5f, count + 1);
+    std::vector<float> ref = data;
+    bool refClamp = false;
+    Reference([&] { refClamp = CAEMixKernels::MulAddArray(ref.data(), add.data(), 0.9f, count); });
+    const bool clamp = CAEMixKernels::MulAddArray(data.data(), add.data(), 0.9f, count);
+    EXPECT_FALSE(refClamp);
+    EXPECT_EQ(refClamp, clamp);
+    for (uint32_t i = 0; i < count; ++i)
+      EXPECT_FLOAT_EQ(ref[i], data[i]);
+  }
+
+  // a single overshooting sample anywhere has to be reported
+  for (uint32_t pos : {0u, 5u, 12u, 16u})
+  {
+    std::vector<float> data(17, 0.5f);
+    std::vector<float> add(17, 0.1f);
+    add[pos] = -2.0f;
+    EXPECT_TRUE(CAEMixKernels::MulAddArray(data.data(), add.data(), 1.0f, 17));
+  }
+}
+
+TEST_P(TestAEMixKernels, ClampArray)
+{
+  for (uint32_t count : COUNTS)
+  {
+    std::vector<float> data = RandomSamples(count, 5.0f, count);
+    std::vector<float> ref = data;
+    Reference([&] { CAEMixKernels::ClampArray(ref.data(), count); });
+    CAEMixKernels::ClampArray(data.data(), count);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+      EXPECT_NEAR(ref[i], data[i], 1e-6f);
+      EXPECT_LE(std::abs(data[i]), 1.0f);
+    }
+  }
+}
+
+// Micro benchmark, run with --gtest_also_run_disabled_tests
+TEST_P(TestAEMixKernels, DISABLED_Benchmark)
+{
+  // one minute of 7.1 audio in 20ms periods
+  constexpr uint32_t frames = 960;
+  constexpr uint32_t channels = 8;
+  constexpr int periods = 50 * 60;
+  std::vector<float> data = RandomSamples(frames * channels, 0.5f, 1);
+  const std::vector<float> add = RandomSamples(frames * channels, 0.5f, 2);
+
+  auto run = [&](const char* name, auto f) {
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < periods; ++i)
+      f();
+    const auto end = std::chrono::steady_clock::now();
+    std::cout << CAEMixKernels::GetImplName(GetParam()) << " " << name << ": "
+              << std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() /
+                     periods
+              << " us per period\n";
+  };
+
+  run("MulAddArray", [&] { CAEMixKernels::MulAddArray(data.data(), add.data(), 0.5f, frames * channels); });
+  run("MulArray", [&] { CAEMixKernels::MulArray(data.data(), 1.0f, frames * channels); });
+  run("ClampArray", [&] { CAEMixKernels::ClampArray(data.data(), frames * channels); });
+}
+
+INSTANTIATE_TEST_SUITE_P(AEMixKernels,
+                         TestAEMixKernels,
+                         ::testing::Values(Impl::SCALAR, Impl::SSE2, Impl::AVX2, Impl::NEON),
+                         [](const ::testing::TestParamInfo<Impl>& info) {
+                           return std::string(CAEMixKernels::GetImplName(info.param));
+                         });
@@ -409,6 +409,21 @@ bool CDVDVideoCodecFFmpeg::Open(CDVDStreamInfo &hints, CDVDCodecOptions &options
     m_pCodecContext->skip_loop_filter = static_cast<AVDiscard>(iSkipLoopFilter);
   }
 
+  // thumbnail extraction only needs a single keyframe at roughly the thumbnail size
+  if (hints.codecOptions & CODEC_THUMBNAIL)
+  {
+    m_pCodecContext->skip_frame = AVDISCARD_NONKEY;
+    m_pCodecContext->skip_loop_filter = AVDISCARD_ALL;
+
+    const unsigned int thumbWidth =
+        CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_imageRes;
+    int lowres = 0;
+    while (lowres < pCodec->max_lowres && thumbWidth > 0 &&
+           static_cast<unsigned int>(hints.width >> (lowres + 1)) >= thumbWidth)
+      lowres++;
+    m_pCodecContext->lowres = lowres;
+  }
+
   // set any special options
   for(std::vector<CDVDCodecOption>::iterator it = options.m_keys.begin(); it != options.m_keys.end(); ++it)
   {
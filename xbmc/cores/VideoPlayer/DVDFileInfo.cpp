@@ -85,27 +85,164 @@ int DegreeToOrientation(int degrees)
   }
 }
 
+namespace
+{
+/*!
+ \brief Seek to the keyframe nearest to pos, decode it and store the scaled image in the texture
+        cache location referenced by details.file.
+ */
+bool DecodeThumbAt(CDVDDemux* pDemuxer,
+                   CDVDVideoCodec* pVideoCodec,
+                   const CDVDStreamInfo& hint,
+                   int nVideoStream,
+                   int64_t pos,
+                   CTextureDetails& details,
+                   const std::string& redactPath,
+                   int& packetsTried)
+{
+  int nTotalLen = pDemuxer->GetStreamLength();
+  int64_t nSeekTo = (pos == -1) ? nTotalLen / 3 : pos;
+
+  CLog::Log(LOGDEBUG, "{} - seeking to pos {}ms (total: {}ms) in {}", __FUNCTION__, nSeekTo,
+            nTotalLen, redactPath);
+
+  if (!pDemuxer->SeekTime(static_cast<double>(nSeekTo), true))
+    return false;
+
+  // drop anything left over from a previous position
+  pVideoCodec->Reset();
+
+  CDVDVideoCodec::VCReturn iDecoderState = CDVDVideoCodec::VC_NONE;
+  VideoPicture picture = {};
+
+  // num streams * 160 frames, should get a valid frame, if not abort.
+  int abort_index = pDemuxer->GetNrOfStreams() * 160;
+  do
+  {
+    DemuxPacket* pPacket = pDemuxer->Read();
+    packetsTried++;
+
+    if (!pPacket)
+      break;
+
+    if (pPacket->iStreamId != nVideoStream)
+    {
+      CDVDDemuxUtils::FreeDemuxPacket(pPacket);
+      continue;
+    }
+
+    pVideoCodec->AddData(*pPacket);
+    CDVDDemuxUtils::FreeDemuxPacket(pPacket);
+
+    iDecoderState = CDVDVideoCodec::VC_NONE;
+    while (iDecoderState == CDVDVideoCodec::VC_NONE)
+    {
+      iDecoderState = pVideoCodec->GetPicture(&picture);
+    }
+
+    if (iDecoderState == CDVDVideoCodec::VC_PICTURE)
+    {
+      if (!(picture.iFlags & DVP_FLAG_DROPPED))
+        break;
+    }
+
+  } while (abort_index--);
+
+  bool bOk = false;
+  if (iDecoderState == CDVDVideoCodec::VC_PICTURE && !(picture.iFlags & DVP_FLAG_DROPPED))
+  {
+    unsigned int nWidth = std::min(picture.iDisplayWidth, CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_imageRes);
+    double aspect = (double)picture.iDisplayWidth / (double)picture.iDisplayHeight;
+    if(hint.forced_aspect && hint.aspect != 0)
+      aspect = hint.aspect;
+    unsigned int nHeight = (unsigned int)((double)nWidth / aspect);
+
+    // We pass the buffers to sws_scale uses 16 aligned widths when using intrinsics
+    int sizeNeeded = FFALIGN(nWidth, 16) * nHeight * 4;
+    uint8_t *pOutBuf = static_cast<uint8_t*>(av_malloc(sizeNeeded));
+    struct SwsContext *context = sws_getContext(picture.iWidth, picture.iHeight,
+          AV_PIX_FMT_YUV420P, nWidth, nHeight, AV_PIX_FMT_BGRA, SWS_FAST_BILINEAR, NULL, NULL, NULL);
+
+    if (context)
+    {
+      uint8_t *planes[YuvImage::MAX_PLANES];
+      int stride[YuvImage::MAX_PLANES];
+      picture.videoBuffer->GetPlanes(planes);
+      picture.videoBuffer->GetStrides(stride);
+      uint8_t *src[4]= { planes[0], planes[1], planes[2], 0 };
+      int srcStride[] = { stride[0], stride[1], stride[2], 0 };
+      uint8_t *dst[] = { pOutBuf, 0, 0, 0 };
+      int dstStride[] = { (int)nWidth*4, 0, 0, 0 };
+      int orientation = DegreeToOrientation(hint.orientation);
+      sws_scale(context, src, srcStride, 0, picture.iHeight, dst, dstStride);
+      sws_freeContext(context);
+
+      details.width = nWidth;
+      details.height = nHeight;
+      CPicture::CacheTexture(pOutBuf, nWidth, nHeight, nWidth * 4, orientation, nWidth, nHeight, CTextureCache::GetCachedPath(details.file));
+      bOk = true;
+    }
+    av_free(pOutBuf);
+  }
+  else
+  {
+    CLog::Log(LOGDEBUG, "{} - decode failed in {} after {} packets.", __FUNCTION__, redactPath,
+              packetsTried);
+  }
+
+  return bOk;
+}
+} // unnamed namespace
+
 bool CDVDFileInfo::ExtractThumb(const CFileItem& fileItem,
                                 CTextureDetails &details,
                                 CStreamDetails *pStreamDetails,
                                 int64_t pos)
 {
+  std::vector<CTextureDetails> thumbs{details};
+  const std::vector<bool> result = ExtractThumbs(fileItem, {pos}, thumbs, pStreamDetails);
+  details = thumbs.front();
+  return result.front();
+}
+
+std::vector<bool> CDVDFileInfo::ExtractThumbs(const CFileItem& fileItem,
+                                              const std::vector<int64_t>& positions,
+                                              std::vector<CTextureDetails>& details,
+                                              CStreamDetails* pStreamDetails)
+{
+  std::vector<bool> result(positions.size(), false);
+  if (positions.size() != details.size())
+    return result;
+
   const std::string redactPath = CURL::GetRedacted(fileItem.GetPath());
   auto start = std::chrono::steady_clock::now();
 
+  // mark every thumb we fail to extract, so it isn't attempted again
+  auto markFailed = [&]() {
+    for (size_t i = 0; i < result.size(); ++i)
+    {
+      if (result[i])
+        continue;
+
+      XFILE::CFile file;
+      if (file.OpenForWrite(CTextureCache::GetCachedPath(details[i].file)))
+        file.Close();
+    }
+  };
+
   CFileItem item(fileItem);
   item.SetMimeTypeForInternetFile();
   auto pInputStream = CDVDFactoryInputStream::CreateInputStream(NULL, item);
   if (!pInputStream)
   {
     CLog::Log(LOGERROR, "InputStream: Error creating stream for {}", redactPath);
-    return false;
+    return result;
   }
 
   if (!pInputStream->Open())
   {
     CLog::Log(LOGERROR, "InputStream: Error opening, {}", redactPath);
-    return false;
+    return result;
   }
 
   CDVDDemux *pDemuxer = NULL;
@@ -116,7 +253,7 @@ bool CDVDFileInfo::ExtractThumb(const CFileItem& fileItem,
     if(!pDemuxer)
     {
       CLog::Log(LOGERROR, "{} - Error creating demuxer", __FUNCTION__);
-      return false;
+      return result;
     }
   }
   catch(...)
@@ -125,7 +262,7 @@ bool CDVDFileInfo::ExtractThumb(const CFileItem& fileItem,
     if (pDemuxer)
       delete pDemuxer;
 
-    return false;
+    return result;
   }
 
   if (pStreamDetails)
@@ -180,7 +317,6 @@ bool CDVDFileInfo::ExtractThumb(const CFileItem& fileItem,
     }
   }
 
-  bool bOk = false;
   int packetsTried = 0;
 
   if (nVideoStream != -1)
@@ -191,119 +327,32 @@ bool CDVDFileInfo::ExtractThumb(const CFileItem& fileItem,
     pProcessInfo->SetPixFormats(pixFmts);
 
     CDVDStreamInfo hint(*pDemuxer->GetStream(demuxerId, nVideoStream), true);
-    hint.codecOptions = CODEC_FORCE_SOFTWARE;
+    // only keyframes are needed, the decoder may cut corners to get them out quickly
+    hint.codecOptions = CODEC_FORCE_SOFTWARE | CODEC_THUMBNAIL;
 
     std::unique_ptr<CDVDVideoCodec> pVideoCodec =
         CDVDFactoryCodec::CreateVideoCodec(hint, *pProcessInfo);
 
     if (pVideoCodec)
     {
-      int nTotalLen = pDemuxer->GetStreamLength();
-      int64_t nSeekTo = (pos == -1) ? nTotalLen / 3 : pos;
-
-      CLog::Log(LOGDEBUG, "{} - seeking to pos {}ms (total: {}ms) in {}", __FUNCTION__, nSeekTo,
-                nTotalLen, redactPath);
-
-      if (pDemuxer->SeekTime(static_cast<double>(nSeekTo), true))
-      {
-        CDVDVideoCodec::VCReturn iDecoderState = CDVDVideoCodec::VC_NONE;
-        VideoPicture picture = {};
-
-        // num streams * 160 frames, should get a valid frame, if not abort.
-        int abort_index = pDemuxer->GetNrOfStreams() * 160;
-        do
-        {
-          DemuxPacket* pPacket = pDemuxer->Read();
-          packetsTried++;
-
-          if (!pPacket)
-            break;
-
-          if (pPacket->iStreamId != nVideoStream)
-          {
-            CDVDDemuxUtils::FreeDemuxPacket(pPacket);
-            continue;
-          }
-
-          pVideoCodec->AddData(*pPacket);
-          CDVDDemuxUtils::FreeDemuxPacket(pPacket);
-
-          iDecoderState = CDVDVideoCodec::VC_NONE;
-          while (iDecoderState == CDVDVideoCodec::VC_NONE)
-          {
-            iDecoderState = pVideoCodec->GetPicture(&picture);
-          }
-
-          if (iDecoderState == CDVDVideoCodec::VC_PICTURE)
-          {
-            if(!(picture.iFlags & DVP_FLAG_DROPPED))
-              break;
-          }
-
-        } while (abort_index--);
-
-        if (iDecoderState == CDVDVideoCodec::VC_PICTURE && !(picture.iFlags & DVP_FLAG_DROPPED))
-        {
-          {
-            unsigned int nWidth = std::min(picture.iDisplayWidth, CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_imageRes);
-            double aspect = (double)picture.iDisplayWidth / (double)picture.iDisplayHeight;
-            if(hint.forced_aspect && hint.aspect != 0)
-              aspect = hint.aspect;
-            unsigned int nHeight = (unsigned int)((double)nWidth / aspect);
-
-            // We pass the buffers to sws_scale uses 16 aligned widths when using intrinsics
-            int sizeNeeded = FFALIGN(nWidth, 16) * nHeight * 4;
-            uint8_t *pOutBuf = static_cast<uint8_t*>(av_malloc(sizeNeeded));
-            struct SwsContext *context = sws_getContext(picture.iWidth, picture.iHeight,
-                  AV_PIX_FMT_YUV420P, nWidth, nHeight, AV_PIX_FMT_BGRA, SWS_FAST_BILINEAR, NULL, NULL, NULL);
-
-            if (context)
-            {
-              uint8_t *planes[YuvImage::MAX_PLANES];
-              int stride[YuvImage::MAX_PLANES];
-              picture.videoBuffer->GetPlanes(planes);
-              picture.videoBuffer->GetStrides(stride);
-              uint8_t *src[4]= { planes[0], planes[1], planes[2], 0 };
-              int srcStride[] = { stride[0], stride[1], stride[2], 0 };
-              uint8_t *dst[] = { pOutBuf, 0, 0, 0 };
-              int dstStride[] = { (int)nWidth*4, 0, 0, 0 };
-              int orientation = DegreeToOrientation(hint.orientation);
-              sws_scale(context, src, srcStride, 0, picture.iHeight, dst, dstStride);
-              sws_freeContext(context);
-
-              details.width = nWidth;
-              details.height = nHeight;
-              CPicture::CacheTexture(pOutBuf, nWidth, nHeight, nWidth * 4, orientation, nWidth, nHeight, CTextureCache::GetCachedPath(details.file));
-              bOk = true;
-            }
-            av_free(pOutBuf);
-          }
-        }
-        else
-        {
-          CLog::Log(LOGDEBUG, "{} - decode failed in {} after {} packets.", __FUNCTION__,
-                    redactPath, packetsTried);
-        }
-      }
+      for (size_t i = 0; i < positions.size(); ++i)
+        result[i] = DecodeThumbAt(pDemuxer, pVideoCodec.get(), hint, nVideoStream, positions[i],
+                                  details[i], redactPath, packetsTried);
     }
   }
 
   if (pDemuxer)
     delete pDemuxer;
 
-  if(!bOk)
-  {
-    XFILE::CFile file;
-    if(file.OpenForWrite(CTextureCache::GetCachedPath(details.file)))
-      file.Close();
-  }
+  markFailed();
 
   auto end = std::chrono::steady_clock::now();
   auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
-  CLog::Log(LOGDEBUG, "{} - measured {} ms to extract thumb from file <{}> in {} packets. ",
-            __FUNCTION__, duration.count(), redactPath, packetsTried);
+  CLog::Log(LOGDEBUG,
+            "{} - measured {} ms to extract {} thumb(s) from file <{}> in {} packets. ",
+            __FUNCTION__, duration.count(), positions.size(), redactPath, packetsTried);
 
-  return bOk;
+  return result;
 }
 
 /**
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
@@ -28,6 +29,17 @@ public:
                            CStreamDetails *pStreamDetails,
                            int64_t pos);
 
+  /** \brief Extract thumbnail images at several positions with a single open of the media.
+  *   Only the keyframe nearest to each position is decoded.
+  *   \param[in] positions Positions in ms, -1 for a third of the stream length.
+  *   \param[in,out] details One entry per position, file must be set to the cache target.
+  *   \return One entry per position, true if the thumb was extracted.
+  */
+  static std::vector<bool> ExtractThumbs(const CFileItem& fileItem,
+                                         const std::vector<int64_t>& positions,
+                                         std::vector<CTextureDetails>& details,
+                                         CStreamDetails* pStreamDetails = nullptr);
+
   // Probe the files streams and store the info in the VideoInfoTag
   static bool GetFileStreamDetails(CFileItem *pItem);
   static bool DemuxerToStreamDetails(const std::shared_ptr<CDVDInputStream>& pInputStream,
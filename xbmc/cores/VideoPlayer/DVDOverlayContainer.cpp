@@ -10,9 +10,15 @@
 
 #include "DVDInputStreams/DVDInputStreamNavigator.h"
 
+#include <algorithm>
+#include <iterator>
+#include <limits>
 #include <mutex>
 
-CDVDOverlayContainer::CDVDOverlayContainer() = default;
+CDVDOverlayContainer::CDVDOverlayContainer()
+  : m_nextExpiry(std::numeric_limits<double>::infinity())
+{
+}
 
 CDVDOverlayContainer::~CDVDOverlayContainer()
 {
@@ -25,32 +31,91 @@ void CDVDOverlayContainer::ProcessAndAddOverlayIfValid(CDVDOverlay* pOverlay)
 
   std::unique_lock<CCriticalSection> lock(*this);
 
+  // overlays are kept sorted by start time, they usually
+  // arrive in order so this is the end in most cases
+  const VecOverlaysIter itInsert = StartedEnd(pOverlay->iPTSStartTime);
+
   // markup any non ending overlays, to finish
   // when this new one starts, there can be
   // multiple overlays queued at same start
   // point so only stop them when we get a
   // new startpoint
-  for(int i = m_overlays.size();i>0;)
+  for (VecOverlaysIter it = itInsert; it != m_overlays.begin();)
   {
-    i--;
-    if(m_overlays[i]->iPTSStopTime)
+    CDVDOverlay* pPrevious = *--it;
+    if (pPrevious->iPTSStopTime)
     {
-      if(!m_overlays[i]->replace)
+      if (!pPrevious->replace)
         break;
-      if(m_overlays[i]->iPTSStopTime <= pOverlay->iPTSStartTime)
+      if (pPrevious->iPTSStopTime <= pOverlay->iPTSStartTime)
         break;
     }
 
-    if (m_overlays[i]->iPTSStartTime != pOverlay->iPTSStartTime)
-      m_overlays[i]->iPTSStopTime = pOverlay->iPTSStartTime;
+    if (pPrevious->iPTSStartTime != pOverlay->iPTSStartTime)
+    {
+      pPrevious->iPTSStopTime = pOverlay->iPTSStartTime;
+      if (!pPrevious->bForced && pPrevious->iPTSStopTime != 0)
+        m_nextExpiry = std::min(m_nextExpiry, pPrevious->iPTSStopTime);
+    }
+  }
+
+  if (pOverlay->bForced)
+    m_forcedCount++;
+  else if (pOverlay->iPTSStopTime != 0)
+    m_nextExpiry = std::min(m_nextExpiry, pOverlay->iPTSStopTime);
+
+  m_overlays.insert(itInsert, pOverlay);
+}
+
+void CDVDOverlayContainer::GetActiveOverlays(double pts,
+                                             double subtitlePts,
+                                             bool includeSubtitles,
+                                             VecOverlays& overlays)
+{
+  std::unique_lock<CCriticalSection> lock(*this);
+
+  // everything past this point starts in the future
+  const VecOverlaysIter itEnd = StartedEnd(std::max(pts, subtitlePts));
+
+  for (VecOverlaysIter it = m_overlays.begin(); it != itEnd; ++it)
+  {
+    CDVDOverlay* pOverlay = *it;
+    if (!pOverlay->bForced && !includeSubtitles)
+      continue;
+
+    const double pts2 = pOverlay->bForced ? pts : subtitlePts;
+    if (pOverlay->iPTSStartTime <= pts2 &&
+        (pOverlay->iPTSStopTime > pts2 || pOverlay->iPTSStopTime == 0LL))
+    {
+      if (pOverlay->IsOverlayType(DVDOVERLAY_TYPE_GROUP))
+      {
+        const VecOverlays& group = static_cast<CDVDOverlayGroup*>(pOverlay)->m_overlays;
+        overlays.insert(overlays.end(), group.begin(), group.end());
+      }
+      else
+        overlays.push_back(pOverlay);
+    }
   }
+}
 
-  m_overlays.emplace_back(pOverlay);
+VecOverlaysIter CDVDOverlayContainer::StartedEnd(double pts)
+{
+  return std::upper_bound(m_overlays.begin(), m_overlays.end(), pts,
+                          [](double pts, const CDVDOverlay* pOverlay)
+                          { return pts < pOverlay->iPTSStartTime; });
 }
 
-VecOverlays* CDVDOverlayContainer::GetOverlays()
+void CDVDOverlayContainer::RebuildIndex()
 {
-  return &m_overlays;
+  m_nextExpiry = std::numeric_limits<double>::infinity();
+  m_forcedCount = 0;
+  for (const CDVDOverlay* pOverlay : m_overlays)
+  {
+    if (pOverlay->bForced)
+      m_forcedCount++;
+    else if (pOverlay->iPTSStopTime != 0)
+      m_nextExpiry = std::min(m_nextExpiry, pOverlay->iPTSStopTime);
+  }
 }
 
 VecOverlaysIter CDVDOverlayContainer::Remove(VecOverlaysIter itOverlay)
@@ -61,6 +126,8 @@ VecOverlaysIter CDVDOverlayContainer::Remove(VecOverlaysIter itOverlay)
   {
     std::unique_lock<CCriticalSection> lock(*this);
     itNext = m_overlays.erase(itOverlay);
+    if (pOverlay->bForced)
+      m_forcedCount--;
   }
 
   pOverlay->Release();
@@ -72,42 +139,60 @@ void CDVDOverlayContainer::CleanUp(double pts)
 {
   std::unique_lock<CCriticalSection> lock(*this);
 
-  VecOverlaysIter it = m_overlays.begin();
-  while (it != m_overlays.end())
+  // called for every frame, only look at the overlays
+  // when one of them actually has to go
+  if (pts >= m_nextExpiry)
   {
-    CDVDOverlay* pOverlay = *it;
+    m_nextExpiry = std::numeric_limits<double>::infinity();
 
-    // never delete forced overlays, they are used in menu's
-    // clear takes care of removing them
-    // also if stoptime = 0, it means the next subtitles will use its starttime as the stoptime
-    // which means we cannot delete overlays with stoptime 0
-    if (!pOverlay->bForced && pOverlay->iPTSStopTime <= pts && pOverlay->iPTSStopTime != 0)
+    // only overlays that already started can expire
+    VecOverlaysIter it = m_overlays.begin();
+    while (it != m_overlays.end() && (*it)->iPTSStartTime <= pts)
     {
-      //CLog::Log(LOGDEBUG,"CDVDOverlay::CleanUp, removing {}", (int)(pts / 1000));
-      //CLog::Log(LOGDEBUG,"CDVDOverlay::CleanUp, remove, start : {}, stop : {}", (int)(pOverlay->iPTSStartTime / 1000), (int)(pOverlay->iPTSStopTime / 1000));
-      it = Remove(it);
-      continue;
-    }
-    else if (pOverlay->bForced)
-    {
-      //Check for newer replacements
-      VecOverlaysIter it2 = it;
-      bool bNewer = false;
-      while (!bNewer && ++it2 != m_overlays.end())
-      {
-        CDVDOverlay* pOverlay2 = *it2;
-        if (pOverlay2->bForced && pOverlay2->iPTSStartTime <= pts) bNewer = true;
-      }
+      CDVDOverlay* pOverlay = *it;
 
-      if (bNewer)
+      // never delete forced overlays, they are used in menu's
+      // clear takes care of removing them
+      // also if stoptime = 0, it means the next subtitles will use its starttime as the stoptime
+      // which means we cannot delete overlays with stoptime 0
+      if (!pOverlay->bForced && pOverlay->iPTSStopTime <= pts && pOverlay->iPTSStopTime != 0)
       {
         it = Remove(it);
         continue;
       }
+
+      if (!pOverlay->bForced && pOverlay->iPTSStopTime != 0)
+        m_nextExpiry = std::min(m_nextExpiry, pOverlay->iPTSStopTime);
+      ++it;
     }
-    ++it;
+
+    // the first overlay still to come bounds the stop times of all following ones
+    if (it != m_overlays.end())
+      m_nextExpiry = std::min(m_nextExpiry, (*it)->iPTSStartTime);
   }
 
+  // a forced overlay is replaced by any newer forced one that already started
+  if (m_forcedCount > 1)
+  {
+    const auto itNewest =
+        std::find_if(std::make_reverse_iterator(StartedEnd(pts)), m_overlays.rend(),
+                     [](const CDVDOverlay* pOverlay) { return pOverlay->bForced; });
+    if (itNewest != m_overlays.rend())
+    {
+      auto newest = std::distance(m_overlays.begin(), itNewest.base()) - 1;
+      VecOverlaysIter it = m_overlays.begin();
+      while (it != m_overlays.begin() + newest)
+      {
+        if ((*it)->bForced)
+        {
+          it = Remove(it);
+          newest--;
+          continue;
+        }
+        ++it;
+      }
+    }
+  }
 }
 
 void CDVDOverlayContainer::Flush()
@@ -123,6 +208,7 @@ void CDVDOverlayContainer::Flush()
                                     return isFlushable;
                                   }),
                    m_overlays.end());
+  RebuildIndex();
 }
 
 void CDVDOverlayContainer::Clear()
@@ -133,6 +219,7 @@ void CDVDOverlayContainer::Clear()
     overlay->Release();
   }
   m_overlays.clear();
+  RebuildIndex();
 }
 
 size_t CDVDOverlayContainer::GetSize()
@@ -12,6 +12,7 @@
 #include "threads/CriticalSection.h"
 
 #include <memory>
+#include <vector>
 
 class CDVDInputStreamNavigator;
 class CDVDDemuxSPU;
@@ -36,7 +37,18 @@ public:
   */
   void ProcessAndAddOverlayIfValid(CDVDOverlay* pPicture);
 
-  VecOverlays* GetOverlays(); // get the first overlay in this fifo
+  /*!
+  * \brief Collects the overlays that are visible at the given time
+  *
+  * \details Overlays are kept sorted by start time, so only overlays that already started
+  * are visited. Groups are expanded into their members.
+  *
+  * \param pts playback pts, used for forced overlays
+  * \param subtitlePts pts adjusted by the subtitle delay, used for all other overlays
+  * \param includeSubtitles whether non forced overlays should be returned at all
+  * \param overlays receives the visible overlays, not acquired
+  */
+  void GetActiveOverlays(double pts, double subtitlePts, bool includeSubtitles, VecOverlays& overlays);
   bool ContainsOverlayType(DVDOverlayType type);
 
   void Clear(); // clear the fifo and delete all overlays
@@ -55,6 +67,10 @@ public:
 
 private:
   VecOverlaysIter Remove(VecOverlaysIter itOverlay); // removes a specific overlay
+  VecOverlaysIter StartedEnd(double pts); // first overlay starting after pts
+  void RebuildIndex();
 
-  VecOverlays m_overlays;
+  VecOverlays m_overlays; // sorted by start time, insertion order for equal starts
+  double m_nextExpiry; // no overlay can expire before this pts
+  size_t m_forcedCount = 0;
 };
@@ -16,6 +16,7 @@ extern "C" {
 
 #define CODEC_FORCE_SOFTWARE 0x01
 #define CODEC_ALLOW_FALLBACK 0x02
+#define CODEC_THUMBNAIL 0x04 // keyframes only, output quality may be reduced
 
 class CDemuxStream;
 struct DemuxCryptoSession;
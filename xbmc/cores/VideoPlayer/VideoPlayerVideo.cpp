@@ -801,30 +801,11 @@ void CVideoPlayerVideo::ProcessOverlays(const VideoPicture* pSource, double pts)
   {
     std::unique_lock<CCriticalSection> lock(*m_pOverlayContainer);
 
-    VecOverlays* pVecOverlays = m_pOverlayContainer->GetOverlays();
-    VecOverlaysIter it = pVecOverlays->begin();
-
     //Check all overlays and render those that should be rendered, based on time and forced
     //Both forced and subs should check timing
-    while (it != pVecOverlays->end())
-    {
-      CDVDOverlay* pOverlay = *it++;
-      if(!pOverlay->bForced && !m_bRenderSubs)
-        continue;
-
-      double pts2 = pOverlay->bForced ? pts : pts - m_iSubtitleDelay;
-
-      if((pOverlay->iPTSStartTime <= pts2 && (pOverlay->iPTSStopTime > pts2 || pOverlay->iPTSStopTime == 0LL)))
-      {
-        if(pOverlay->IsOverlayType(DVDOVERLAY_TYPE_GROUP))
-          overlays.insert(overlays.end(), static_cast<CDVDOverlayGroup*>(pOverlay)->m_overlays.begin()
-                                        , static_cast<CDVDOverlayGroup*>(pOverlay)->m_overlays.end());
-        else
-          overlays.push_back(pOverlay);
-      }
-    }
+    m_pOverlayContainer->GetActiveOverlays(pts, pts - m_iSubtitleDelay, m_bRenderSubs, overlays);
 
-    for(it = overlays.begin(); it != overlays.end(); ++it)
+    for (VecOverlaysIter it = overlays.begin(); it != overlays.end(); ++it)
     {
       double pts2 = (*it)->bForced ? pts : pts - m_iSubtitleDelay;
       m_renderManager.AddOverlay(*it, pts2);
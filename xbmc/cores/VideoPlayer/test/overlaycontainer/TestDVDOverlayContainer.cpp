@@ -0,0 +1,184 @@
+/*
+ *  Copyright (C) 2023 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/VideoPlayer/DVDCodecs/Overlay/DVDOverlay.h"
+#include "cores/VideoPlayer/DVDOverlayContainer.h"
+
+#include <chrono>
+#include <iostream>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+CDVDOverlay* MakeOverlay(double start, double stop, bool forced = false)
+{
+  CDVDOverlay* overlay = new CDVDOverlay(DVDOVERLAY_TYPE_TEXT);
+  overlay->iPTSStartTime = start;
+  overlay->iPTSStopTime = stop;
+  overlay->bForced = forced;
+  return overlay;
+}
+
+// container takes its own reference
+void Add(CDVDOverlayContainer& container, CDVDOverlay* overlay)
+{
+  container.ProcessAndAddOverlayIfValid(overlay);
+  overlay->Release();
+}
+
+VecOverlays Active(CDVDOverlayContainer& container, double pts, double delay = 0.0)
+{
+  VecOverlays overlays;
+  container.GetActiveOverlays(pts, pts - delay, true, overlays);
+  return overlays;
+}
+} // namespace
+
+TEST(TestDVDOverlayContainer, ActiveAtPts)
+{
+  CDVDOverlayContainer container;
+  CDVDOverlay* first = MakeOverlay(100, 200);
+  CDVDOverlay* second = MakeOverlay(150, 300);
+  CDVDOverlay* third = MakeOverlay(400, 500);
+  Add(container, first);
+  Add(container, second);
+  Add(container, third);
+
+  EXPECT_TRUE(Active(container, 50).empty());
+  EXPECT_EQ(VecOverlays({first}), Active(container, 100));
+  EXPECT_EQ(VecOverlays({first, second}), Active(container, 160));
+  EXPECT_EQ(VecOverlays({second}), Active(container, 200));
+  EXPECT_TRUE(Active(container, 350).empty());
+  EXPECT_EQ(VecOverlays({third}), Active(container, 450));
+
+  // subtitle delay only applies to non forced overlays
+  EXPECT_EQ(VecOverlays({third}), Active(container, 550, 100));
+
+  VecOverlays overlays;
+  container.GetActiveOverlays(450, 450, false, overlays);
+  EXPECT_TRUE(overlays.empty());
+}
+
+TEST(TestDVDOverlayContainer, OutOfOrderInsert)
+{
+  CDVDOverlayContainer container;
+  CDVDOverlay* late = MakeOverlay(400, 500);
+  CDVDOverlay* early = MakeOverlay(100, 200);
+  Add(container, late);
+  Add(container, early);
+
+  EXPECT_EQ(VecOverlays({early}), Active(container, 150));
+  EXPECT_EQ(VecOverlays({late}), Active(container, 450));
+}
+
+TEST(TestDVDOverlayContainer, OpenEndedStoppedByNext)
+{
+  CDVDOverlayContainer container;
+  CDVDOverlay* first = MakeOverlay(100, 0);
+  CDVDOverlay* second = MakeOverlay(200, 0);
+  Add(container, first);
+  EXPECT_EQ(VecOverlays({first}), Active(container, 1000));
+
+  Add(container, second);
+  EXPECT_EQ(200, first->iPTSStopTime);
+  EXPECT_EQ(VecOverlays({first}), Active(container, 150));
+  EXPECT_EQ(VecOverlays({second}), Active(container, 1000));
+
+  container.CleanUp(250);
+  EXPECT_EQ(1u, container.GetSize());
+}
+
+TEST(TestDVDOverlayContainer, CleanUp)
+{
+  CDVDOverlayContainer container;
+  for (int i = 0; i < 10; ++i)
+    Add(container, MakeOverlay(i * 100, i * 100 + 50));
+  EXPECT_EQ(10u, container.GetSize());
+
+  container.CleanUp(20);
+  EXPECT_EQ(10u, container.GetSize());
+
+  container.CleanUp(450);
+  EXPECT_EQ(5u, container.GetSize());
+
+  // removable overlay added after an incremental clean up
+  Add(container, MakeOverlay(0, 10));
+  container.CleanUp(460);
+  EXPECT_EQ(5u, container.GetSize());
+
+  container.CleanUp(10000);
+  EXPECT_EQ(0u, container.GetSize());
+}
+
+TEST(TestDVDOverlayContainer, ForcedReplacement)
+{
+  CDVDOverlayContainer container;
+  CDVDOverlay* menu1 = MakeOverlay(100, 200, true);
+  CDVDOverlay* menu2 = MakeOverlay(300, 400, true);
+  CDVDOverlay* menu3 = MakeOverlay(500, 600, true);
+  Add(container, menu1);
+  Add(container, menu2);
+  Add(container, menu3);
+
+  // forced overlays never expire on their own
+  container.CleanUp(250);
+  EXPECT_EQ(3u, container.GetSize());
+  EXPECT_EQ(VecOverlays({menu1}), Active(container, 150));
+
+  // but are replaced by newer forced ones which already started
+  container.CleanUp(350);
+  EXPECT_EQ(2u, container.GetSize());
+  EXPECT_EQ(VecOverlays({menu2}), Active(container, 350));
+
+  container.CleanUp(10000);
+  EXPECT_EQ(1u, container.GetSize());
+  EXPECT_TRUE(container.ContainsOverlayType(DVDOVERLAY_TYPE_TEXT));
+
+  container.Clear();
+  EXPECT_EQ(0u, container.GetSize());
+}
+
+TEST(TestDVDOverlayContainer, Groups)
+{
+  CDVDOverlayContainer container;
+  CDVDOverlayGroup* group = new CDVDOverlayGroup();
+  group->iPTSStartTime = 100;
+  group->iPTSStopTime = 200;
+  CDVDOverlay* member1 = MakeOverlay(0, 0);
+  CDVDOverlay* member2 = MakeOverlay(0, 0);
+  group->m_overlays.push_back(member1);
+  group->m_overlays.push_back(member2);
+  Add(container, group);
+
+  EXPECT_EQ(VecOverlays({member1, member2}), Active(container, 150));
+}
+
+// Micro benchmark, run with --gtest_also_run_disabled_tests
+TEST(TestDVDOverlayContainer, DISABLED_Benchmark)
+{
+  // two hours of dense subtitles loaded ahead
+  constexpr int count = 20000;
+  constexpr int frames = 100000;
+  CDVDOverlayContainer container;
+  for (int i = 0; i < count; ++i)
+    Add(container, MakeOverlay(i * 1000.0, i * 1000.0 + 500.0));
+
+  VecOverlays overlays;
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < frames; ++i)
+  {
+    overlays.clear();
+    container.CleanUp(i * 10.0);
+    container.GetActiveOverlays(i * 10.0, i * 10.0, true, overlays);
+  }
+  const auto end = std::chrono::steady_clock::now();
+  std::cout << "GetActiveOverlays with " << count << " overlays: "
+            << std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count() / frames
+            << " ns per frame\n";
+}
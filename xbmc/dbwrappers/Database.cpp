@@ -12,10 +12,14 @@
 #include "DbUrl.h"
 #include "ServiceBroker.h"
 #include "filesystem/SpecialProtocol.h"
+#include "interfaces/AnnouncementManager.h"
+#include "playlists/SmartPlayList.h"
+#include "playlists/SmartPlaylistCache.h"
 #include "profiles/ProfileManager.h"
 #include "settings/AdvancedSettings.h"
 #include "settings/SettingsComponent.h"
 #include "sqlitedataset.h"
+#include "threads/CriticalSection.h"
 #include "utils/SortUtils.h"
 #include "utils/StringUtils.h"
 #include "utils/log.h"
@@ -28,10 +32,30 @@
 #include "platform/posix/ConvUtils.h"
 #endif
 
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <mutex>
+
 using namespace dbiplus;
 
 #define MAX_COMPRESS_COUNT 20
 
+namespace
+{
+// the trigram tokenizer can't match anything shorter
+constexpr size_t FULLTEXT_MIN_CHARACTERS = 3;
+
+// usable full-text indices of each database file, so they're only probed on the first open
+CCriticalSection fullTextSection;
+std::map<std::string, std::set<std::string>> fullTextTables;
+
+std::string GetFullTextKey(const dbiplus::Database& db)
+{
+  return std::string(db.getHostName()) + "/" + db.getDatabase();
+}
+} // unnamed namespace
+
 void CDatabase::Filter::AppendField(const std::string& strField)
 {
   if (strField.empty())
@@ -576,6 +600,11 @@ void CDatabase::CopyDB(const std::string& latestDb)
 void CDatabase::DropAnalytics()
 {
   m_pDB->drop_analytics();
+
+  // the triggers keeping the full-text indices up to date are gone
+  m_fullTextTables.clear();
+  std::unique_lock<CCriticalSection> lock(fullTextSection);
+  fullTextTables.erase(GetFullTextKey(*m_pDB));
 }
 
 bool CDatabase::Connect(const std::string& dbName, const DatabaseSettings& dbSettings, bool create)
@@ -630,6 +659,12 @@ bool CDatabase::Connect(const std::string& dbName, const DatabaseSettings& dbSet
     {
       if (dbSettings.type == "sqlite3")
       {
+        // a previous file of the same name may have been removed
+        {
+          std::unique_lock<CCriticalSection> lock(fullTextSection);
+          fullTextTables.erase(GetFullTextKey(*m_pDB));
+        }
+
         //  Modern file systems have a cluster/block size of 4k.
         //  To gain better performance when performing write
         //  operations to the database, set the page size of the
@@ -649,6 +684,21 @@ bool CDatabase::Connect(const std::string& dbName, const DatabaseSettings& dbSet
       m_pDS->exec("PRAGMA cache_size=4096\n");
       m_pDS->exec("PRAGMA synchronous='NORMAL'\n");
       m_pDS->exec("PRAGMA count_changes='OFF'\n");
+
+      // run queries outside of transactions on shared read only connections, so browsing
+      // isn't blocked by a running scan
+      if (!static_cast<SqliteDatabase*>(m_pDB.get())->setReaderPool(true))
+        CLog::Log(LOGDEBUG, "{} - reader connections disabled for {}", __FUNCTION__, dbName);
+
+      std::unique_lock<CCriticalSection> lock(fullTextSection);
+      auto it = fullTextTables.find(GetFullTextKey(*m_pDB));
+      if (it != fullTextTables.end())
+        m_fullTextTables = it->second;
+      else
+      {
+        LoadFullTextIndices();
+        fullTextTables[GetFullTextKey(*m_pDB)] = m_fullTextTables;
+      }
     }
   }
   catch (DbErrors& error)
@@ -663,6 +713,242 @@ bool CDatabase::Connect(const std::string& dbName, const DatabaseSettings& dbSet
   return true;
 }
 
+void CDatabase::LoadFullTextIndices()
+{
+  m_fullTextTables.clear();
+
+  std::vector<std::string> tables;
+  std::set<std::string> triggers;
+  try
+  {
+    m_pDS->query("SELECT type, name FROM sqlite_master WHERE (type = 'table' AND sql LIKE "
+                 "'CREATE VIRTUAL TABLE % USING fts5%') OR type = 'trigger'");
+    while (!m_pDS->eof())
+    {
+      const std::string name = m_pDS->fv(1).get_asString();
+      if (m_pDS->fv(0).get_asString() == "trigger")
+        triggers.insert(name);
+      else if (StringUtils::EndsWith(name, "_fts"))
+        tables.push_back(name.substr(0, name.size() - 4));
+      m_pDS->next();
+    }
+    m_pDS->close();
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "{} failed", __FUNCTION__);
+    return;
+  }
+
+  for (const auto& table : tables)
+  {
+    // the index is stale if its triggers were dropped, it's recreated with the analytics
+    if (triggers.find("tgr_" + table + "_fts_insert") == triggers.end())
+      continue;
+
+    try
+    {
+      m_pDS->query("SELECT rowid FROM " + table + "_fts WHERE " + table +
+                   "_fts MATCH 'kodi' LIMIT 1");
+      m_pDS->close();
+      m_fullTextTables.insert(table);
+    }
+    catch (...)
+    {
+      // the database was created by a build with FTS5 support, drop the triggers so that
+      // changes to the table don't fail
+      CLog::Log(LOGWARNING, "{} - full-text index of {} can't be used, disabling it",
+                __FUNCTION__, table);
+      try
+      {
+        for (const char* trigger : {"insert", "delete", "update"})
+          m_pDS->exec("DROP TRIGGER IF EXISTS tgr_" + table + "_fts_" + trigger);
+      }
+      catch (...)
+      {
+        CLog::Log(LOGERROR, "{} - failed to drop full-text triggers of {}", __FUNCTION__, table);
+      }
+    }
+  }
+}
+
+void CDatabase::CreateFullTextIndex(const std::string& table,
+                                    const std::string& idColumn,
+                                    const std::vector<std::string>& columns)
+{
+  if (!m_sqlite)
+    return;
+
+  const std::string index = table + "_fts";
+  const std::string fields = StringUtils::Join(columns, ", ");
+  std::vector<std::string> newValues;
+  std::vector<std::string> oldValues;
+  for (const auto& column : columns)
+  {
+    newValues.push_back("new." + column);
+    oldValues.push_back("old." + column);
+  }
+  const std::string insert = StringUtils::Format("INSERT INTO {}(rowid, {}) VALUES (new.{}, {});",
+                                                 index, fields, idColumn,
+                                                 StringUtils::Join(newValues, ", "));
+  const std::string remove =
+      StringUtils::Format("INSERT INTO {0}({0}, rowid, {1}) VALUES ('delete', old.{2}, {3});",
+                          index, fields, idColumn, StringUtils::Join(oldValues, ", "));
+
+  try
+  {
+    m_pDS->exec(StringUtils::Format("CREATE VIRTUAL TABLE IF NOT EXISTS {} USING fts5({}, "
+                                    "content='{}', content_rowid='{}', tokenize='trigram')",
+                                    index, fields, table, idColumn));
+  }
+  catch (...)
+  {
+    CLog::Log(LOGINFO, "{} - full-text search is not supported, not indexing {}", __FUNCTION__,
+              table);
+    return;
+  }
+
+  CLog::Log(LOGINFO, "{} - creating full-text index for {}", __FUNCTION__, table);
+  m_pDS->exec(StringUtils::Format("CREATE TRIGGER tgr_{}_fts_insert AFTER INSERT ON {} BEGIN {} END",
+                                  table, table, insert));
+  m_pDS->exec(StringUtils::Format("CREATE TRIGGER tgr_{}_fts_delete AFTER DELETE ON {} BEGIN {} END",
+                                  table, table, remove));
+  m_pDS->exec(StringUtils::Format(
+      "CREATE TRIGGER tgr_{}_fts_update AFTER UPDATE OF {} ON {} BEGIN {} {} END", table, fields,
+      table, remove, insert));
+  // changes made while the triggers were missing (e.g. during UpdateTables) are picked up here
+  m_pDS->exec(StringUtils::Format("INSERT INTO {0}({0}) VALUES ('rebuild')", index));
+
+  m_fullTextTables.insert(table);
+  std::unique_lock<CCriticalSection> lock(fullTextSection);
+  fullTextTables[GetFullTextKey(*m_pDB)].insert(table);
+}
+
+void CDatabase::CreateMaterializedView(const std::string& view,
+                                       const std::string& select,
+                                       const std::string& idColumn,
+                                       const std::vector<std::string>& indexColumns /* = {} */)
+{
+  if (!m_sqlite)
+  {
+    m_pDS->exec("CREATE VIEW " + view + " AS " + select);
+    return;
+  }
+
+  const std::string data = view + "_data";
+  m_pDS->exec("CREATE VIEW " + view + "_source AS " + select);
+  m_pDS->exec("DROP TABLE IF EXISTS " + data);
+  m_pDS->exec("CREATE TABLE " + data + " AS SELECT * FROM " + view + "_source");
+  m_pDS->exec(StringUtils::Format("CREATE INDEX ix_{0}_1 ON {0} ({1})", data, idColumn));
+  for (size_t i = 0; i < indexColumns.size(); i++)
+    m_pDS->exec(StringUtils::Format("CREATE INDEX ix_{0}_{1} ON {0} ({2})", data, i + 2,
+                                    indexColumns[i]));
+  m_pDS->exec("CREATE VIEW " + view + " AS SELECT * FROM " + data);
+}
+
+void CDatabase::CreateMaterializedViewTrigger(const std::string& view,
+                                              const std::string& idColumn,
+                                              const std::string& table,
+                                              const std::string& event,
+                                              const std::string& ids)
+{
+  if (!m_sqlite)
+    return;
+
+  const std::string data = view + "_data";
+  std::string name = StringUtils::Format("tgr_{}_{}_{}", view, table, event.substr(0, event.find(' ')));
+  StringUtils::ToLower(name);
+
+  m_pDS->exec(StringUtils::Format("CREATE TRIGGER {0} AFTER {1} ON {2} FOR EACH ROW BEGIN "
+                                  "DELETE FROM {3} WHERE {4} IN ({5}); "
+                                  "INSERT INTO {3} SELECT * FROM {6}_source WHERE {4} IN ({5}); "
+                                  "END",
+                                  name, event, table, data, idColumn, ids, view));
+}
+
+bool CDatabase::CheckMaterializedViews(bool rebuild /* = false */,
+                                       bool compareRows /* = false */)
+{
+  if (!m_sqlite || nullptr == m_pDB || nullptr == m_pDS)
+    return true;
+
+  try
+  {
+    std::vector<std::string> views;
+    m_pDS->query("SELECT name FROM sqlite_master WHERE type = 'view' AND name LIKE '%\\_source' "
+                 "ESCAPE '\\'");
+    while (!m_pDS->eof())
+    {
+      const std::string name = m_pDS->fv(0).get_asString();
+      views.push_back(name.substr(0, name.size() - 7));
+      m_pDS->next();
+    }
+    m_pDS->close();
+
+    for (const auto& view : views)
+    {
+      const std::string data = view + "_data";
+      const std::string source = view + "_source";
+      if (!rebuild)
+      {
+        const int rows = GetSingleValueInt("SELECT COUNT(1) FROM " + data, m_pDS);
+        const int expected = GetSingleValueInt("SELECT COUNT(1) FROM " + source, m_pDS);
+        // comparing every row means evaluating the whole view, only do it when asked to
+        const int differences =
+            compareRows && rows == expected
+                ? GetSingleValueInt("SELECT COUNT(1) FROM (SELECT * FROM " + source + " EXCEPT "
+                                    "SELECT * FROM " + data + ")", m_pDS)
+                : 0;
+        if (rows == expected && differences == 0)
+          continue;
+
+        CLog::Log(LOGWARNING, "{} - {} is inconsistent ({} rows, {} expected, {} differ), "
+                  "rebuilding", __FUNCTION__, view, rows, expected, differences);
+      }
+
+      auto start = std::chrono::steady_clock::now();
+      BeginTransaction();
+      m_pDS->exec("DELETE FROM " + data);
+      m_pDS->exec("INSERT INTO " + data + " SELECT * FROM " + source);
+      if (!CommitTransaction())
+        return false;
+      auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+          std::chrono::steady_clock::now() - start);
+      CLog::Log(LOGINFO, "{} - rebuilt {} in {} ms", __FUNCTION__, view, duration.count());
+    }
+    return true;
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "{} failed", __FUNCTION__);
+    RollbackTransaction();
+  }
+  return false;
+}
+
+std::string CDatabase::GetFullTextCondition(const std::string& table,
+                                            const std::string& idField,
+                                            const std::string& text) const
+{
+  if (m_fullTextTables.find(table) == m_fullTextTables.end())
+    return "";
+
+  // LIKE wildcards have no equivalent in a full-text query
+  if (text.find_first_of("%_") != std::string::npos)
+    return "";
+
+  const size_t characters = std::count_if(text.begin(), text.end(),
+                                          [](char c) { return (c & 0xC0) != 0x80; });
+  if (characters < FULLTEXT_MIN_CHARACTERS)
+    return "";
+
+  // a quoted trigram phrase matches the text anywhere in the indexed columns
+  std::string phrase = text;
+  StringUtils::Replace(phrase, "\"", "\"\"");
+  return PrepareSQL("%s IN (SELECT rowid FROM %s_fts WHERE %s_fts MATCH '\"%s\"')",
+                    idField.c_str(), table.c_str(), table.c_str(), phrase.c_str());
+}
+
 int CDatabase::GetDBVersion()
 {
   m_pDS->query("SELECT idVersion FROM version\n");
@@ -782,6 +1068,14 @@ void CDatabase::RollbackTransaction()
   {
     CLog::Log(LOGERROR, "database:rollbacktransaction failed");
   }
+
+  // full-text indices created in the transaction are gone again, probe them on the next open
+  if (nullptr != m_pDB && !m_fullTextTables.empty())
+  {
+    m_fullTextTables.clear();
+    std::unique_lock<CCriticalSection> lock(fullTextSection);
+    fullTextTables.erase(GetFullTextKey(*m_pDB));
+  }
 }
 
 bool CDatabase::CreateDatabase()
@@ -832,6 +1126,61 @@ bool CDatabase::BuildSQL(const std::string& strQuery, const Filter& filter, std:
   return true;
 }
 
+std::string CDatabase::GetSmartPlaylistWhereClause(const CSmartPlaylist& playlist,
+                                                   const std::string& json,
+                                                   const std::string& itemType,
+                                                   const std::string& from /* = std::string() */,
+                                                   const std::string& idField /* = std::string() */)
+{
+  std::set<std::string> playlists;
+  CSmartPlaylistCache& cache = CServiceBroker::GetSmartPlaylistCache();
+  if (!cache.IsEnabled() || !playlist.IsCacheable())
+    return playlist.GetWhereClause(*this, playlists);
+
+  // profiles use databases of the same name in different folders (or on different servers)
+  const std::string database = StringUtils::Format("{}:{}/{}", m_pDB->getHostName(),
+                                                   m_pDB->getPort(), m_pDB->getDatabase());
+  const std::string key = CSmartPlaylistCache::GetKey(database, itemType, json);
+  CSmartPlaylistCache::Query query;
+  if (!cache.Lookup(key, query))
+  {
+    const std::string where = playlist.GetWhereClause(*this, playlists);
+    // other clients of a shared database change it without announcing it to us
+    cache.Add(key,
+              CSmartPlaylist::IsMusicType(itemType) ? ANNOUNCEMENT::AudioLibrary
+                                                    : ANNOUNCEMENT::VideoLibrary,
+              itemType, where, m_sqlite && !from.empty());
+    return where;
+  }
+
+  if (!query.resolve)
+    return query.where;
+
+  const std::string sql = "SELECT GROUP_CONCAT(DISTINCT " + idField + ") FROM " + from +
+                          " WHERE " + query.where;
+  std::string resolved;
+  try
+  {
+    std::unique_ptr<Dataset> pDS(m_pDB->CreateDataset());
+    if (pDS->query(sql))
+    {
+      resolved = CSmartPlaylistCache::FormatIdClause(
+          idField, pDS->num_rows() > 0 ? pDS->fv(0).get_asString() : std::string());
+      pDS->close();
+    }
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "{} - failed on query '{}'", __FUNCTION__, sql);
+    resolved.clear();
+  }
+
+  if (!cache.SetResolved(key, query.generation, resolved))
+    return query.where;
+
+  return resolved;
+}
+
 bool CDatabase::BuildSQL(const std::string& strBaseDir,
                          const std::string& strQuery,
                          Filter& filter,
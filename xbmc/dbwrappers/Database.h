@@ -15,12 +15,14 @@ class Dataset;
 } // namespace dbiplus
 
 #include <memory>
+#include <set>
 #include <string>
 #include <vector>
 
 class DatabaseSettings; // forward
 class CDbUrl;
 class CProfileManager;
+class CSmartPlaylist;
 struct SortDescription;
 
 class CDatabase
@@ -240,6 +242,30 @@ public:
    */
   size_t GetDeleteQueriesCount();
 
+  /*!
+   * @brief Get a condition limiting a query to the rows of a table whose full-text indexed
+   *        columns contain the given text.
+   * @remarks The condition only narrows down the rows to check, the actual LIKE condition
+   *          still has to be applied to get the exact result.
+   * @param table The table with the full-text index, see CreateFullTextIndex().
+   * @param idField The (qualified) field holding the row id of the table in the query.
+   * @param text The text to search for.
+   * @return The condition or an empty string if there is no index or it can't be used for the text.
+   */
+  std::string GetFullTextCondition(const std::string& table,
+                                   const std::string& idField,
+                                   const std::string& text) const;
+
+  /*!
+   * @brief Compare the stored rows of all materialized views with their definition and
+   *        rebuild the ones that differ.
+   * @param rebuild Rebuild all materialized views without checking them.
+   * @param compareRows Compare the content of every row instead of only the number of rows.
+   *        This evaluates the full view definition and is therefore slow on large libraries.
+   * @return True if all views are consistent or were rebuilt successfully, false otherwise.
+   */
+  bool CheckMaterializedViews(bool rebuild = false, bool compareRows = false);
+
   virtual bool GetFilter(CDbUrl& dbUrl, Filter& filter, SortDescription& sorting) { return true; }
   virtual bool BuildSQL(const std::string& strBaseDir,
                         const std::string& strQuery,
@@ -294,8 +320,70 @@ protected:
 
   int GetDBVersion();
 
+  /*!
+   * @brief Create a trigram full-text index "<table>_fts" over columns of a table. The index
+   *        is kept in sync by triggers and rebuilt from the table contents.
+   * @remarks Only available with SQLite built with FTS5 (3.34 or later), should be called
+   *          from CreateAnalytics().
+   * @param table The table to index.
+   * @param idColumn The INTEGER PRIMARY KEY column of the table.
+   * @param columns The text columns to index.
+   */
+  void CreateFullTextIndex(const std::string& table,
+                           const std::string& idColumn,
+                           const std::vector<std::string>& columns);
+
+  /*!
+   * @brief Create a view whose rows are stored in a table ("<view>_data") instead of being
+   *        computed from its joins on every query. Without SQLite a plain view is created.
+   * @remarks The rows are kept up to date by triggers added with
+   *          CreateMaterializedViewTrigger(), the view as defined by the select statement
+   *          remains available as "<view>_source". Should be called from CreateViews(), the
+   *          stored rows are rebuilt on every call.
+   * @param view The name of the view.
+   * @param select The SELECT statement defining the view.
+   * @param idColumn The column of the view identifying the rows to refresh.
+   * @param indexColumns Additional indices to create on the stored rows, each entry being a
+   *        comma separated list of columns, e.g. "idShow, idSeason".
+   */
+  void CreateMaterializedView(const std::string& view,
+                              const std::string& select,
+                              const std::string& idColumn,
+                              const std::vector<std::string>& indexColumns = {});
+
+  /*!
+   * @brief Refresh rows of a materialized view whenever a table it depends on changes.
+   * @param view The materialized view, see CreateMaterializedView().
+   * @param idColumn The column of the view identifying the rows to refresh.
+   * @param table The table to watch.
+   * @param event The trigger event, e.g. "INSERT", "DELETE" or "UPDATE OF strPath".
+   * @param ids SQL selecting the ids of the rows to refresh, can refer to NEW and OLD.
+   */
+  void CreateMaterializedViewTrigger(const std::string& view,
+                                     const std::string& idColumn,
+                                     const std::string& table,
+                                     const std::string& event,
+                                     const std::string& ids);
+
   bool BuildSQL(const std::string& strQuery, const Filter& filter, std::string& strSQL);
 
+  /*!
+   * @brief Get the where clause of a smart playlist filtering a listing.
+   * @remarks Compiled rules and, for playlists listed repeatedly, the ids of the matching
+   *          items are kept in the smart playlist cache until the library changes.
+   * @param playlist The smart playlist loaded from json.
+   * @param json The json the playlist was loaded from.
+   * @param itemType The type of the listed items.
+   * @param from The view (and joins) to select the ids of matching items from, empty if the
+   *             ids can't be resolved for the listing.
+   * @param idField The id column of the listed items, e.g. "movie_view.idMovie".
+   */
+  std::string GetSmartPlaylistWhereClause(const CSmartPlaylist& playlist,
+                                          const std::string& json,
+                                          const std::string& itemType,
+                                          const std::string& from = std::string(),
+                                          const std::string& idField = std::string());
+
   bool m_sqlite; ///< \brief whether we use sqlite (defaults to true)
 
   std::unique_ptr<dbiplus::Database> m_pDB;
@@ -309,6 +397,7 @@ protected:
 private:
   void InitSettings(DatabaseSettings& dbSettings);
   void UpdateVersionNumber();
+  void LoadFullTextIndices();
 
   bool m_bMultiInsert =
       false; /*!< True if there are any queries in the insert queue, false otherwise */
@@ -318,4 +407,6 @@ private:
 
   bool m_multipleExecute;
   std::vector<std::string> m_multipleQueries;
+
+  std::set<std::string> m_fullTextTables; ///< tables with a usable full-text index
 };
@@ -21,6 +21,7 @@
 #include <map>
 #include <sstream>
 #include <string>
+#include <vector>
 
 using namespace std::chrono_literals;
 
@@ -213,6 +214,7 @@ SqliteDatabase::SqliteDatabase()
 
   active = false;
   _in_transaction = false; // for transaction
+  wal = false;
 
   error = "Unknown database error"; //S_NO_CONNECTION;
   host = "localhost";
@@ -306,6 +308,83 @@ static int AlphaNumericCollation(
   return StringUtils::AlphaNumericCollation(nKey1, pKey1, nKey2, pKey2);
 }
 
+//************* SqliteReaderPool implementation ***************
+
+/* Read only connections to one database file, shared by all SqliteDatabase
+   instances connected to it. With write ahead logging these never wait for
+   a writer, so queries from the GUI or JSON-RPC can run during a library scan. */
+class SqliteReaderPool
+{
+public:
+  explicit SqliteReaderPool(const std::string& path) : m_path(path) {}
+  ~SqliteReaderPool()
+  {
+    for (sqlite3* reader : m_idle)
+      sqlite3_close(reader);
+  }
+
+  static std::shared_ptr<SqliteReaderPool> Get(const std::string& path)
+  {
+    static std::mutex poolsLock;
+    static std::map<std::string, std::weak_ptr<SqliteReaderPool>> pools;
+
+    std::unique_lock<std::mutex> lock(poolsLock);
+    std::shared_ptr<SqliteReaderPool> pool = pools[path].lock();
+    if (!pool)
+    {
+      pool = std::make_shared<SqliteReaderPool>(path);
+      pools[path] = pool;
+    }
+    return pool;
+  }
+
+  sqlite3* Acquire()
+  {
+    {
+      std::unique_lock<std::mutex> lock(m_lock);
+      if (!m_idle.empty())
+      {
+        sqlite3* reader = m_idle.back();
+        m_idle.pop_back();
+        return reader;
+      }
+      if (m_open >= MAX_READERS)
+        return NULL;
+      m_open++;
+    }
+
+    sqlite3* reader = NULL;
+    if (sqlite3_open_v2(m_path.c_str(), &reader, SQLITE_OPEN_READONLY, NULL) == SQLITE_OK &&
+        sqlite3_create_collation(reader, "ALPHANUM", SQLITE_UTF8, 0, AlphaNumericCollation) ==
+            SQLITE_OK)
+    {
+      sqlite3_extended_result_codes(reader, 1);
+      sqlite3_busy_handler(reader, busy_callback, NULL);
+      return reader;
+    }
+
+    CLog::Log(LOGWARNING, "SqliteReaderPool: can't open {} for reading", m_path);
+    sqlite3_close(reader);
+    std::unique_lock<std::mutex> lock(m_lock);
+    m_open--;
+    return NULL;
+  }
+
+  void Release(sqlite3* reader)
+  {
+    std::unique_lock<std::mutex> lock(m_lock);
+    m_idle.push_back(reader);
+  }
+
+private:
+  static constexpr unsigned int MAX_READERS = 4;
+
+  const std::string m_path;
+  std::mutex m_lock;
+  std::vector<sqlite3*> m_idle;
+  unsigned int m_open = 0;
+};
+
 int SqliteDatabase::connect(bool create)
 {
   if (host.empty() || db.empty())
@@ -347,6 +426,15 @@ int SqliteDatabase::connect(bool create)
         CLog::Log(LOGFATAL, "SqliteDatabase: can not register collation");
         throw std::runtime_error("SqliteDatabase: can not register collation " + db_fullpath);
       }
+      // write ahead logging lets readers proceed while a write transaction is active. The
+      // journal mode is persistent, this is a no-op once the database has been converted.
+      result_set res;
+      wal = sqlite3_exec(conn, "PRAGMA journal_mode=WAL", &callback, &res, NULL) == SQLITE_OK &&
+            !res.records.empty() &&
+            StringUtils::EqualsNoCase(res.records[0]->at(0).get_asString(), "wal");
+      if (!wal)
+        CLog::Log(LOGWARNING, "SqliteDatabase: {} does not support write ahead logging",
+                  db_fullpath);
       active = true;
       return DB_CONNECTION_OK;
     }
@@ -383,10 +471,40 @@ void SqliteDatabase::disconnect(void)
 {
   if (active == false)
     return;
+  readers.reset();
   sqlite3_close(conn);
   active = false;
 }
 
+bool SqliteDatabase::setReaderPool(bool enable)
+{
+  if (!enable || !active || !wal)
+  {
+    readers.reset();
+    return false;
+  }
+
+  if (!readers)
+    readers = SqliteReaderPool::Get(URIUtils::AddFileToFolder(host, db));
+  return true;
+}
+
+sqlite3* SqliteDatabase::acquireReader()
+{
+  // queries within a transaction have to see its uncommitted changes
+  if (!readers || _in_transaction)
+    return NULL;
+  return readers->Acquire();
+}
+
+void SqliteDatabase::releaseReader(sqlite3* reader)
+{
+  if (readers)
+    readers->Release(reader);
+  else
+    sqlite3_close(reader);
+}
+
 int SqliteDatabase::create()
 {
   return connect(true);
@@ -653,6 +771,7 @@ SqliteDataset::SqliteDataset() : Dataset()
   haveError = false;
   db = NULL;
   autorefresh = false;
+  reader = NULL;
 }
 
 SqliteDataset::SqliteDataset(SqliteDatabase* newDb) : Dataset(newDb)
@@ -660,6 +779,7 @@ SqliteDataset::SqliteDataset(SqliteDatabase* newDb) : Dataset(newDb)
   haveError = false;
   db = newDb;
   autorefresh = false;
+  reader = NULL;
 }
 
 SqliteDataset::~SqliteDataset()
@@ -883,11 +1003,27 @@ bool SqliteDataset::query(const std::string& query)
 
   close();
 
+  SqliteDatabase* sqliteDb = static_cast<SqliteDatabase*>(db);
   sqlite3_stmt* stmt = NULL;
-  if (db->setErr(sqlite3_prepare_v2(handle(), query.c_str(), -1, &stmt, NULL), query.c_str()) !=
-      SQLITE_OK)
+  sqlite3* conn = sqliteDb->acquireReader();
+  if (conn && sqlite3_prepare_v2(conn, query.c_str(), -1, &stmt, NULL) != SQLITE_OK)
+  {
+    // e.g. the statement refers to objects not committed yet, use the main connection instead
+    sqlite3_finalize(stmt);
+    stmt = NULL;
+    sqliteDb->releaseReader(conn);
+    conn = NULL;
+  }
+  if (!conn && db->setErr(sqlite3_prepare_v2(handle(), query.c_str(), -1, &stmt, NULL),
+                          query.c_str()) != SQLITE_OK)
     throw DbErrors("%s", db->getErrorMsg());
 
+  if (conn)
+  {
+    std::unique_lock<std::mutex> lock(readerLock);
+    reader = conn;
+  }
+
   // column headers
   const unsigned int numColumns = sqlite3_column_count(stmt);
   result.record_header.resize(numColumns);
@@ -925,7 +1061,14 @@ bool SqliteDataset::query(const std::string& query)
     }
     result.records.push_back(res);
   }
-  if (db->setErr(sqlite3_finalize(stmt), query.c_str()) == SQLITE_OK)
+  const int finalizeResult = sqlite3_finalize(stmt);
+  if (conn)
+  {
+    std::unique_lock<std::mutex> lock(readerLock);
+    reader = NULL;
+    sqliteDb->releaseReader(conn);
+  }
+  if (db->setErr(finalizeResult, query.c_str()) == SQLITE_OK)
   {
     active = true;
     ds_state = dsSelect;
@@ -1059,5 +1202,9 @@ long SqliteDataset::nextid(const char* seq_name)
 void SqliteDataset::interrupt()
 {
   sqlite3_interrupt(handle());
+
+  std::unique_lock<std::mutex> lock(readerLock);
+  if (reader)
+    sqlite3_interrupt(reader);
 }
 } // namespace dbiplus
@@ -14,12 +14,16 @@
 
 #include "dataset.h"
 
+#include <memory>
+#include <mutex>
 #include <stdio.h>
 
 #include <sqlite3.h>
 
 namespace dbiplus
 {
+class SqliteReaderPool;
+
 /***************** Class SqliteDatabase definition ******************
 
        class 'SqliteDatabase' connects with Sqlite-server
@@ -32,6 +36,10 @@ protected:
   sqlite3* conn;
   bool _in_transaction;
   int last_err;
+  /* whether the database uses write ahead logging */
+  bool wal;
+  /* read only connections shared by all connections to the same file */
+  std::shared_ptr<SqliteReaderPool> readers;
 
 public:
   /* default constructor */
@@ -83,6 +91,13 @@ public:
   std::string vprepare(const char* format, va_list args) override;
 
   bool in_transaction() override { return _in_transaction; }
+
+  /* enables the read only connection pool, requires write ahead logging */
+  bool setReaderPool(bool enable);
+  /* get a read only connection for a query, NULL if the query has to use the main connection */
+  sqlite3* acquireReader();
+  /* return a connection obtained by acquireReader() */
+  void releaseReader(sqlite3* reader);
 };
 
 /***************** Class SqliteDataset definition *******************
@@ -96,6 +111,10 @@ class SqliteDataset : public Dataset
 protected:
   sqlite3* handle();
 
+  /* read only connection running the current query, if any */
+  sqlite3* reader;
+  std::mutex readerLock;
+
   /* Makes direct queries to database */
   virtual void make_query(StringList& _sql);
   /* Makes direct inserts into database */
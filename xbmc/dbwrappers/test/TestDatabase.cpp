@@ -0,0 +1,422 @@
+/*
+ *  Copyright (C) 2023 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "dbwrappers/Database.h"
+#include "dbwrappers/dataset.h"
+#include "dbwrappers/sqlitedataset.h"
+#include "filesystem/File.h"
+#include "filesystem/SpecialProtocol.h"
+#include "settings/AdvancedSettings.h"
+
+#include <gtest/gtest.h>
+
+namespace
+{
+
+class CMaterializedViewDatabase : public CDatabase
+{
+public:
+  bool Create()
+  {
+    DatabaseSettings settings;
+    settings.type = "sqlite3";
+    settings.host = CSpecialProtocol::TranslatePath("special://temp/");
+    return Connect(GetBaseDBName(), settings, true);
+  }
+
+  int Differences()
+  {
+    return GetSingleValueInt("SELECT COUNT(1) FROM (SELECT * FROM item_view_source EXCEPT "
+                             "SELECT * FROM item_view_data)") +
+           GetSingleValueInt("SELECT COUNT(1) FROM (SELECT * FROM item_view_data EXCEPT "
+                             "SELECT * FROM item_view_source)");
+  }
+
+  int Rows() { return GetSingleValueInt("SELECT COUNT(1) FROM item_view"); }
+
+  bool HasIndex(const std::string& name)
+  {
+    return GetSingleValueInt("SELECT COUNT(1) FROM sqlite_master WHERE type = 'index' AND name = '" +
+                             name + "'") == 1;
+  }
+
+protected:
+  void CreateTables() override
+  {
+    m_pDS->exec("CREATE TABLE grp (idGroup INTEGER PRIMARY KEY, strName TEXT)");
+    m_pDS->exec("CREATE TABLE item (idItem INTEGER PRIMARY KEY, idGroup INTEGER, strTitle TEXT)");
+  }
+
+  void CreateAnalytics() override
+  {
+    CreateMaterializedView("item_view",
+                           "SELECT item.idItem AS idItem, item.idGroup AS idGroup, "
+                           "item.strTitle AS strTitle, grp.strName AS strGroup FROM item "
+                           "LEFT JOIN grp ON grp.idGroup = item.idGroup",
+                           "idItem", {"idGroup", "idGroup, strTitle"});
+    CreateMaterializedViewTrigger("item_view", "idItem", "item", "INSERT", "NEW.idItem");
+    CreateMaterializedViewTrigger("item_view", "idItem", "item", "UPDATE",
+                                  "OLD.idItem, NEW.idItem");
+    CreateMaterializedViewTrigger("item_view", "idItem", "item", "DELETE", "OLD.idItem");
+    CreateMaterializedViewTrigger("item_view", "idItem", "grp", "UPDATE OF strName",
+                                  "SELECT idItem FROM item WHERE idGroup = NEW.idGroup");
+  }
+
+  int GetSchemaVersion() const override { return 1; }
+  const char* GetBaseDBName() const override { return "TestMaterializedView"; }
+};
+
+class TestMaterializedView : public testing::Test
+{
+protected:
+  void SetUp() override { ASSERT_TRUE(m_db.Create()); }
+
+  void TearDown() override
+  {
+    m_db.Close();
+    XFILE::CFile::Delete("special://temp/TestMaterializedView.db");
+  }
+
+  CMaterializedViewDatabase m_db;
+};
+
+} // namespace
+
+TEST_F(TestMaterializedView, Indices)
+{
+  EXPECT_TRUE(m_db.HasIndex("ix_item_view_data_1"));
+  EXPECT_TRUE(m_db.HasIndex("ix_item_view_data_2"));
+  EXPECT_TRUE(m_db.HasIndex("ix_item_view_data_3"));
+}
+
+TEST_F(TestMaterializedView, Triggers)
+{
+  ASSERT_TRUE(m_db.ExecuteQuery("INSERT INTO grp (idGroup, strName) VALUES (1, 'first')"));
+  ASSERT_TRUE(m_db.ExecuteQuery("INSERT INTO grp (idGroup, strName) VALUES (2, 'second')"));
+  for (int i = 1; i <= 10; i++)
+  {
+    ASSERT_TRUE(m_db.ExecuteQuery("INSERT INTO item (idItem, idGroup, strTitle) VALUES (" +
+                                  std::to_string(i) + ", " + std::to_string(i % 2 + 1) +
+                                  ", 'item " + std::to_string(i) + "')"));
+  }
+  EXPECT_EQ(10, m_db.Rows());
+  EXPECT_EQ(0, m_db.Differences());
+
+  // changes of the table the rows are identified by
+  ASSERT_TRUE(m_db.ExecuteQuery("UPDATE item SET strTitle = 'renamed' WHERE idItem = 3"));
+  ASSERT_TRUE(m_db.ExecuteQuery("UPDATE item SET idGroup = 2 WHERE idItem = 4"));
+  EXPECT_EQ(0, m_db.Differences());
+
+  // changing the id refreshes the old and the new row
+  ASSERT_TRUE(m_db.ExecuteQuery("UPDATE item SET idItem = 11 WHERE idItem = 5"));
+  EXPECT_EQ(10, m_db.Rows());
+  EXPECT_EQ(0, m_db.Differences());
+
+  // changes of a joined table
+  ASSERT_TRUE(m_db.ExecuteQuery("UPDATE grp SET strName = 'renamed' WHERE idGroup = 1"));
+  EXPECT_EQ(0, m_db.Differences());
+
+  ASSERT_TRUE(m_db.ExecuteQuery("DELETE FROM item WHERE idGroup = 2"));
+  EXPECT_EQ(0, m_db.Differences());
+  EXPECT_EQ(m_db.GetSingleValueInt("SELECT COUNT(1) FROM item"), m_db.Rows());
+
+  EXPECT_TRUE(m_db.CheckMaterializedViews());
+  EXPECT_EQ(0, m_db.Differences());
+}
+
+TEST_F(TestMaterializedView, CheckMaterializedViews)
+{
+  for (int i = 1; i <= 3; i++)
+  {
+    ASSERT_TRUE(m_db.ExecuteQuery("INSERT INTO item (idItem, idGroup, strTitle) VALUES (" +
+                                  std::to_string(i) + ", 0, 'item " + std::to_string(i) + "')"));
+  }
+
+  // a missing row is found by counting the rows
+  ASSERT_TRUE(m_db.ExecuteQuery("DELETE FROM item_view_data WHERE idItem = 1"));
+  EXPECT_TRUE(m_db.CheckMaterializedViews());
+  EXPECT_EQ(3, m_db.Rows());
+  EXPECT_EQ(0, m_db.Differences());
+
+  // a stale row is only found when comparing the rows
+  ASSERT_TRUE(m_db.ExecuteQuery("UPDATE item_view_data SET strTitle = 'stale' WHERE idItem = 2"));
+  EXPECT_TRUE(m_db.CheckMaterializedViews());
+  EXPECT_NE(0, m_db.Differences());
+  EXPECT_TRUE(m_db.CheckMaterializedViews(false, true));
+  EXPECT_EQ(0, m_db.Differences());
+
+  // rebuilding doesn't need to check anything
+  ASSERT_TRUE(m_db.ExecuteQuery("UPDATE item_view_data SET strTitle = 'stale' WHERE idItem = 3"));
+  EXPECT_TRUE(m_db.CheckMaterializedViews(true));
+  EXPECT_EQ(0, m_db.Differences());
+}
+
+namespace
+{
+
+class CReaderPoolDatabase : public CDatabase
+{
+public:
+  bool Create()
+  {
+    DatabaseSettings settings;
+    settings.type = "sqlite3";
+    settings.host = CSpecialProtocol::TranslatePath("special://temp/");
+    return Connect(GetBaseDBName(), settings, true);
+  }
+
+  dbiplus::SqliteDatabase* GetSqlite()
+  {
+    return static_cast<dbiplus::SqliteDatabase*>(m_pDB.get());
+  }
+
+  int Rows() { return GetSingleValueInt("SELECT COUNT(1) FROM item"); }
+
+  // temporary tables only exist on the main connection, the readers don't see them
+  bool QueriesMainConnection()
+  {
+    return GetSingleValueInt("SELECT COUNT(1) FROM sqlite_temp_master WHERE name = 'marker'") == 1;
+  }
+
+protected:
+  void CreateTables() override
+  {
+    m_pDS->exec("CREATE TABLE item (idItem INTEGER PRIMARY KEY, strTitle TEXT)");
+  }
+
+  void CreateAnalytics() override {}
+
+  int GetSchemaVersion() const override { return 1; }
+  const char* GetBaseDBName() const override { return "TestReaderPool"; }
+};
+
+class TestReaderPool : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    ASSERT_TRUE(m_db.Create());
+    sqlite3* reader = m_db.GetSqlite()->acquireReader();
+    if (!reader)
+      GTEST_SKIP() << "write ahead logging isn't supported";
+    m_db.GetSqlite()->releaseReader(reader);
+
+    ASSERT_TRUE(m_db.ExecuteQuery("CREATE TEMP TABLE marker (id INTEGER)"));
+  }
+
+  void TearDown() override
+  {
+    m_db.Close();
+    XFILE::CFile::Delete("special://temp/TestReaderPool.db");
+  }
+
+  CReaderPoolDatabase m_db;
+};
+
+} // namespace
+
+TEST_F(TestReaderPool, QueriesUseReaders)
+{
+  EXPECT_FALSE(m_db.QueriesMainConnection());
+  EXPECT_EQ(0, m_db.Rows());
+}
+
+TEST_F(TestReaderPool, QueriesInTransaction)
+{
+  m_db.BeginTransaction();
+  EXPECT_EQ(nullptr, m_db.GetSqlite()->acquireReader());
+  EXPECT_TRUE(m_db.QueriesMainConnection());
+
+  // uncommitted changes are only seen by the main connection
+  ASSERT_TRUE(m_db.ExecuteQuery("INSERT INTO item (idItem, strTitle) VALUES (1, 'first')"));
+  EXPECT_EQ(1, m_db.Rows());
+  m_db.RollbackTransaction();
+
+  EXPECT_FALSE(m_db.QueriesMainConnection());
+  EXPECT_EQ(0, m_db.Rows());
+}
+
+TEST_F(TestReaderPool, ReadersSeeCommittedWrites)
+{
+  // the pooled reader has already read the table before the writes
+  EXPECT_EQ(0, m_db.Rows());
+
+  ASSERT_TRUE(m_db.ExecuteQuery("INSERT INTO item (idItem, strTitle) VALUES (1, 'first')"));
+  EXPECT_EQ(1, m_db.Rows());
+
+  m_db.BeginTransaction();
+  ASSERT_TRUE(m_db.ExecuteQuery("INSERT INTO item (idItem, strTitle) VALUES (2, 'second')"));
+  ASSERT_TRUE(m_db.ExecuteQuery("INSERT INTO item (idItem, strTitle) VALUES (3, 'third')"));
+  ASSERT_TRUE(m_db.CommitTransaction());
+  EXPECT_FALSE(m_db.QueriesMainConnection());
+  EXPECT_EQ(3, m_db.Rows());
+
+  // a second connection to the same file shares the readers and sees the writes as well
+  CReaderPoolDatabase other;
+  ASSERT_TRUE(other.Create());
+  EXPECT_EQ(3, other.Rows());
+  ASSERT_TRUE(other.ExecuteQuery("DELETE FROM item WHERE idItem = 1"));
+  EXPECT_EQ(2, m_db.Rows());
+  other.Close();
+}
+
+TEST_F(TestReaderPool, FallbackToMainConnection)
+{
+  // the readers can't prepare a query of a temporary table, it runs on the main connection
+  ASSERT_TRUE(m_db.ExecuteQuery("INSERT INTO marker (id) VALUES (1)"));
+  ASSERT_TRUE(m_db.ExecuteQuery("INSERT INTO marker (id) VALUES (2)"));
+  EXPECT_EQ(2, m_db.GetSingleValueInt("SELECT COUNT(1) FROM marker"));
+
+  // the reader is returned to the pool and used by the next query
+  EXPECT_FALSE(m_db.QueriesMainConnection());
+  EXPECT_EQ(0, m_db.Rows());
+}
+
+namespace
+{
+
+class CFullTextDatabase : public CDatabase
+{
+public:
+  bool Create(const std::string& name = "TestFullTextIndex")
+  {
+    DatabaseSettings settings;
+    settings.type = "sqlite3";
+    settings.host = CSpecialProtocol::TranslatePath("special://temp/");
+    return Connect(name, settings, true);
+  }
+
+  bool HasObject(const std::string& type, const std::string& name)
+  {
+    return GetSingleValueInt("SELECT COUNT(1) FROM sqlite_master WHERE type = '" + type +
+                             "' AND name = '" + name + "'") == 1;
+  }
+
+  // number of rows found by the full-text condition, -1 if the index can't be used
+  int Matches(const std::string& text)
+  {
+    const std::string condition = GetFullTextCondition("item", "item.idItem", text);
+    if (condition.empty())
+      return -1;
+    return GetSingleValueInt("SELECT COUNT(1) FROM item WHERE " + condition);
+  }
+
+protected:
+  void CreateTables() override
+  {
+    m_pDS->exec("CREATE TABLE item (idItem INTEGER PRIMARY KEY, strTitle TEXT, strArtist TEXT)");
+  }
+
+  void CreateAnalytics() override
+  {
+    CreateFullTextIndex("item", "idItem", {"strTitle", "strArtist"});
+  }
+
+  int GetSchemaVersion() const override { return 1; }
+  const char* GetBaseDBName() const override { return "TestFullTextIndex"; }
+};
+
+class TestFullTextIndex : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    ASSERT_TRUE(m_db.Create());
+    if (!m_db.HasObject("table", "item_fts"))
+      GTEST_SKIP() << "SQLite is built without FTS5";
+  }
+
+  void TearDown() override
+  {
+    m_db.Close();
+    XFILE::CFile::Delete("special://temp/TestFullTextIndex.db");
+    XFILE::CFile::Delete("special://temp/TestFullTextIndexCopy.db");
+  }
+
+  void Insert(int id, const std::string& title, const std::string& artist)
+  {
+    ASSERT_TRUE(m_db.ExecuteQuery(m_db.PrepareSQL(
+        "INSERT INTO item (idItem, strTitle, strArtist) VALUES (%i, '%s', '%s')", id,
+        title.c_str(), artist.c_str())));
+  }
+
+  CFullTextDatabase m_db;
+};
+
+} // namespace
+
+TEST_F(TestFullTextIndex, CreateFullTextIndex)
+{
+  EXPECT_TRUE(m_db.HasObject("trigger", "tgr_item_fts_insert"));
+  EXPECT_TRUE(m_db.HasObject("trigger", "tgr_item_fts_delete"));
+  EXPECT_TRUE(m_db.HasObject("trigger", "tgr_item_fts_update"));
+  EXPECT_EQ(0, m_db.Matches("anything"));
+}
+
+TEST_F(TestFullTextIndex, Triggers)
+{
+  Insert(1, "Hello World", "First Artist");
+  Insert(2, "Goodbye", "Second Artist");
+  EXPECT_EQ(1, m_db.Matches("llo wor"));
+  EXPECT_EQ(2, m_db.Matches("artist"));
+
+  ASSERT_TRUE(m_db.ExecuteQuery("UPDATE item SET strTitle = 'Hello Again' WHERE idItem = 2"));
+  EXPECT_EQ(2, m_db.Matches("hello"));
+  EXPECT_EQ(0, m_db.Matches("goodbye"));
+
+  ASSERT_TRUE(m_db.ExecuteQuery("DELETE FROM item WHERE idItem = 1"));
+  EXPECT_EQ(1, m_db.Matches("hello"));
+  EXPECT_EQ(1, m_db.Matches("artist"));
+}
+
+TEST_F(TestFullTextIndex, GetFullTextCondition)
+{
+  Insert(1, "say \"hi\" there", "it's me");
+  Insert(2, "Ärger über Öl", "");
+
+  // LIKE wildcards and texts shorter than a trigram can't be searched for
+  EXPECT_EQ(-1, m_db.Matches("%hi"));
+  EXPECT_EQ(-1, m_db.Matches("hi_"));
+  EXPECT_EQ(-1, m_db.Matches("hi"));
+  EXPECT_EQ(-1, m_db.Matches("Öl"));
+  EXPECT_EQ(1, m_db.Matches(" Öl"));
+
+  // quotes are escaped
+  EXPECT_EQ(1, m_db.Matches("\"hi\""));
+  EXPECT_EQ(1, m_db.Matches("it's"));
+
+  // tables without an index
+  EXPECT_TRUE(m_db.GetFullTextCondition("other", "other.idOther", "text").empty());
+}
+
+TEST_F(TestFullTextIndex, UnusableIndex)
+{
+  Insert(1, "Hello World", "");
+  ASSERT_TRUE(m_db.ExecuteQuery("DROP TABLE item_fts_data"));
+  m_db.Close();
+
+  // the index is only probed the first time a file is opened
+  ASSERT_TRUE(m_db.Create());
+  EXPECT_FALSE(m_db.GetFullTextCondition("item", "item.idItem", "hello").empty());
+  m_db.Close();
+  ASSERT_TRUE(XFILE::CFile::Copy("special://temp/TestFullTextIndex.db",
+                                 "special://temp/TestFullTextIndexCopy.db"));
+
+  // a file whose index can't be used (e.g. created by a build with FTS5) has its triggers
+  // dropped, so changes of the table don't fail
+  CFullTextDatabase copy;
+  ASSERT_TRUE(copy.Create("TestFullTextIndexCopy"));
+  EXPECT_FALSE(copy.HasObject("trigger", "tgr_item_fts_insert"));
+  EXPECT_FALSE(copy.HasObject("trigger", "tgr_item_fts_delete"));
+  EXPECT_FALSE(copy.HasObject("trigger", "tgr_item_fts_update"));
+  EXPECT_EQ(-1, copy.Matches("hello"));
+  EXPECT_TRUE(copy.ExecuteQuery("INSERT INTO item (idItem, strTitle) VALUES (2, 'Hello')"));
+  EXPECT_TRUE(copy.ExecuteQuery("UPDATE item SET strTitle = 'Bye' WHERE idItem = 1"));
+  EXPECT_TRUE(copy.ExecuteQuery("DELETE FROM item WHERE idItem = 2"));
+  copy.Close();
+}
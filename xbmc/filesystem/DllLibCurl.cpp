@@ -97,6 +97,16 @@ CURLMcode DllLibCurl::multi_cleanup(CURLM* handle)
   return curl_multi_cleanup(handle);
 }
 
+CURLSH* DllLibCurl::share_init()
+{
+  return curl_share_init();
+}
+
+CURLSHcode DllLibCurl::share_cleanup(CURLSH* share)
+{
+  return curl_share_cleanup(share);
+}
+
 curl_slist* DllLibCurl::slist_append(curl_slist* list, const char* to_append)
 {
   return curl_slist_append(list, to_append);
@@ -118,15 +128,45 @@ DllLibCurlGlobal::DllLibCurlGlobal()
   if (curl_global_init(CURL_GLOBAL_ALL))
   {
     CLog::Log(LOGERROR, "Error initializing libcurl");
+    return;
+  }
+
+  // connections themselves can't be shared safely between threads, see KNOWN_BUGS of libcurl
+  m_share = share_init();
+  if (m_share)
+  {
+    share_setopt(m_share, CURLSHOPT_LOCKFUNC, ShareLock);
+    share_setopt(m_share, CURLSHOPT_UNLOCKFUNC, ShareUnlock);
+    share_setopt(m_share, CURLSHOPT_USERDATA, this);
+    share_setopt(m_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+    share_setopt(m_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
   }
 }
 
 DllLibCurlGlobal::~DllLibCurlGlobal()
 {
+  if (m_share)
+    share_cleanup(m_share);
+
   // close libcurl
   curl_global_cleanup();
 }
 
+void DllLibCurlGlobal::ShareLock(CURL_HANDLE* handle,
+                                 curl_lock_data data,
+                                 curl_lock_access access,
+                                 void* userptr)
+{
+  if (data >= 0 && data < CURL_LOCK_DATA_LAST)
+    static_cast<DllLibCurlGlobal*>(userptr)->m_shareLocks[data].lock();
+}
+
+void DllLibCurlGlobal::ShareUnlock(CURL_HANDLE* handle, curl_lock_data data, void* userptr)
+{
+  if (data >= 0 && data < CURL_LOCK_DATA_LAST)
+    static_cast<DllLibCurlGlobal*>(userptr)->m_shareLocks[data].unlock();
+}
+
 void DllLibCurlGlobal::CheckIdle()
 {
   std::unique_lock<CCriticalSection> lock(m_critSection);
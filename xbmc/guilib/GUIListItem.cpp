@@ -39,7 +39,6 @@ CGUIListItem::CGUIListItem(const std::string& strLabel):
   m_strLabel(strLabel)
 {
   m_bIsFolder = false;
-  SetSortLabel(strLabel);
   m_bSelected = false;
   m_overlayIcon = ICON_OVERLAY_NONE;
   m_currentItem = 1;
@@ -55,8 +54,6 @@ void CGUIListItem::SetLabel(const std::string& strLabel)
   if (m_strLabel == strLabel)
     return;
   m_strLabel = strLabel;
-  if (m_sortLabel.empty())
-    SetSortLabel(strLabel);
   SetInvalid();
 }
 
@@ -90,9 +87,16 @@ void CGUIListItem::SetSortLabel(const std::wstring &label)
   m_sortLabel = label;
 }
 
-const std::wstring& CGUIListItem::GetSortLabel() const
+std::wstring CGUIListItem::GetSortLabel() const
 {
-  return m_sortLabel;
+  if (!m_sortLabel.empty() || m_strLabel.empty())
+    return m_sortLabel;
+
+  // converted from the label on each call instead of being stored, most items never need it.
+  // Const items are shared between threads, so this must not write to the item.
+  std::wstring sortLabel;
+  g_charsetConverter.utf8ToW(m_strLabel, sortLabel, false);
+  return sortLabel;
 }
 
 void CGUIListItem::SetArt(const std::string &type, const std::string &url)
@@ -223,7 +227,7 @@ void CGUIListItem::Archive(CArchive &ar)
     ar << m_bIsFolder;
     ar << m_strLabel;
     ar << m_strLabel2;
-    ar << m_sortLabel;
+    ar << GetSortLabel();
     ar << m_bSelected;
     ar << m_overlayIcon;
     ar << (int)m_mapProperties.size();
@@ -291,7 +295,7 @@ void CGUIListItem::Serialize(CVariant &value)
   value["isFolder"] = m_bIsFolder;
   value["strLabel"] = m_strLabel;
   value["strLabel2"] = m_strLabel2;
-  value["sortLabel"] = m_sortLabel;
+  value["sortLabel"] = GetSortLabel();
   value["selected"] = m_bSelected;
 
   for (const auto& it : m_mapProperties)
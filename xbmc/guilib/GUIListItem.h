@@ -117,7 +117,7 @@ public:
 
   void SetSortLabel(const std::string &label);
   void SetSortLabel(const std::wstring &label);
-  const std::wstring &GetSortLabel() const;
+  std::wstring GetSortLabel() const;
 
   void Select(bool bOnOff);
   bool IsSelected() const;
@@ -192,7 +192,7 @@ protected:
   typedef std::map<std::string, CVariant, icompare> PropertyMap;
   PropertyMap m_mapProperties;
 private:
-  std::wstring m_sortLabel;    // text for sorting. Need to be UTF16 for proper sorting
+  std::wstring m_sortLabel;    // text for sorting. Need to be UTF16 for proper sorting. Empty if not set
   std::string m_strLabel;      // text of column1
 
   ArtMap m_art;
@@ -174,8 +174,9 @@ bool CInputManager::ProcessEventServer(int windowId, float frameTime)
   if (!es || !es->Running() || es->GetNumberOfClients() == 0)
     return false;
 
-  // process any queued up actions
-  if (es->ExecuteNextAction())
+  // process the queued up actions, a slow frame must not delay each of them by another
+  // frame. Limited so that a client flooding us can't stall the frame either.
+  for (int i = 0; i < 16 && es->ExecuteNextAction(); i++)
   {
     // reset idle timers
     auto& components = CServiceBroker::GetAppComponents();
@@ -183,6 +184,12 @@ bool CInputManager::ProcessEventServer(int windowId, float frameTime)
     appPower->ResetSystemIdleTimer();
     appPower->ResetScreenSaver();
     appPower->WakeUpScreenSaverAndDPMS();
+
+    // es->ExecuteNextAction() invalidates the ref to the CEventServer instance
+    // when the action exits XBMC
+    es = CEventServer::GetInstance();
+    if (!es || !es->Running() || es->GetNumberOfClients() == 0)
+      return false;
   }
 
   // now handle any buttons or axis
@@ -190,12 +197,6 @@ bool CInputManager::ProcessEventServer(int windowId, float frameTime)
   bool isAxis = false;
   float fAmount = 0.0;
   bool isJoystick = false;
-
-  // es->ExecuteNextAction() invalidates the ref to the CEventServer instance
-  // when the action exits XBMC
-  es = CEventServer::GetInstance();
-  if (!es || !es->Running() || es->GetNumberOfClients() == 0)
-    return false;
   unsigned int wKeyID = es->GetButtonCode(strMapName, isAxis, fAmount, isJoystick);
 
   if (wKeyID)
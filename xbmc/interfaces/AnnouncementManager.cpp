@@ -19,8 +19,10 @@
 #include "utils/log.h"
 #include "video/VideoDatabase.h"
 
+#include <iterator>
 #include <mutex>
 #include <stdio.h>
+#include <utility>
 
 #define LOOKUP_PROPERTY "database-lookup"
 
@@ -136,14 +138,45 @@ void CAnnouncementManager::Announce(AnnouncementFlag flag,
 
   if (item != nullptr)
     announcement.item = CFileItemPtr(new CFileItem(*item));
+  else
+    announcement.itemKey = GetItemKey(flag, data);
 
   {
     std::unique_lock<CCriticalSection> lock(m_queueCritSection);
-    m_announcementQueue.push_back(announcement);
+    if (!announcement.itemKey.empty())
+    {
+      // scans and batch updates repeat the same notification for an item, clients only need the
+      // one that is still waiting to be delivered. Anything in between (e.g. a removal) has to
+      // be followed by the repeated notification, so only the latest one is compared.
+      auto queued = m_queuedItems.find(announcement.itemKey);
+      if (queued != m_queuedItems.end() && queued->second->message == message &&
+          queued->second->sender == sender && queued->second->data == data)
+      {
+        CLog::Log(LOGDEBUG, LOGANNOUNCE,
+                  "CAnnouncementManager - Dropping duplicate announcement: {} from {}", message,
+                  sender);
+        return;
+      }
+
+      m_announcementQueue.push_back(std::move(announcement));
+      m_queuedItems[m_announcementQueue.back().itemKey] = std::prev(m_announcementQueue.end());
+    }
+    else
+      m_announcementQueue.push_back(std::move(announcement));
   }
   m_queueEvent.Set();
 }
 
+std::string CAnnouncementManager::GetItemKey(AnnouncementFlag flag, const CVariant& data)
+{
+  if ((flag != VideoLibrary && flag != AudioLibrary) || !data.isObject() ||
+      !data.isMember("type") || !data.isMember("id"))
+    return "";
+
+  return StringUtils::Format("{}|{}|{}", static_cast<int>(flag), data["type"].asString(),
+                             data["id"].asInteger());
+}
+
 void CAnnouncementManager::DoAnnounce(AnnouncementFlag flag,
                                       const std::string& sender,
                                       const std::string& message,
@@ -325,7 +358,13 @@ void CAnnouncementManager::Process()
     std::unique_lock<CCriticalSection> lock(m_queueCritSection);
     if (!m_announcementQueue.empty())
     {
-      auto announcement = m_announcementQueue.front();
+      auto announcement = std::move(m_announcementQueue.front());
+      if (!announcement.itemKey.empty())
+      {
+        auto queued = m_queuedItems.find(announcement.itemKey);
+        if (queued != m_queuedItems.end() && queued->second == m_announcementQueue.begin())
+          m_queuedItems.erase(queued);
+      }
       m_announcementQueue.pop_front();
       {
         CSingleExit ex(m_queueCritSection);
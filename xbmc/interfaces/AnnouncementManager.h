@@ -15,6 +15,7 @@
 #include "utils/Variant.h"
 
 #include <list>
+#include <map>
 #include <memory>
 #include <vector>
 
@@ -80,12 +81,18 @@ namespace ANNOUNCEMENT
       std::string message;
       std::shared_ptr<CFileItem> item;
       CVariant data;
+      std::string itemKey; ///< identifies library item notifications, see GetItemKey()
     };
     std::list<CAnnounceData> m_announcementQueue;
+    // latest queued notification for every library item, an identical one following it is dropped
+    std::map<std::string, std::list<CAnnounceData>::iterator> m_queuedItems;
     CEvent m_queueEvent;
 
   private:
     CAnnouncementManager(const CAnnouncementManager&) = delete;
+
+    static std::string GetItemKey(AnnouncementFlag flag, const CVariant& data);
+
     CAnnouncementManager const& operator=(CAnnouncementManager const&) = delete;
 
     CCriticalSection m_announcersCritSection;
@@ -18,6 +18,7 @@
 #include "guilib/LocalizeStrings.h"
 #include "messaging/helpers/DialogHelper.h"
 #include "messaging/helpers/DialogOKHelper.h"
+#include "music/MusicDatabase.h"
 #include "music/MusicLibraryQueue.h"
 #include "music/infoscanner/MusicInfoScanner.h"
 #include "settings/LibExportSettings.h"
@@ -31,6 +32,42 @@
 
 using namespace KODI::MESSAGING;
 
+/*! \brief Check the cached library views against their definition.
+ *  \param params The parameters.
+ *  \details params[0] = "video" or "music".
+ *           params[1] = "rebuild" to rebuild the views unconditionally (optional).
+ */
+static int CheckLibraryViews(const std::vector<std::string>& params)
+{
+  const bool rebuild = params.size() > 1 && StringUtils::EqualsNoCase(params[1], "rebuild");
+  if (StringUtils::EqualsNoCase(params[0], "video"))
+  {
+    if (CVideoLibraryQueue::GetInstance().IsRunning())
+      return -1;
+
+    CVideoDatabase db;
+    if (db.Open())
+    {
+      db.CheckMaterializedViews(rebuild, true);
+      db.Close();
+    }
+  }
+  else if (StringUtils::EqualsNoCase(params[0], "music"))
+  {
+    if (CMusicLibraryQueue::GetInstance().IsRunning())
+      return -1;
+
+    CMusicDatabase db;
+    if (db.Open())
+    {
+      db.CheckMaterializedViews(rebuild, true);
+      db.Close();
+    }
+  }
+
+  return 0;
+}
+
 /*! \brief Clean a library.
  *  \param params The parameters.
  *  \details params[0] = "video" or "music".
@@ -356,6 +393,13 @@ static int SearchVideoLibrary(const std::vector<std::string>& params)
 ///     Function,
 ///     Description }
 ///   \table_row2_l{
+///     <b>`checklibraryviews(type [\, rebuild])`</b>
+///     ,
+///     Check the cached library views against the library tables and rebuild them if they differ
+///     @param[in] type                  "video" or "music".
+///     @param[in] rebuild               Add "rebuild" to rebuild the views unconditionally (optional).
+///   }
+///   \table_row2_l{
 ///     <b>`cleanlibrary(type)`</b>
 ///     ,
 ///      Clean the video/music library
@@ -407,6 +451,7 @@ static int SearchVideoLibrary(const std::vector<std::string>& params)
 CBuiltins::CommandMap CLibraryBuiltins::GetOperations() const
 {
   return {
+          {"checklibraryviews",   {"Check the cached video/music library views", 1, CheckLibraryViews}},
           {"cleanlibrary",        {"Clean the video/music library", 1, CleanLibrary}},
           {"exportlibrary",       {"Export the video/music library", 1, ExportLibrary}},
           {"exportlibrary2",      {"Export the video/music library", 1, ExportLibrary2}},
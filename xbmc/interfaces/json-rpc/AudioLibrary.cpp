@@ -393,11 +393,29 @@ JSONRPC_STATUS CAudioLibrary::GetSongs(const std::string &method, ITransportLaye
     musicUrl.AddOption("xsp", xsp);
   }
 
+  int lastId, position;
+  if (!ParseCursor(parameterObject, lastId, position))
+    return InvalidParams;
+
+  CVariant params = parameterObject;
+  if (position > 0)
+    ResumeLimits(params, position);
+
   SortDescription sorting;
-  ParseLimits(parameterObject, sorting.limitStart, sorting.limitEnd);
+  ParseLimits(params, sorting.limitStart, sorting.limitEnd);
   if (!ParseSorting(parameterObject, sorting.sortBy, sorting.sortOrder, sorting.sortAttributes))
     return InvalidParams;
 
+  // Unsorted songs are returned in id order, so a resumed request can continue
+  // after the last song id instead of skipping over all previous pages
+  int afterSongId = -1;
+  if (sorting.sortBy == SortByNone && lastId >= 0)
+  {
+    afterSongId = lastId;
+    sorting.limitStart -= position;
+    sorting.limitEnd -= position;
+  }
+
   int total;
   std::set<std::string> fields;
   if (parameterObject.isMember("properties") && parameterObject["properties"].isArray())
@@ -407,7 +425,8 @@ JSONRPC_STATUS CAudioLibrary::GetSongs(const std::string &method, ITransportLaye
       fields.insert(field->asString());
   }
 
-  if (!musicdatabase.GetSongsByWhereJSON(fields, musicUrl.ToString(), result, total, sorting))
+  if (!musicdatabase.GetSongsByWhereJSON(fields, musicUrl.ToString(), result, total, sorting,
+                                         afterSongId))
     return InternalError;
 
   if (!result.isNull())
@@ -477,7 +496,13 @@ JSONRPC_STATUS CAudioLibrary::GetSongs(const std::string &method, ITransportLaye
   }
 
   int start, end;
-  HandleLimits(parameterObject, result, total, start, end);
+  HandleLimits(params, result, total, start, end);
+  if (sorting.sortBy != SortByRandom && result.isMember("songs") && !result["songs"].empty())
+  {
+    const CVariant& songs = result["songs"];
+    SetCursor(result, sorting.sortBy == SortByNone ? songs[songs.size() - 1]["songid"].asInteger32()
+                                                   : -1);
+  }
 
   return OK;
 }
@@ -10,12 +10,14 @@
 
 #include "JSONRPCUtils.h"
 #include "playlists/SmartPlayList.h"
+#include "utils/Base64.h"
 #include "utils/JSONVariantParser.h"
 #include "utils/JSONVariantWriter.h"
 #include "utils/SortUtils.h"
 #include "utils/StringUtils.h"
 #include "utils/Variant.h"
 
+#include <limits>
 #include <stdlib.h>
 #include <string.h>
 #include <vector>
@@ -110,6 +112,72 @@ namespace JSONRPC
       limitEnd = (int)parameterObject["limits"]["end"].asInteger();
     }
 
+    /*!
+     \brief Parses the resume cursor of a paged list request
+     \param parameterObject Object containing the "limits" of the request
+     \param lastId Database id of the last item of the previous page or -1
+     \param position Number of items preceding the requested page
+     \return False if the cursor is invalid otherwise true
+
+     The cursor is opaque to clients, it is returned in the limits of
+     the previous page by SetCursor(). Without a cursor lastId is -1 and
+     position is 0.
+     */
+    static bool ParseCursor(const CVariant &parameterObject, int &lastId, int &position)
+    {
+      lastId = -1;
+      position = 0;
+
+      const std::string cursor = parameterObject["limits"]["cursor"].asString();
+      if (cursor.empty())
+        return true;
+
+      std::vector<std::string> parts = StringUtils::Split(Base64::Decode(cursor), ':');
+      if (parts.size() != 2 || !StringUtils::IsInteger(parts[0]) ||
+          !StringUtils::IsNaturalNumber(parts[1]))
+        return false;
+
+      lastId = (int)strtol(parts[0].c_str(), NULL, 10);
+      position = (int)strtol(parts[1].c_str(), NULL, 10);
+      return true;
+    }
+
+    /*!
+     \brief Moves the limits of a request behind the position of its resume cursor
+     \param parameterObject Request parameters whose "limits" are adjusted
+     \param position Number of items preceding the requested page, see ParseCursor()
+
+     "start" and "end" of a resumed request only define the page size.
+     */
+    static void ResumeLimits(CVariant &parameterObject, int position)
+    {
+      CVariant &limits = parameterObject["limits"];
+      const int start = (int)limits["start"].asInteger();
+      const int end = (int)limits["end"].asInteger();
+
+      limits["start"] = position;
+      if (end > start)
+        limits["end"] = position + end - start;
+      else
+        limits["end"] = std::numeric_limits<int>::max();
+    }
+
+    /*!
+     \brief Adds the cursor resuming after the returned page to its limits
+     \param result Result containing the "limits" set by HandleLimits()
+     \param lastId Database id of the last returned item if the items are
+     ordered by it, otherwise -1
+     */
+    static void SetCursor(CVariant &result, int lastId)
+    {
+      CVariant &limits = result["limits"];
+      const int64_t end = limits["end"].asInteger();
+      if (end >= limits["total"].asInteger())
+        return;
+
+      limits["cursor"] = Base64::Encode(StringUtils::Format("{}:{}", lastId, end));
+    }
+
     /*!
      \brief Checks if the given object contains a parameter
      \param parameterObject Object to check for a parameter
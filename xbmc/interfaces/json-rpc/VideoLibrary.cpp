@@ -30,8 +30,16 @@ JSONRPC_STATUS CVideoLibrary::GetMovies(const std::string &method, ITransportLay
   if (!videodatabase.Open())
     return InternalError;
 
+  int lastId, position;
+  if (!ParseCursor(parameterObject, lastId, position))
+    return InvalidParams;
+
+  CVariant params = parameterObject;
+  if (position > 0)
+    ResumeLimits(params, position);
+
   SortDescription sorting;
-  ParseLimits(parameterObject, sorting.limitStart, sorting.limitEnd);
+  ParseLimits(params, sorting.limitStart, sorting.limitEnd);
   if (!ParseSorting(parameterObject, sorting.sortBy, sorting.sortOrder, sorting.sortAttributes))
     return InvalidParams;
 
@@ -78,7 +86,11 @@ JSONRPC_STATUS CVideoLibrary::GetMovies(const std::string &method, ITransportLay
   if (!videodatabase.GetMoviesNav(videoUrl.ToString(), items, genreID, year, -1, -1, -1, -1, setID, -1, sorting, RequiresAdditionalDetails(MediaTypeMovie, parameterObject)))
     return InvalidParams;
 
-  return HandleItems("movieid", "movies", items, parameterObject, result, false);
+  JSONRPC_STATUS ret = HandleItems("movieid", "movies", items, params, result, false);
+  if (ret == OK && sorting.sortBy != SortByRandom && !items.IsEmpty())
+    SetCursor(result, -1);
+
+  return ret;
 }
 
 JSONRPC_STATUS CVideoLibrary::GetMovieDetails(const std::string &method, ITransportLayer *transport, IClient *client, const CVariant &parameterObject, CVariant &result)
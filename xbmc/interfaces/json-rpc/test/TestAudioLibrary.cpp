@@ -0,0 +1,185 @@
+/*
+ *  Copyright (C) 2023 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "DatabaseManager.h"
+#include "ServiceBroker.h"
+#include "interfaces/json-rpc/AudioLibrary.h"
+#include "music/Album.h"
+#include "music/MusicDatabase.h"
+#include "music/Song.h"
+#include "utils/StringUtils.h"
+#include "utils/Variant.h"
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace JSONRPC;
+
+namespace
+{
+constexpr int SONGS = 10;
+constexpr int PAGE_SIZE = 4;
+
+CVariant GetRequest(int albumId, const std::string& sortMethod, const std::string& sortOrder)
+{
+  CVariant request;
+  request["filter"]["albumid"] = albumId;
+  request["properties"].push_back("title");
+  request["limits"]["start"] = 0;
+  request["limits"]["end"] = PAGE_SIZE;
+  request["sort"]["method"] = sortMethod;
+  request["sort"]["order"] = sortOrder;
+  return request;
+}
+
+std::vector<int> GetSongIds(const CVariant& result)
+{
+  std::vector<int> ids;
+  for (auto song = result["songs"].begin_array(); song != result["songs"].end_array(); ++song)
+    ids.push_back((*song)["songid"].asInteger32());
+  return ids;
+}
+
+// fetches the next page with the cursor of the previous one, returns false on the last page
+bool GetNextPage(CVariant& request, const CVariant& result)
+{
+  if (!result["limits"].isMember("cursor"))
+    return false;
+  request["limits"]["cursor"] = result["limits"]["cursor"];
+  return true;
+}
+} // unnamed namespace
+
+class TestAudioLibrary : public testing::Test
+{
+protected:
+  static void SetUpTestSuite()
+  {
+    // the test environment doesn't set up the databases, they are created in the temp profile
+    CServiceBroker::GetDatabaseManager().Initialize();
+  }
+
+  void SetUp() override
+  {
+    ASSERT_TRUE(m_musicdb.Open());
+
+    const std::string name = testing::UnitTest::GetInstance()->current_test_info()->name();
+    CAlbum album;
+    album.strAlbum = StringUtils::Format("Cursor {}", name);
+    album.artistCredits.emplace_back("Cursor Artist");
+    album.strPath = StringUtils::Format("/storage/music/Cursor {}/", name);
+    for (int track = 1; track <= SONGS; track++)
+    {
+      CSong song;
+      // titles in reverse track order, so that sorting by title doesn't give the id order
+      song.strTitle = StringUtils::Format("Title {:02}", SONGS + 1 - track);
+      song.strFileName = StringUtils::Format("{}{:02}.flac", album.strPath, track);
+      song.artistCredits = album.artistCredits;
+      song.iTrack = track;
+      album.songs.push_back(song);
+    }
+    ASSERT_TRUE(m_musicdb.AddAlbum(album, -1));
+
+    m_albumId = album.idAlbum;
+    for (const CSong& song : album.songs)
+      m_songIds.push_back(song.idSong);
+  }
+
+  void TearDown() override { m_musicdb.Close(); }
+
+  CMusicDatabase m_musicdb;
+  int m_albumId = -1;
+  std::vector<int> m_songIds;
+};
+
+TEST_F(TestAudioLibrary, GetSongsCursor)
+{
+  CVariant request = GetRequest(m_albumId, "none", "ascending");
+  CVariant result;
+  std::vector<int> ids;
+  do
+  {
+    result = CVariant();
+    ASSERT_EQ(OK, CAudioLibrary::GetSongs("AudioLibrary.GetSongs", nullptr, nullptr, request,
+                                          result));
+    EXPECT_EQ(SONGS, result["limits"]["total"].asInteger());
+    EXPECT_GE(PAGE_SIZE, static_cast<int>(result["songs"].size()));
+    for (int id : GetSongIds(result))
+      ids.push_back(id);
+  } while (GetNextPage(request, result));
+
+  EXPECT_EQ(m_songIds, ids);
+}
+
+TEST_F(TestAudioLibrary, GetSongsCursorWithSort)
+{
+  // all songs in one go
+  CVariant request = GetRequest(m_albumId, "title", "ascending");
+  request["limits"]["end"] = 0;
+  CVariant result;
+  ASSERT_EQ(OK, CAudioLibrary::GetSongs("AudioLibrary.GetSongs", nullptr, nullptr, request,
+                                        result));
+  const std::vector<int> sorted = GetSongIds(result);
+  ASSERT_EQ(SONGS, static_cast<int>(sorted.size()));
+  EXPECT_NE(m_songIds, sorted);
+
+  // the same songs page by page
+  request = GetRequest(m_albumId, "title", "ascending");
+  std::vector<int> ids;
+  do
+  {
+    result = CVariant();
+    ASSERT_EQ(OK, CAudioLibrary::GetSongs("AudioLibrary.GetSongs", nullptr, nullptr, request,
+                                          result));
+    for (int id : GetSongIds(result))
+      ids.push_back(id);
+  } while (GetNextPage(request, result));
+
+  EXPECT_EQ(sorted, ids);
+}
+
+TEST_F(TestAudioLibrary, GetSongsCursorAfterLibraryChange)
+{
+  CVariant request = GetRequest(m_albumId, "none", "ascending");
+  CVariant result;
+  ASSERT_EQ(OK, CAudioLibrary::GetSongs("AudioLibrary.GetSongs", nullptr, nullptr, request,
+                                        result));
+  EXPECT_EQ(std::vector<int>(m_songIds.begin(), m_songIds.begin() + PAGE_SIZE),
+            GetSongIds(result));
+  ASSERT_TRUE(GetNextPage(request, result));
+
+  // a song of the first page is removed before the second page is fetched, resuming by
+  // position would skip the first song of the second page
+  ASSERT_TRUE(m_musicdb.ExecuteQuery(
+      m_musicdb.PrepareSQL("DELETE FROM song WHERE idSong = %i", m_songIds[1])));
+
+  result = CVariant();
+  ASSERT_EQ(OK, CAudioLibrary::GetSongs("AudioLibrary.GetSongs", nullptr, nullptr, request,
+                                        result));
+  EXPECT_EQ(SONGS - 1, result["limits"]["total"].asInteger());
+  EXPECT_EQ(
+      std::vector<int>(m_songIds.begin() + PAGE_SIZE, m_songIds.begin() + 2 * PAGE_SIZE),
+      GetSongIds(result));
+
+  // the last page holds the remaining songs, as the total has shrunk
+  ASSERT_TRUE(GetNextPage(request, result));
+  result = CVariant();
+  ASSERT_EQ(OK, CAudioLibrary::GetSongs("AudioLibrary.GetSongs", nullptr, nullptr, request,
+                                        result));
+  EXPECT_EQ(std::vector<int>(m_songIds.begin() + 2 * PAGE_SIZE, m_songIds.end()),
+            GetSongIds(result));
+  EXPECT_FALSE(result["limits"].isMember("cursor"));
+
+  // an invalid cursor is rejected
+  request["limits"]["cursor"] = "not a cursor";
+  result = CVariant();
+  EXPECT_EQ(InvalidParams, CAudioLibrary::GetSongs("AudioLibrary.GetSongs", nullptr, nullptr,
+                                                   request, result));
+}
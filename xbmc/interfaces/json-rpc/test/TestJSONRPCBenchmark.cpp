@@ -0,0 +1,452 @@
+/*
+ *  Copyright (C) 2023 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+/*
+ * Load test of the JSON-RPC layer. A synthetic video and music library is generated in the
+ * test profile and a mix of requests is sent through CJSONRPC::MethodCall() from several
+ * threads, like a household with many remotes would. Throughput and latency percentiles are
+ * reported per method together with the cost of the schema validation alone.
+ *
+ * The benchmark is disabled by default, run it with
+ *
+ *   kodi-test --gtest_also_run_disabled_tests --gtest_filter=TestJSONRPCBenchmark.*
+ *
+ * and configure it with the environment variables
+ *
+ *   KODI_JSONRPC_BENCH_MOVIES    movies in the library (default 2000)
+ *   KODI_JSONRPC_BENCH_ALBUMS    albums in the library, with 12 songs each (default 300)
+ *   KODI_JSONRPC_BENCH_THREADS   concurrent clients (default 8)
+ *   KODI_JSONRPC_BENCH_REQUESTS  requests sent by each client (default 500)
+ *   KODI_JSONRPC_BENCH_MIX       weighted methods, e.g. "VideoLibrary.GetMovies:4,JSONRPC.Ping:1"
+ *                                (default: all methods with the same weight)
+ *   KODI_JSONRPC_BENCH_REPLAY    replay a recorded session instead of the mix, see below
+ *
+ * A recorded session is a file with one JSON-RPC request per line. A kodi.log written with
+ * debug logging and the JSON-RPC component logging enabled can be used as it is, the
+ * "JSONRPC: Incoming request:" lines are picked from it. Every client replays the requests in
+ * the recorded order without the pauses between them, each starting at a different point of
+ * the session, until it has sent KODI_JSONRPC_BENCH_REQUESTS requests. The session should
+ * refer to items of the generated library, e.g. movie ids up to KODI_JSONRPC_BENCH_MOVIES.
+ */
+
+#include "DatabaseManager.h"
+#include "ServiceBroker.h"
+#include "interfaces/json-rpc/IClient.h"
+#include "interfaces/json-rpc/ITransportLayer.h"
+#include "interfaces/json-rpc/JSONRPC.h"
+#include "music/Album.h"
+#include "music/MusicDatabase.h"
+#include "music/Song.h"
+#include "utils/JSONVariantParser.h"
+#include "utils/StringUtils.h"
+#include "utils/Variant.h"
+#include "video/VideoDatabase.h"
+#include "video/VideoInfoTag.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace JSONRPC;
+
+namespace
+{
+class CBenchmarkTransportLayer : public ITransportLayer
+{
+public:
+  bool PrepareDownload(const char* path, CVariant& details, std::string& protocol) override
+  {
+    return false;
+  }
+  bool Download(const char* path, CVariant& result) override { return false; }
+  int GetCapabilities() override { return Response; }
+};
+
+class CBenchmarkClient : public IClient
+{
+public:
+  int GetPermissionFlags() override { return OPERATION_PERMISSION_ALL; }
+  int GetAnnouncementFlags() override { return 0; }
+  bool SetAnnouncementFlags(int flags) override { return false; }
+};
+
+struct Request
+{
+  const char* method;
+  const char* params;
+};
+
+// requests typical for remote apps and home screen widgets
+const Request REQUESTS[] = {
+    {"JSONRPC.Ping", "{}"},
+    {"VideoLibrary.GetMovies",
+     R"({"properties":["title","year","genre","rating","file"],"limits":{"start":0,"end":50},)"
+     R"("sort":{"method":"title"}})"},
+    {"VideoLibrary.GetMovieDetails", R"({"movieid":1,"properties":["title","plot","genre","year"]})"},
+    {"AudioLibrary.GetAlbums",
+     R"({"properties":["title","artist","year","genre"],"limits":{"start":0,"end":50}})"},
+    {"AudioLibrary.GetSongs",
+     R"({"properties":["title","artist","album","duration","track"],"limits":{"start":0,"end":100}})"},
+    {"Files.GetDirectory",
+     R"({"directory":"videodb://movies/titles/","media":"video","properties":["title","year"],)"
+     R"("limits":{"start":0,"end":50}})"},
+};
+
+struct Config
+{
+  int movies;
+  int albums;
+  int threads;
+  int requests;
+  std::map<std::string, int> mix; // method -> weight
+  std::string replay; // recorded session, empty to send the mix
+};
+
+struct Payload
+{
+  std::string method;
+  std::string request;
+};
+
+int GetEnvInt(const char* name, int defaultValue)
+{
+  const char* value = std::getenv(name);
+  if (value == nullptr || *value == '\0')
+    return defaultValue;
+
+  return std::max(1, std::atoi(value));
+}
+
+Config GetConfig()
+{
+  Config config;
+  config.movies = GetEnvInt("KODI_JSONRPC_BENCH_MOVIES", 2000);
+  config.albums = GetEnvInt("KODI_JSONRPC_BENCH_ALBUMS", 300);
+  config.threads = GetEnvInt("KODI_JSONRPC_BENCH_THREADS", 8);
+  config.requests = GetEnvInt("KODI_JSONRPC_BENCH_REQUESTS", 500);
+
+  const char* replay = std::getenv("KODI_JSONRPC_BENCH_REPLAY");
+  if (replay != nullptr)
+    config.replay = replay;
+
+  const char* mix = std::getenv("KODI_JSONRPC_BENCH_MIX");
+  if (mix != nullptr)
+  {
+    for (const std::string& entry : StringUtils::Split(mix, ","))
+    {
+      std::vector<std::string> parts = StringUtils::Split(entry, ":");
+      if (parts.empty())
+        continue;
+      StringUtils::Trim(parts[0]);
+      config.mix[parts[0]] = parts.size() > 1 ? std::max(0, std::atoi(parts[1].c_str())) : 1;
+    }
+  }
+  else
+  {
+    for (const Request& request : REQUESTS)
+      config.mix[request.method] = 1;
+  }
+
+  return config;
+}
+
+void GenerateLibrary(int movies, int albums)
+{
+  static const std::vector<std::string> genres = {"Action", "Comedy", "Drama", "Documentary",
+                                                  "Horror", "Rock", "Jazz", "Classical"};
+
+  CVideoDatabase videodb;
+  ASSERT_TRUE(videodb.Open());
+  for (int i = 1; i <= movies; i++)
+  {
+    CVideoInfoTag movie;
+    movie.SetTitle(StringUtils::Format("Movie {}", i));
+    movie.SetYear(1950 + i % 70);
+    movie.SetGenre({genres[i % genres.size()], genres[(i / 3) % genres.size()]});
+    movie.SetPlot(StringUtils::Format("Plot of movie {}, long enough to look like one.", i));
+    movie.SetRating(static_cast<float>(i % 100) / 10.0f, 100 + i);
+    movie.m_strFileNameAndPath = StringUtils::Format("/storage/movies/Movie {0}/movie{0}.mkv", i);
+    ASSERT_GT(videodb.SetDetailsForMovie(movie, {}), 0);
+  }
+  videodb.Close();
+
+  CMusicDatabase musicdb;
+  ASSERT_TRUE(musicdb.Open());
+  for (int i = 1; i <= albums; i++)
+  {
+    CAlbum album;
+    album.strAlbum = StringUtils::Format("Album {}", i);
+    album.artistCredits.emplace_back(StringUtils::Format("Artist {}", i % 97));
+    album.genre = {genres[i % genres.size()]};
+    album.strReleaseDate = std::to_string(1960 + i % 60);
+    album.strPath = StringUtils::Format("/storage/music/Album {}/", i);
+    for (int track = 1; track <= 12; track++)
+    {
+      CSong song;
+      song.strTitle = StringUtils::Format("Song {} of album {}", track, i);
+      song.strFileName = StringUtils::Format("{}{:02}.flac", album.strPath, track);
+      song.artistCredits = album.artistCredits;
+      song.genre = album.genre;
+      song.iTrack = track;
+      song.iDuration = 180 + track * 7;
+      album.songs.push_back(song);
+    }
+    ASSERT_TRUE(musicdb.AddAlbum(album, -1));
+  }
+  musicdb.Close();
+}
+
+struct MethodStats
+{
+  std::vector<double> latencies; // in microseconds
+  unsigned int errors = 0;
+};
+
+double Percentile(const std::vector<double>& sorted, double percentile)
+{
+  if (sorted.empty())
+    return 0.0;
+
+  const size_t index = static_cast<size_t>(percentile / 100.0 * (sorted.size() - 1) + 0.5);
+  return sorted[std::min(index, sorted.size() - 1)];
+}
+
+/*!
+ \brief Get the requests of the configured mix with their weights
+ */
+std::vector<Payload> GetMixPayloads(const Config& config, std::vector<int>& weights)
+{
+  std::vector<Payload> payloads;
+  for (const Request& request : REQUESTS)
+  {
+    auto it = config.mix.find(request.method);
+    if (it != config.mix.end() && it->second > 0)
+    {
+      payloads.push_back(
+          {request.method,
+           StringUtils::Format(R"({{"jsonrpc":"2.0","method":"{}","params":{},"id":1}})",
+                               request.method, request.params)});
+      weights.push_back(it->second);
+    }
+  }
+  return payloads;
+}
+
+/*!
+ \brief Read the requests of a recorded session, in the recorded order
+ */
+std::vector<Payload> LoadSession(const std::string& path)
+{
+  static const std::string marker = "JSONRPC: Incoming request: ";
+
+  std::vector<Payload> payloads;
+  std::ifstream file(path);
+  std::string line;
+  while (std::getline(file, line))
+  {
+    const size_t pos = line.find(marker);
+    if (pos != std::string::npos)
+      line.erase(0, pos + marker.size());
+    StringUtils::Trim(line);
+
+    CVariant request;
+    if (line.empty() || !CJSONVariantParser::Parse(line, request))
+      continue;
+
+    if (request.isArray())
+      payloads.push_back({"(batch)", line});
+    else if (request.isObject() && request["method"].isString())
+      payloads.push_back({request["method"].asString(), line});
+  }
+  return payloads;
+}
+
+/*!
+ \brief Send the requests from concurrent clients, picked by their weights or replayed in
+ order if there are no weights
+ \return statistics per method, the total duration in seconds is returned in elapsed
+ */
+std::map<std::string, MethodStats> RunClients(const Config& config,
+                                              const std::vector<Payload>& payloads,
+                                              const std::vector<int>& weights,
+                                              double& elapsed)
+{
+  std::vector<std::map<std::string, MethodStats>> results(config.threads);
+  std::vector<std::thread> clients;
+
+  const auto start = std::chrono::steady_clock::now();
+  for (int client = 0; client < config.threads; client++)
+  {
+    clients.emplace_back([&, client]() {
+      CBenchmarkTransportLayer transport;
+      CBenchmarkClient jsonClient;
+      std::mt19937 random(client);
+      std::discrete_distribution<size_t> distribution(weights.begin(), weights.end());
+      // replaying clients start at different points of the session
+      size_t next = payloads.size() * client / config.threads;
+
+      for (int i = 0; i < config.requests; i++)
+      {
+        const size_t index = weights.empty() ? next++ % payloads.size() : distribution(random);
+        const auto begin = std::chrono::steady_clock::now();
+        const std::string response =
+            CJSONRPC::MethodCall(payloads[index].request, &transport, &jsonClient);
+        const auto end = std::chrono::steady_clock::now();
+
+        MethodStats& stats = results[client][payloads[index].method];
+        stats.latencies.push_back(
+            std::chrono::duration<double, std::micro>(end - begin).count());
+
+        // notifications don't get a response
+        CVariant result;
+        if ((!response.empty() && !CJSONVariantParser::Parse(response, result)) ||
+            result.isMember("error"))
+          stats.errors++;
+      }
+    });
+  }
+  for (auto& client : clients)
+    client.join();
+  elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  std::map<std::string, MethodStats> stats;
+  for (const auto& result : results)
+  {
+    for (const auto& method : result)
+    {
+      MethodStats& total = stats[method.first];
+      total.latencies.insert(total.latencies.end(), method.second.latencies.begin(),
+                             method.second.latencies.end());
+      total.errors += method.second.errors;
+    }
+  }
+  for (auto& method : stats)
+    std::sort(method.second.latencies.begin(), method.second.latencies.end());
+
+  return stats;
+}
+
+/*!
+ \brief Measure CJSONServiceDescription::CheckCall() alone, i.e. the cost of checking the
+ parameters against the schema and filling in the defaults
+ \return average duration per method in microseconds
+ */
+std::map<std::string, double> ProfileValidation(const std::vector<Payload>& payloads,
+                                                int iterations)
+{
+  std::map<std::string, double> durations;
+  CBenchmarkTransportLayer transport;
+  CBenchmarkClient client;
+
+  for (const Payload& payload : payloads)
+  {
+    // the first request of each method is profiled, batches aren't
+    CVariant request;
+    if (durations.find(payload.method) != durations.end() ||
+        !CJSONVariantParser::Parse(payload.request, request) || !request.isObject())
+      continue;
+
+    CVariant parameters(CVariant::VariantTypeObject);
+    if (request.isMember("params"))
+      parameters = request["params"];
+    std::string method = payload.method;
+    StringUtils::ToLower(method);
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++)
+    {
+      MethodCall methodCall;
+      CVariant output;
+      CJSONServiceDescription::CheckCall(method.c_str(), parameters, &transport, &client, false,
+                                         methodCall, output);
+    }
+    durations[payload.method] =
+        std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start)
+            .count() /
+        iterations;
+  }
+
+  return durations;
+}
+
+void Report(const Config& config,
+            const std::map<std::string, MethodStats>& stats,
+            const std::map<std::string, double>& validation,
+            double elapsed)
+{
+  size_t total = 0;
+  for (const auto& method : stats)
+    total += method.second.latencies.size();
+
+  std::cout << StringUtils::Format("{} clients, {} requests in {:.2f} s, {:.0f} requests/s\n",
+                                   config.threads, total, elapsed, total / elapsed);
+  std::cout << StringUtils::Format("{:<30}{:>8}{:>8}{:>10}{:>10}{:>10}{:>10}{:>10}{:>12}\n",
+                                   "method", "calls", "errors", "req/s", "p50 us", "p90 us",
+                                   "p99 us", "max us", "schema us");
+  for (const auto& method : stats)
+  {
+    const std::vector<double>& latencies = method.second.latencies;
+    auto it = validation.find(method.first);
+    std::cout << StringUtils::Format(
+        "{:<30}{:>8}{:>8}{:>10.0f}{:>10.0f}{:>10.0f}{:>10.0f}{:>10.0f}{:>12.1f}\n", method.first,
+        latencies.size(), method.second.errors, latencies.size() / elapsed,
+        Percentile(latencies, 50), Percentile(latencies, 90), Percentile(latencies, 99),
+        latencies.empty() ? 0.0 : latencies.back(), it != validation.end() ? it->second : 0.0);
+  }
+}
+} // unnamed namespace
+
+class TestJSONRPCBenchmark : public testing::Test
+{
+protected:
+  static void SetUpTestSuite()
+  {
+    // the test environment doesn't set up the databases, they are created in the temp profile
+    CServiceBroker::GetDatabaseManager().Initialize();
+    CJSONRPC::Initialize();
+  }
+  static void TearDownTestSuite() { CJSONRPC::Cleanup(); }
+};
+
+TEST_F(TestJSONRPCBenchmark, DISABLED_Run)
+{
+  const Config config = GetConfig();
+  std::vector<int> weights;
+  std::vector<Payload> payloads;
+  if (config.replay.empty())
+  {
+    payloads = GetMixPayloads(config, weights);
+    ASSERT_FALSE(payloads.empty()) << "KODI_JSONRPC_BENCH_MIX matches no method";
+  }
+  else
+  {
+    payloads = LoadSession(config.replay);
+    ASSERT_FALSE(payloads.empty()) << "no requests found in " << config.replay;
+    std::cout << StringUtils::Format("Replaying {} requests from {}\n", payloads.size(),
+                                     config.replay);
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+  GenerateLibrary(config.movies, config.albums);
+  std::cout << StringUtils::Format(
+      "Generated {} movies and {} albums in {:.1f} s\n", config.movies, config.albums,
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+
+  double elapsed = 0;
+  const std::map<std::string, MethodStats> stats = RunClients(config, payloads, weights, elapsed);
+  Report(config, stats, ProfileValidation(payloads, 1000), elapsed);
+}
@@ -0,0 +1,151 @@
+/*
+ *  Copyright (C) 2023 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "interfaces/json-rpc/JSONUtils.h"
+#include "utils/Base64.h"
+#include "utils/Variant.h"
+
+#include <limits>
+#include <string>
+
+#include <gtest/gtest.h>
+
+using namespace JSONRPC;
+
+namespace
+{
+class CTestJSONUtils : public CJSONUtils
+{
+public:
+  using CJSONUtils::HandleLimits;
+  using CJSONUtils::ParseCursor;
+  using CJSONUtils::ResumeLimits;
+  using CJSONUtils::SetCursor;
+};
+
+CVariant GetRequest(int start, int end, const std::string& cursor = "")
+{
+  CVariant request;
+  request["limits"]["start"] = start;
+  request["limits"]["end"] = end;
+  if (!cursor.empty())
+    request["limits"]["cursor"] = cursor;
+  return request;
+}
+
+// the limits of a returned page, as HandleLimits() sets them
+CVariant GetResult(const CVariant& request, int total)
+{
+  CVariant result;
+  int start, end;
+  CTestJSONUtils::HandleLimits(request, result, total, start, end);
+  return result;
+}
+} // unnamed namespace
+
+TEST(TestJSONUtils, ParseCursorWithoutCursor)
+{
+  int lastId, position;
+  EXPECT_TRUE(CTestJSONUtils::ParseCursor(GetRequest(0, 10), lastId, position));
+  EXPECT_EQ(-1, lastId);
+  EXPECT_EQ(0, position);
+
+  EXPECT_TRUE(CTestJSONUtils::ParseCursor(CVariant(CVariant::VariantTypeObject), lastId, position));
+  EXPECT_EQ(-1, lastId);
+  EXPECT_EQ(0, position);
+}
+
+TEST(TestJSONUtils, CursorRoundTrip)
+{
+  // first page of 25 out of 100 items, ordered by id
+  CVariant result = GetResult(GetRequest(0, 25), 100);
+  CTestJSONUtils::SetCursor(result, 42);
+  ASSERT_TRUE(result["limits"]["cursor"].isString());
+
+  int lastId, position;
+  CVariant request = GetRequest(0, 25, result["limits"]["cursor"].asString());
+  ASSERT_TRUE(CTestJSONUtils::ParseCursor(request, lastId, position));
+  EXPECT_EQ(42, lastId);
+  EXPECT_EQ(25, position);
+
+  // the next page keeps the page size
+  CTestJSONUtils::ResumeLimits(request, position);
+  EXPECT_EQ(25, request["limits"]["start"].asInteger());
+  EXPECT_EQ(50, request["limits"]["end"].asInteger());
+
+  result = GetResult(request, 100);
+  CTestJSONUtils::SetCursor(result, 87);
+  request = GetRequest(0, 25, result["limits"]["cursor"].asString());
+  ASSERT_TRUE(CTestJSONUtils::ParseCursor(request, lastId, position));
+  EXPECT_EQ(87, lastId);
+  EXPECT_EQ(50, position);
+}
+
+TEST(TestJSONUtils, CursorWithSort)
+{
+  // sorted items aren't in id order, they are resumed by position only
+  CVariant result = GetResult(GetRequest(0, 10), 30);
+  CTestJSONUtils::SetCursor(result, -1);
+
+  int lastId, position;
+  CVariant request = GetRequest(0, 10, result["limits"]["cursor"].asString());
+  ASSERT_TRUE(CTestJSONUtils::ParseCursor(request, lastId, position));
+  EXPECT_EQ(-1, lastId);
+  EXPECT_EQ(10, position);
+}
+
+TEST(TestJSONUtils, NoCursorOnLastPage)
+{
+  CVariant result = GetResult(GetRequest(75, 100), 100);
+  CTestJSONUtils::SetCursor(result, 100);
+  EXPECT_FALSE(result["limits"].isMember("cursor"));
+
+  // a page running past the end is the last one as well
+  result = GetResult(GetRequest(90, 120), 100);
+  CTestJSONUtils::SetCursor(result, 100);
+  EXPECT_FALSE(result["limits"].isMember("cursor"));
+}
+
+TEST(TestJSONUtils, ResumeWithoutPageSize)
+{
+  CVariant request = GetRequest(0, 0);
+  CTestJSONUtils::ResumeLimits(request, 30);
+  EXPECT_EQ(30, request["limits"]["start"].asInteger());
+  EXPECT_EQ(std::numeric_limits<int>::max(), request["limits"]["end"].asInteger());
+}
+
+TEST(TestJSONUtils, MalformedCursor)
+{
+  static const char* cursors[] = {"12", "1:2:3", "a:2", "1:b", "1:", ":2", "1.5:2"};
+
+  int lastId, position;
+  for (const char* cursor : cursors)
+  {
+    EXPECT_FALSE(
+        CTestJSONUtils::ParseCursor(GetRequest(0, 10, Base64::Encode(cursor)), lastId, position))
+        << cursor;
+  }
+
+  // not base64 at all
+  EXPECT_FALSE(CTestJSONUtils::ParseCursor(GetRequest(0, 10, "not a cursor"), lastId, position));
+}
+
+TEST(TestJSONUtils, NegativeCursor)
+{
+  int lastId, position;
+  EXPECT_FALSE(CTestJSONUtils::ParseCursor(GetRequest(0, 10, Base64::Encode("5:-10")), lastId,
+                                       position));
+  EXPECT_FALSE(CTestJSONUtils::ParseCursor(GetRequest(0, 10, Base64::Encode("-1:-1")), lastId,
+                                       position));
+
+  // a negative id only means that the items aren't resumed by id
+  ASSERT_TRUE(CTestJSONUtils::ParseCursor(GetRequest(0, 10, Base64::Encode("-7:10")), lastId,
+                                      position));
+  EXPECT_GT(0, lastId);
+  EXPECT_EQ(10, position);
+}
@@ -0,0 +1,101 @@
+/*
+ *  Copyright (C) 2023 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "interfaces/AnnouncementManager.h"
+#include "threads/CriticalSection.h"
+#include "utils/Variant.h"
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace ANNOUNCEMENT;
+
+namespace
+{
+class CTestAnnouncer : public IAnnouncer
+{
+public:
+  void Announce(AnnouncementFlag flag,
+                const std::string& sender,
+                const std::string& message,
+                const CVariant& data) override
+  {
+    std::unique_lock<CCriticalSection> lock(m_critSection);
+    m_messages.push_back(message + ":" + data["id"].asString());
+  }
+
+  std::vector<std::string> WaitForMessages(size_t count)
+  {
+    for (int i = 0; i < 500; i++)
+    {
+      {
+        std::unique_lock<CCriticalSection> lock(m_critSection);
+        if (m_messages.size() >= count)
+          return m_messages;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    std::unique_lock<CCriticalSection> lock(m_critSection);
+    return m_messages;
+  }
+
+private:
+  CCriticalSection m_critSection;
+  std::vector<std::string> m_messages;
+};
+
+CVariant ItemData(const std::string& type, int id)
+{
+  CVariant data;
+  data["type"] = type;
+  data["id"] = id;
+  return data;
+}
+} // unnamed namespace
+
+TEST(TestAnnouncementManager, DropsQueuedDuplicates)
+{
+  CAnnouncementManager manager;
+  CTestAnnouncer announcer;
+  manager.AddAnnouncer(&announcer);
+
+  // queue everything before the announcements are delivered
+  manager.Announce(VideoLibrary, "OnUpdate", ItemData("movie", 1));
+  manager.Announce(VideoLibrary, "OnUpdate", ItemData("movie", 1));
+  manager.Announce(VideoLibrary, "OnUpdate", ItemData("movie", 2));
+  manager.Announce(VideoLibrary, "OnRemove", ItemData("movie", 1));
+  manager.Announce(AudioLibrary, "OnUpdate", ItemData("song", 1));
+  manager.Announce(VideoLibrary, "OnUpdate", ItemData("movie", 1));
+
+  CVariant changed = ItemData("movie", 2);
+  changed["playcount"] = 1;
+  manager.Announce(VideoLibrary, "OnUpdate", changed);
+
+  // other notifications are never dropped
+  manager.Announce(Player, "OnPause", ItemData("movie", 1));
+  manager.Announce(Player, "OnPause", ItemData("movie", 1));
+
+  manager.Start();
+  // the movie updated after its removal is still announced
+  const std::vector<std::string> expected = {"OnUpdate:1", "OnUpdate:2", "OnRemove:1",
+                                             "OnUpdate:1", "OnUpdate:1", "OnUpdate:2",
+                                             "OnPause:1",  "OnPause:1"};
+  EXPECT_EQ(expected, announcer.WaitForMessages(expected.size()));
+
+  // delivered notifications can be repeated
+  manager.Announce(VideoLibrary, "OnUpdate", ItemData("movie", 1));
+  EXPECT_EQ(expected.size() + 1, announcer.WaitForMessages(expected.size() + 1).size());
+
+  manager.Deinitialize();
+}
@@ -395,6 +395,11 @@ void CMusicDatabase::CreateAnalytics()
               "END");
   CreateRemovedLinkTriggers(); // DELETE ON song_artist and album_artist tables
 
+  // Full-text indices used by searches and "contains" filters (SQLite only)
+  CreateFullTextIndex("song", "idSong", {"strTitle"});
+  CreateFullTextIndex("album", "idAlbum", {"strAlbum"});
+  CreateFullTextIndex("artist", "idArtist", {"strArtist"});
+
   // Create native functions stored in DB (MySQL/MariaDB only)
   CreateNativeDBFunctions();
 
@@ -419,49 +424,69 @@ void CMusicDatabase::CreateRemovedLinkTriggers()
 void CMusicDatabase::CreateViews()
 {
   CLog::Log(LOGINFO, "create song view");
-  m_pDS->exec("CREATE VIEW songview AS SELECT "
-              "        song.idSong AS idSong, "
-              "        song.strArtistDisp AS strArtists,"
-              "        song.strArtistSort AS strArtistSort,"
-              "        song.strGenres AS strGenres,"
-              "        strTitle, "
-              "        iTrack, iDuration, "
-              "        song.strReleaseDate as strReleaseDate, "
-              "        song.strOrigReleaseDate as strOrigReleaseDate, "
-              "        song.strDiscSubtitle as strDiscSubtitle, "
-              "        strFileName, "
-              "        strMusicBrainzTrackID, "
-              "        iTimesPlayed, iStartOffset, iEndOffset, "
-              "        lastplayed, "
-              "        song.rating, "
-              "        song.userrating, "
-              "        song.votes, "
-              "        comment, "
-              "        song.idAlbum AS idAlbum, "
-              "        strAlbum, "
-              "        strPath, "
-              "        album.strReleaseStatus as strReleaseStatus,"
-              "        album.bCompilation AS bCompilation,"
-              "        album.bBoxedSet AS bBoxedSet, "
-              "        album.strArtistDisp AS strAlbumArtists,"
-              "        album.strArtistSort AS strAlbumArtistSort,"
-              "        album.strReleaseType AS strAlbumReleaseType,"
-              "        song.mood as mood,"
-              "        song.strReplayGain, "
-              "        iBPM, "
-              "        iBitRate, "
-              "        iSampleRate, "
-              "        iChannels, "
-              "        album.iAlbumDuration AS iAlbumDuration, "
-              "        album.iDiscTotal as iDiscTotal, "
-              "        song.dateAdded as dateAdded, "
-              "        song.dateNew AS dateNew, "
-              "        song.dateModified AS dateModified "
-              "FROM song"
-              "  JOIN album ON"
-              "    song.idAlbum=album.idAlbum"
-              "  JOIN path ON"
-              "    song.idPath=path.idPath");
+  CreateMaterializedView("songview",
+                         "SELECT "
+                         "        song.idSong AS idSong, "
+                         "        song.strArtistDisp AS strArtists,"
+                         "        song.strArtistSort AS strArtistSort,"
+                         "        song.strGenres AS strGenres,"
+                         "        strTitle, "
+                         "        iTrack, iDuration, "
+                         "        song.strReleaseDate as strReleaseDate, "
+                         "        song.strOrigReleaseDate as strOrigReleaseDate, "
+                         "        song.strDiscSubtitle as strDiscSubtitle, "
+                         "        strFileName, "
+                         "        strMusicBrainzTrackID, "
+                         "        iTimesPlayed, iStartOffset, iEndOffset, "
+                         "        lastplayed, "
+                         "        song.rating, "
+                         "        song.userrating, "
+                         "        song.votes, "
+                         "        comment, "
+                         "        song.idAlbum AS idAlbum, "
+                         "        strAlbum, "
+                         "        strPath, "
+                         "        album.strReleaseStatus as strReleaseStatus,"
+                         "        album.bCompilation AS bCompilation,"
+                         "        album.bBoxedSet AS bBoxedSet, "
+                         "        album.strArtistDisp AS strAlbumArtists,"
+                         "        album.strArtistSort AS strAlbumArtistSort,"
+                         "        album.strReleaseType AS strAlbumReleaseType,"
+                         "        song.mood as mood,"
+                         "        song.strReplayGain, "
+                         "        iBPM, "
+                         "        iBitRate, "
+                         "        iSampleRate, "
+                         "        iChannels, "
+                         "        album.iAlbumDuration AS iAlbumDuration, "
+                         "        album.iDiscTotal as iDiscTotal, "
+                         "        song.dateAdded as dateAdded, "
+                         "        song.dateNew AS dateNew, "
+                         "        song.dateModified AS dateModified "
+                         "FROM song"
+                         "  JOIN album ON"
+                         "    song.idAlbum=album.idAlbum"
+                         "  JOIN path ON"
+                         "    song.idPath=path.idPath",
+                         "idSong", {"idAlbum", "idPath"});
+  CreateMaterializedViewTrigger("songview", "idSong", "song", "INSERT", "NEW.idSong");
+  CreateMaterializedViewTrigger("songview", "idSong", "song", "UPDATE", "OLD.idSong, NEW.idSong");
+  CreateMaterializedViewTrigger("songview", "idSong", "song", "DELETE", "OLD.idSong");
+  CreateMaterializedViewTrigger("songview", "idSong", "album", "INSERT",
+                                "SELECT idSong FROM song WHERE idAlbum = NEW.idAlbum");
+  CreateMaterializedViewTrigger("songview", "idSong", "album",
+                                "UPDATE OF strAlbum, strReleaseStatus, bCompilation, bBoxedSet, "
+                                "strArtistDisp, strArtistSort, strReleaseType, iAlbumDuration, "
+                                "iDiscTotal",
+                                "SELECT idSong FROM song WHERE idAlbum = NEW.idAlbum");
+  CreateMaterializedViewTrigger("songview", "idSong", "album", "DELETE",
+                                "SELECT idSong FROM song WHERE idAlbum = OLD.idAlbum");
+  CreateMaterializedViewTrigger("songview", "idSong", "path", "INSERT",
+                                "SELECT idSong FROM song WHERE idPath = NEW.idPath");
+  CreateMaterializedViewTrigger("songview", "idSong", "path", "UPDATE OF strPath",
+                                "SELECT idSong FROM song WHERE idPath = NEW.idPath");
+  CreateMaterializedViewTrigger("songview", "idSong", "path", "DELETE",
+                                "SELECT idSong FROM song WHERE idPath = OLD.idPath");
 
   CLog::Log(LOGINFO, "create album view");
   m_pDS->exec("CREATE VIEW albumview AS SELECT "
@@ -3362,6 +3387,11 @@ bool CMusicDatabase::SearchArtists(const std::string& search, CFileItemList& art
                           "WHERE strArtist LIKE '%s%%' AND strArtist <> '%s' ",
                           search.c_str(), strVariousArtists.c_str());
 
+    // let the full-text index narrow down the rows to check
+    const std::string fullText = GetFullTextCondition("artist", "artist.idArtist", search);
+    if (!fullText.empty())
+      strSQL += "AND " + fullText;
+
     if (!m_pDS->query(strSQL))
       return false;
     if (m_pDS->num_rows() == 0)
@@ -4001,13 +4031,19 @@ bool CMusicDatabase::SearchSongs(const std::string& search, CFileItemList& items
     std::string strSQL;
     if (search.size() >= MIN_FULL_SEARCH_LENGTH)
       strSQL = PrepareSQL("SELECT * FROM songview "
-                          "WHERE strTitle LIKE '%s%%' or strTitle LIKE '%% %s%%' LIMIT 1000",
+                          "WHERE (strTitle LIKE '%s%%' or strTitle LIKE '%% %s%%')",
                           search.c_str(), search.c_str());
     else
       strSQL = PrepareSQL("SELECT * FROM songview "
-                          "WHERE strTitle LIKE '%s%%' LIMIT 1000",
+                          "WHERE strTitle LIKE '%s%%'",
                           search.c_str());
 
+    // let the full-text index narrow down the rows to check
+    const std::string fullText = GetFullTextCondition("song", "songview.idSong", search);
+    if (!fullText.empty())
+      strSQL += " AND " + fullText;
+    strSQL += " LIMIT 1000";
+
     if (!m_pDS->query(strSQL))
       return false;
     if (m_pDS->num_rows() == 0)
@@ -4044,13 +4080,18 @@ bool CMusicDatabase::SearchAlbums(const std::string& search, CFileItemList& albu
     std::string strSQL;
     if (search.size() >= MIN_FULL_SEARCH_LENGTH)
       strSQL = PrepareSQL("SELECT * FROM albumview "
-                          "WHERE strAlbum LIKE '%s%%' OR strAlbum LIKE '%% %s%%'",
+                          "WHERE (strAlbum LIKE '%s%%' OR strAlbum LIKE '%% %s%%')",
                           search.c_str(), search.c_str());
     else
       strSQL = PrepareSQL("SELECT * FROM albumview "
                           "WHERE strAlbum LIKE '%s%%'",
                           search.c_str());
 
+    // let the full-text index narrow down the rows to check
+    const std::string fullText = GetFullTextCondition("album", "albumview.idAlbum", search);
+    if (!fullText.empty())
+      strSQL += " AND " + fullText;
+
     if (!m_pDS->query(strSQL))
       return false;
 
@@ -4565,6 +4606,9 @@ int CMusicDatabase::Cleanup(CGUIDialogProgress* progressDialog /*= nullptr*/)
   // Recreate DELETE triggers on song_artist and album_artist
   CreateRemovedLinkTriggers();
 
+  // verify the stored rows of the materialized views after the bulk changes
+  CheckMaterializedViews();
+
   // and compress the database
   if (progressDialog)
   {
@@ -7632,7 +7676,8 @@ bool CMusicDatabase::GetSongsByWhereJSON(
     const std::string& baseDir,
     CVariant& result,
     int& total,
-    const SortDescription& sortDescription /* = SortDescription() */)
+    const SortDescription& sortDescription /* = SortDescription() */,
+    int afterSongId /* = -1 */)
 {
 
   if (nullptr == m_pDB)
@@ -7682,7 +7727,15 @@ bool CMusicDatabase::GetSongsByWhereJSON(
     total = GetSingleValueInt("SELECT COUNT(1) FROM song " + strSQLExtra, m_pDS);
     resultcount = static_cast<size_t>(total);
 
+    // Continue a paged request after the last song of the previous page,
+    // the total count still covers all songs
+    if (afterSongId >= 0)
+      extFilter.AppendWhere(PrepareSQL("song.idSong > %i", afterSongId));
+
     int iAddedFields = GetOrderFilter(MediaTypeSong, sortDescription, extFilter);
+    // Unsorted songs are in id order so pages can be resumed by id
+    if (sortDescription.sortBy == SortByNone)
+      extFilter.AppendOrder("song.idSong");
     // Replace songview field names in order by with song, album path table field names
     // Field names in album same as song:
     //   idAlbum, strArtistDisp, strArtistSort, strGenres, iYear, bCompilation
@@ -8045,7 +8098,7 @@ bool CMusicDatabase::GetSongsByWhereJSON(
                 songObj[displayXXX] = "";
             }
           }
-          result["songs"].append(songObj);
+          result["songs"].push_back(std::move(songObj));
           bHaveSong = false;
           songObj.clear();
         }
@@ -9308,7 +9361,7 @@ void CMusicDatabase::UpdateTables(int version)
 
 int CMusicDatabase::GetSchemaVersion() const
 {
-  return 82;
+  return 84;
 }
 
 int CMusicDatabase::GetMusicNeedsTagScan()
@@ -13155,9 +13208,22 @@ bool CMusicDatabase::GetFilter(CDbUrl& musicUrl, Filter& filter, SortDescription
     if (!xsp.LoadFromJson(option->second.asString()))
       return false;
 
-    std::set<std::string> playlists;
-    std::string xspWhere;
-    xspWhere = xsp.GetWhereClause(*this, playlists);
+    // the ids of matching songs and albums can be resolved using the same joins as
+    // GetSongsFullByWhere() and GetAlbumsByWhere(), artists depend on the role rules
+    std::string from;
+    std::string idField;
+    if (xsp.GetType() == type && type == "songs")
+    {
+      from = "songview JOIN albumview ON albumview.idAlbum = songview.idAlbum";
+      idField = "songview.idSong";
+    }
+    else if (xsp.GetType() == type && type == "albums")
+    {
+      from = "albumview LEFT JOIN songview ON songview.idAlbum = albumview.idAlbum";
+      idField = "albumview.idAlbum";
+    }
+    std::string xspWhere =
+        GetSmartPlaylistWhereClause(xsp, option->second.asString(), type, from, idField);
     hasRoleRules = xsp.GetType() == "artists" &&
                    xspWhere.find("song_artist.idRole = role.idRole") != xspWhere.npos;
 
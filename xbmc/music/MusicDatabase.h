@@ -672,7 +672,8 @@ public:
                            const std::string& baseDir,
                            CVariant& result,
                            int& total,
-                           const SortDescription& sortDescription = SortDescription());
+                           const SortDescription& sortDescription = SortDescription(),
+                           int afterSongId = -1);
 
   /////////////////////////////////////////////////
   // Scraper
@@ -40,7 +40,7 @@
 #include "music/MusicThumbLoader.h"
 #include "music/MusicUtils.h"
 #include "music/tags/MusicInfoTag.h"
-#include "music/tags/MusicInfoTagLoaderFactory.h"
+#include "music/tags/MusicTagReader.h"
 #include "settings/AdvancedSettings.h"
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
@@ -53,6 +53,7 @@
 #include "utils/log.h"
 
 #include <algorithm>
+#include <chrono>
 #include <utility>
 
 using namespace MUSIC_INFO;
@@ -62,6 +63,13 @@ using namespace MUSIC_GRABBER;
 using namespace ADDON;
 using KODI::UTILITY::CDigest;
 
+namespace
+{
+// tag reading is mostly waiting for the file system, so a few readers overlap the latency of
+// network shares without putting too much load on them
+constexpr unsigned int MAX_TAG_READERS = 4;
+} // namespace
+
 CMusicInfoScanner::CMusicInfoScanner()
 : m_fileCountReader(this, "MusicFileCounter")
 {
@@ -567,11 +575,9 @@ CInfoScanner::INFO_RET CMusicInfoScanner::ScanTags(const CFileItemList& items,
 {
   std::vector<std::string> regexps = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_audioExcludeFromScanRegExps;
 
+  std::vector<CFileItemPtr> songItems;
   for (int i = 0; i < items.Size(); ++i)
   {
-    if (m_bStop)
-      return INFO_CANCELLED;
-
     CFileItemPtr pItem = items[i];
 
     if (CUtil::ExcludeFileOrFolder(pItem->GetPath(), regexps))
@@ -580,15 +586,31 @@ CInfoScanner::INFO_RET CMusicInfoScanner::ScanTags(const CFileItemList& items,
     if (pItem->m_bIsFolder || pItem->IsPlayList() || pItem->IsPicture() || pItem->IsLyrics())
       continue;
 
-    m_currentItem++;
+    songItems.push_back(pItem);
+  }
 
-    CMusicInfoTag& tag = *pItem->GetMusicInfoTag();
-    if (!tag.Loaded())
+  // the tags are read ahead of this thread, which handles the results in directory order so
+  // that the album grouping is the same as when reading them one by one
+  CMusicTagReader tagReader(songItems, MAX_TAG_READERS);
+
+  INFO_RET ret = INFO_ADDED;
+  for (size_t i = 0; i < songItems.size(); ++i)
+  {
+    while (!tagReader.Wait(i, std::chrono::milliseconds(100)))
     {
-      std::unique_ptr<IMusicInfoTagLoader> pLoader (CMusicInfoTagLoaderFactory::CreateLoader(*pItem));
-      if (nullptr != pLoader)
-        pLoader->Load(pItem->GetPath(), tag);
+      if (m_bStop)
+      {
+        ret = INFO_CANCELLED;
+        break;
+      }
     }
+    if (ret == INFO_CANCELLED)
+      break;
+
+    CFileItemPtr pItem = songItems[i];
+    CMusicInfoTag& tag = *pItem->GetMusicInfoTag();
+
+    m_currentItem++;
 
     if (m_handle && m_itemCount>0)
       m_handle->SetPercentage(static_cast<float>(m_currentItem * 100) / static_cast<float>(m_itemCount));
@@ -609,7 +631,8 @@ CInfoScanner::INFO_RET CMusicInfoScanner::ScanTags(const CFileItemList& items,
     else
       scannedItems.Add(pItem);
   }
-  return INFO_ADDED;
+
+  return ret;
 }
 
 static bool SortSongsByTrack(const CSong& song, const CSong& song2)
@@ -1155,10 +1178,27 @@ void CMusicInfoScanner::FindArtForAlbums(VECALBUMS &albums, const std::string &p
     }
     else
     { // more than one piece of art was found for these songs, so cache per song
+      // songs with identical embedded art share the image of the first of them, so the texture
+      // cache only loads and stores it once
+      std::map<std::string, std::string> embeddedThumbs;
+      if (art && art->strThumb.empty() && !art->embeddedArt.m_hash.empty() && albumArt ==
+          CTextureUtils::GetWrappedImageURL(art->strFileName, "music"))
+        embeddedThumbs[art->embeddedArt.m_hash] = albumArt;
+
       for (auto& k : album.songs)
       {
         if (k.strThumb.empty() && !k.embeddedArt.Empty())
-          k.strThumb = CTextureUtils::GetWrappedImageURL(k.strFileName, "music");
+        {
+          if (k.embeddedArt.m_hash.empty())
+          {
+            k.strThumb = CTextureUtils::GetWrappedImageURL(k.strFileName, "music");
+            continue;
+          }
+          std::string& thumb = embeddedThumbs[k.embeddedArt.m_hash];
+          if (thumb.empty())
+            thumb = CTextureUtils::GetWrappedImageURL(k.strFileName, "music");
+          k.strThumb = thumb;
+        }
       }
     }
   }
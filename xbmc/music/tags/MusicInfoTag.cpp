@@ -742,9 +742,10 @@ void CMusicInfoTag::SetMusicBrainzReleaseType(const std::string& ReleaseType)
   m_strMusicBrainzReleaseType = ReleaseType;
 }
 
-void CMusicInfoTag::SetCoverArtInfo(size_t size, const std::string &mimeType)
+void CMusicInfoTag::SetCoverArtInfo(size_t size, const std::string &mimeType, const std::string& hash)
 {
   m_coverArt.Set(size, mimeType);
+  m_coverArt.m_hash = hash;
 }
 
 void CMusicInfoTag::SetReplayGain(const ReplayGain& aGain)
@@ -864,7 +865,7 @@ void CMusicInfoTag::SetSong(const CSong& song)
   SetDateAdded(song.dateAdded);
   SetDateUpdated(song.dateUpdated);
   SetDateNew(song.dateNew);
-  SetCoverArtInfo(song.embeddedArt.m_size, song.embeddedArt.m_mime);
+  SetCoverArtInfo(song.embeddedArt.m_size, song.embeddedArt.m_mime, song.embeddedArt.m_hash);
   SetRating(song.rating);
   SetUserrating(song.userrating);
   SetVotes(song.votes);
@@ -144,7 +144,7 @@ public:
   void SetDateNew(const CDateTime& dateNew);
   void SetCompilation(bool compilation);
   void SetBoxset(bool boxset);
-  void SetCoverArtInfo(size_t size, const std::string &mimeType);
+  void SetCoverArtInfo(size_t size, const std::string &mimeType, const std::string& hash = "");
   void SetReplayGain(const ReplayGain& aGain);
   void SetAlbumReleaseType(CAlbum::ReleaseType releaseType);
   void SetType(const MediaType& mediaType);
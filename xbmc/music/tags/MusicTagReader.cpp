@@ -0,0 +1,108 @@
+/*
+ *  Copyright (C) 2023 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "MusicTagReader.h"
+
+#include "FileItem.h"
+#include "MusicInfoTag.h"
+#include "MusicInfoTagLoaderFactory.h"
+#include "threads/Thread.h"
+
+#include <algorithm>
+#include <mutex>
+
+using namespace MUSIC_INFO;
+
+class CMusicTagReader::CReader : public CThread
+{
+public:
+  explicit CReader(CMusicTagReader& owner) : CThread("MusicTagReader"), m_owner(owner) {}
+
+protected:
+  void Process() override { m_owner.Read(m_bStop); }
+
+private:
+  CMusicTagReader& m_owner;
+};
+
+CMusicTagReader::CMusicTagReader(const std::vector<CFileItemPtr>& items,
+                                 unsigned int readers,
+                                 ReadFunction read)
+  : m_items(items), m_read(std::move(read)), m_done(items.size(), false)
+{
+  // create the tags here, the readers only fill them
+  for (const auto& item : m_items)
+    item->GetMusicInfoTag();
+
+  const size_t count = std::min(static_cast<size_t>(std::max(readers, 1u)), m_items.size());
+  for (size_t i = 0; i < count; ++i)
+  {
+    m_readers.emplace_back(std::make_unique<CReader>(*this));
+    m_readers.back()->Create();
+  }
+}
+
+CMusicTagReader::~CMusicTagReader()
+{
+  Stop();
+}
+
+bool CMusicTagReader::Wait(size_t index, std::chrono::milliseconds timeout)
+{
+  const auto end = std::chrono::steady_clock::now() + timeout;
+  while (!m_stopped)
+  {
+    {
+      std::unique_lock<CCriticalSection> lock(m_section);
+      if (m_done[index])
+        return true;
+    }
+
+    const auto now = std::chrono::steady_clock::now();
+    if (now >= end)
+      break;
+    m_readEvent.Wait(std::chrono::duration_cast<std::chrono::milliseconds>(end - now));
+  }
+  return false;
+}
+
+void CMusicTagReader::Stop()
+{
+  m_stopped = true;
+  m_readEvent.Set();
+
+  // signal all readers first, so they finish their current item at the same time
+  for (auto& reader : m_readers)
+    reader->StopThread(false);
+  for (auto& reader : m_readers)
+    reader->StopThread(true);
+  m_readers.clear();
+}
+
+void CMusicTagReader::LoadTag(CFileItem& item)
+{
+  CMusicInfoTag& tag = *item.GetMusicInfoTag();
+  if (tag.Loaded())
+    return;
+
+  std::unique_ptr<IMusicInfoTagLoader> pLoader(CMusicInfoTagLoaderFactory::CreateLoader(item));
+  if (nullptr != pLoader)
+    pLoader->Load(item.GetPath(), tag);
+}
+
+void CMusicTagReader::Read(const std::atomic<bool>& stop)
+{
+  for (size_t i = m_next++; i < m_items.size() && !stop; i = m_next++)
+  {
+    m_read(*m_items[i]);
+
+    std::unique_lock<CCriticalSection> lock(m_section);
+    m_done[i] = true;
+    m_readEvent.Set();
+  }
+}
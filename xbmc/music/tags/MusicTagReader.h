@@ -0,0 +1,80 @@
+/*
+ *  Copyright (C) 2023 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "threads/CriticalSection.h"
+#include "threads/Event.h"
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <vector>
+
+class CFileItem;
+typedef std::shared_ptr<CFileItem> CFileItemPtr;
+
+namespace MUSIC_INFO
+{
+/*!
+ \brief Read the tags of a list of items on a few worker threads.
+
+ Reading tags mostly waits for the file system, so the readers overlap the latency of network
+ shares while the caller handles the items in their original order as they become available.
+ */
+class CMusicTagReader
+{
+public:
+  using ReadFunction = std::function<void(CFileItem& item)>;
+
+  /*!
+   \brief Start reading the tags of the items
+   \param items the items to read, their music info tags are created before the readers start
+   \param readers the maximal number of worker threads
+   \param read reads the tag of an item, by default with the loader for the item's file type
+   */
+  CMusicTagReader(const std::vector<CFileItemPtr>& items,
+                  unsigned int readers,
+                  ReadFunction read = LoadTag);
+  ~CMusicTagReader();
+
+  /*!
+   \brief Wait until the tag of an item has been read
+   \param index the position of the item in the list
+   \param timeout how long to wait at most
+   \return true if the tag has been read, false on timeout or if reading was stopped
+   */
+  bool Wait(size_t index, std::chrono::milliseconds timeout);
+
+  /*!
+   \brief Stop reading, the readers finish the item they are reading and exit
+   */
+  void Stop();
+
+  /*!
+   \brief Load the tag of an item unless it is loaded already
+   */
+  static void LoadTag(CFileItem& item);
+
+private:
+  class CReader;
+
+  void Read(const std::atomic<bool>& stop);
+
+  std::vector<CFileItemPtr> m_items;
+  ReadFunction m_read;
+  std::vector<std::unique_ptr<CReader>> m_readers;
+  std::atomic<size_t> m_next{0};
+  std::atomic<bool> m_stopped{false};
+
+  CCriticalSection m_section;
+  std::vector<bool> m_done;
+  CEvent m_readEvent;
+};
+} // namespace MUSIC_INFO
@@ -92,6 +92,17 @@ std::vector<std::string> GetID3v2StringList(const ID3v2::FrameList& frameList)
   return std::vector<std::string>();
 }
 
+void SetCoverArt(CMusicInfoTag& tag,
+                 EmbeddedArt* art,
+                 const ByteVector& data,
+                 const std::string& mime)
+{
+  const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data.data());
+  tag.SetCoverArtInfo(data.size(), mime, EmbeddedArtInfo::ComputeHash(bytes, data.size()));
+  if (art)
+    art->Set(bytes, data.size(), mime);
+}
+
 void SetFlacArt(FLAC::File *flacFile, EmbeddedArt *art, CMusicInfoTag &tag)
 {
   FLAC::Picture *cover[2] = {};
@@ -108,9 +119,7 @@ void SetFlacArt(FLAC::File *flacFile, EmbeddedArt *art, CMusicInfoTag &tag)
   {
     if (c)
     {
-      tag.SetCoverArtInfo(c->data().size(), c->mimeType().to8Bit(true));
-      if (art)
-        art->Set(reinterpret_cast<const uint8_t*>(c->data().data()), c->data().size(), c->mimeType().to8Bit(true));
+      SetCoverArt(tag, art, c->data(), c->mimeType().to8Bit(true));
       return; // one is enough
     }
   }
@@ -218,9 +227,7 @@ bool CTagLoaderTagLib::ParseTag(ASF::Tag *asf, EmbeddedArt *art, CMusicInfoTag&
     else if (it->first == "WM/Picture")
     { // picture
       ASF::Picture pic = it->second.front().toPicture();
-      tag.SetCoverArtInfo(pic.picture().size(), pic.mimeType().toCString());
-      if (art)
-        art->Set(reinterpret_cast<const uint8_t *>(pic.picture().data()), pic.picture().size(), pic.mimeType().toCString());
+      SetCoverArt(tag, art, pic.picture(), pic.mimeType().toCString());
     }
     else if (CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_logLevel == LOG_LEVEL_MAX)
       CLog::Log(LOGDEBUG, "unrecognized ASF tag name: {}", it->first.toCString(true));
@@ -472,10 +479,7 @@ bool CTagLoaderTagLib::ParseTag(ID3v2::Tag *id3v2, EmbeddedArt *art, MUSIC_INFO:
     if (picture)
     {
       std::string  mime =            picture->mimeType().to8Bit(true);
-      TagLib::uint size =            picture->picture().size();
-      tag.SetCoverArtInfo(size, mime);
-      if (art)
-        art->Set(reinterpret_cast<const uint8_t*>(picture->picture().data()), size, mime);
+      SetCoverArt(tag, art, picture->picture(), mime);
 
       // Stop after we find the first picture for now.
       break;
@@ -614,9 +618,7 @@ bool CTagLoaderTagLib::ParseTag(APE::Tag *ape, EmbeddedArt *art, CMusicInfoTag&
         mime = "image/bmp";
       if ((offset > 0) && (offset <= tdata.size()) && (mime.size() > 0))
       {
-        tag.SetCoverArtInfo(bv.size(), mime);
-        if (art)
-          art->Set(reinterpret_cast<const uint8_t*>(bv.data()), bv.size(), mime);
+        SetCoverArt(tag, art, bv, mime);
       }
     }
     else if (CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_logLevel == LOG_LEVEL_MAX)
@@ -789,10 +791,7 @@ bool CTagLoaderTagLib::ParseTag(Ogg::XiphComment *xiph, EmbeddedArt *art, CMusic
       std::string mime = pictures[i].mimeType().toCString();
       if (mime.compare(0, 6, "image/") != 0)
         continue;
-      TagLib::uint size =            pictures[i].data().size();
-      tag.SetCoverArtInfo(size, mime);
-      if (art)
-        art->Set(reinterpret_cast<const uint8_t*>(pictures[i].data().data()), size, mime);
+      SetCoverArt(tag, art, pictures[i].data(), mime);
 
       break;
     }
@@ -812,9 +811,7 @@ bool CTagLoaderTagLib::ParseTag(Ogg::XiphComment *xiph, EmbeddedArt *art, CMusic
   {
     if (c)
     {
-      tag.SetCoverArtInfo(c->data().size(), c->mimeType().to8Bit(true));
-      if (art)
-        art->Set(reinterpret_cast<const uint8_t*>(c->data().data()), c->data().size(), c->mimeType().to8Bit(true));
+      SetCoverArt(tag, art, c->data(), c->mimeType().to8Bit(true));
       break; // one is enough
     }
   }
@@ -943,9 +940,7 @@ bool CTagLoaderTagLib::ParseTag(MP4::Tag *mp4, EmbeddedArt *art, CMusicInfoTag&
         }
         if (mime.empty())
           continue;
-        tag.SetCoverArtInfo(pt->data().size(), mime);
-        if (art)
-          art->Set(reinterpret_cast<const uint8_t *>(pt->data().data()), pt->data().size(), mime);
+        SetCoverArt(tag, art, pt->data(), mime);
         break; // one is enough
       }
     }
@@ -0,0 +1,96 @@
+/*
+ *  Copyright (C) 2023 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "FileItem.h"
+#include "music/tags/MusicInfoTag.h"
+#include "music/tags/MusicTagReader.h"
+#include "threads/Event.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace MUSIC_INFO;
+using namespace std::chrono_literals;
+
+namespace
+{
+std::vector<CFileItemPtr> CreateItems(int count)
+{
+  std::vector<CFileItemPtr> items;
+  for (int i = 0; i < count; ++i)
+    items.emplace_back(std::make_shared<CFileItem>("/music/" + std::to_string(i) + ".mp3", false));
+  return items;
+}
+} // unnamed namespace
+
+TEST(TestMusicTagReader, ReadsAllItems)
+{
+  const std::vector<CFileItemPtr> items = CreateItems(20);
+  std::atomic<int> reads{0};
+  std::atomic<int> running{0};
+  std::atomic<int> maxRunning{0};
+
+  CMusicTagReader reader(items, 4, [&](CFileItem& item) {
+    const int current = ++running;
+    int max = maxRunning;
+    while (current > max && !maxRunning.compare_exchange_weak(max, current))
+      ;
+    // later items are read faster, so they finish before earlier ones
+    std::this_thread::sleep_for(std::chrono::milliseconds(40 - 2 * reads));
+    item.GetMusicInfoTag()->SetTitle(item.GetPath());
+    item.GetMusicInfoTag()->SetLoaded();
+    ++reads;
+    --running;
+  });
+
+  for (size_t i = 0; i < items.size(); ++i)
+  {
+    ASSERT_TRUE(reader.Wait(i, 5000ms));
+    EXPECT_TRUE(items[i]->GetMusicInfoTag()->Loaded());
+    EXPECT_EQ(items[i]->GetPath(), items[i]->GetMusicInfoTag()->GetTitle());
+  }
+  EXPECT_EQ(20, reads);
+  EXPECT_LE(maxRunning, 4);
+  EXPECT_GT(maxRunning, 1);
+}
+
+TEST(TestMusicTagReader, Stop)
+{
+  const std::vector<CFileItemPtr> items = CreateItems(20);
+  std::atomic<int> reads{0};
+  CEvent release(true);
+
+  CMusicTagReader reader(items, 2, [&](CFileItem& item) {
+    release.Wait(5000ms);
+    ++reads;
+  });
+
+  EXPECT_FALSE(reader.Wait(0, 10ms));
+
+  // the readers finish the items they are reading, but don't start any others
+  std::thread releaser([&release] {
+    std::this_thread::sleep_for(50ms);
+    release.Set();
+  });
+  reader.Stop();
+  releaser.join();
+  EXPECT_EQ(2, reads);
+  EXPECT_FALSE(reader.Wait(0, 10ms));
+}
+
+TEST(TestMusicTagReader, NoItems)
+{
+  CMusicTagReader reader({}, 4, [](CFileItem& item) { FAIL(); });
+  reader.Stop();
+}
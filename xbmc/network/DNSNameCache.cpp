@@ -8,15 +8,17 @@
 
 #include "DNSNameCache.h"
 
+#include "ServiceBroker.h"
 #include "threads/CriticalSection.h"
+#include "threads/Event.h"
+#include "utils/JobManager.h"
 #include "utils/StringUtils.h"
 #include "utils/log.h"
 
 #include <mutex>
+#include <utility>
 
 #if !defined(TARGET_WINDOWS) && defined(HAS_FILESYSTEM_SMB)
-#include "ServiceBroker.h"
-
 #include "platform/posix/filesystem/SMBWSDiscovery.h"
 #endif
 
@@ -24,9 +26,28 @@
 #include <netdb.h>
 #include <netinet/in.h>
 
+using namespace std::chrono_literals;
+
+namespace
+{
+// how long callers wait for a lookup, it goes on in the background afterwards
+constexpr auto LOOKUP_TIMEOUT = 2000ms;
+// the system resolver doesn't tell the TTL of the records
+constexpr auto POSITIVE_TTL = 10min;
+constexpr auto NEGATIVE_TTL = 30s;
+} // unnamed namespace
+
+class CDNSNameCache::CLookup
+{
+public:
+  CEvent m_done{true};
+  std::string m_strIpAddress;
+};
+
 CDNSNameCache g_DNSCache;
 
 CCriticalSection CDNSNameCache::m_critical;
+CDNSNameCache::Resolver CDNSNameCache::m_resolver = CDNSNameCache::ResolveHost;
 
 CDNSNameCache::CDNSNameCache(void) = default;
 
@@ -48,24 +69,147 @@ bool CDNSNameCache::Lookup(const std::string& strHostName, std::string& strIpAdd
     return true;
   }
 
-  // check if there's a custom entry or if it's already cached
-  if(g_DNSCache.GetCached(strHostName, strIpAddress))
+  {
+    std::unique_lock<CCriticalSection> lock(m_critical);
+
+    auto it = g_DNSCache.m_dnsNames.find(strHostName);
+    if (it != g_DNSCache.m_dnsNames.end())
+    {
+      const CDNSName& dnsName = it->second;
+      const bool expired = dnsName.m_expires < std::chrono::steady_clock::now();
+      if (!dnsName.m_strIpAddress.empty())
+      {
+        // keep using the old address while it's refreshed
+        strIpAddress = dnsName.m_strIpAddress;
+        if (expired)
+        {
+          lock.unlock();
+          Prefetch(strHostName);
+        }
+        return true;
+      }
+
+      if (!expired)
+      {
+        CLog::Log(LOGDEBUG, "CDNSNameCache: lookup of '{}' failed recently", strHostName);
+        return false;
+      }
+    }
+  }
+
+  // check if there's an entry found by other means
+  if (GetCached(strHostName, strIpAddress))
     return true;
 
-  // perform dns lookup
-  struct hostent *host = gethostbyname(strHostName.c_str());
-  if (host && host->h_addr_list[0])
+  std::shared_ptr<CLookup> lookup = StartLookup(strHostName);
+  if (!lookup->m_done.Wait(LOOKUP_TIMEOUT))
   {
-    strIpAddress = StringUtils::Format("{}.{}.{}.{}", (unsigned char)host->h_addr_list[0][0],
-                                       (unsigned char)host->h_addr_list[0][1],
-                                       (unsigned char)host->h_addr_list[0][2],
-                                       (unsigned char)host->h_addr_list[0][3]);
-    g_DNSCache.Add(strHostName, strIpAddress);
-    return true;
+    CLog::Log(LOGERROR, "Timeout looking up host: '{}'", strHostName);
+    return false;
   }
 
-  CLog::Log(LOGERROR, "Unable to lookup host: '{}'", strHostName);
-  return false;
+  if (lookup->m_strIpAddress.empty())
+  {
+    CLog::Log(LOGERROR, "Unable to lookup host: '{}'", strHostName);
+    return false;
+  }
+
+  strIpAddress = lookup->m_strIpAddress;
+  return true;
+}
+
+void CDNSNameCache::Prefetch(const std::string& strHostName)
+{
+  if (strHostName.empty() || inet_addr(strHostName.c_str()) != INADDR_NONE)
+    return;
+
+  {
+    std::unique_lock<CCriticalSection> lock(m_critical);
+    auto it = g_DNSCache.m_dnsNames.find(strHostName);
+    if (it != g_DNSCache.m_dnsNames.end() &&
+        it->second.m_expires >= std::chrono::steady_clock::now())
+      return;
+  }
+
+  StartLookup(strHostName);
+}
+
+std::shared_ptr<CDNSNameCache::CLookup> CDNSNameCache::StartLookup(const std::string& strHostName)
+{
+  std::shared_ptr<CLookup> lookup;
+  {
+    std::unique_lock<CCriticalSection> lock(m_critical);
+
+    // join a lookup of the same host which is already running
+    auto it = g_DNSCache.m_lookups.find(strHostName);
+    if (it != g_DNSCache.m_lookups.end())
+      return it->second;
+
+    lookup = std::make_shared<CLookup>();
+    g_DNSCache.m_lookups.insert(std::make_pair(strHostName, lookup));
+  }
+
+  auto resolve = [strHostName, lookup]() { Resolve(strHostName, lookup); };
+
+  // resolve right away if there are no jobs (yet), e.g. while starting or stopping. The
+  // lookup may block for the whole resolver timeout, so it gets its own worker instead of
+  // holding one of the few shared ones.
+  std::shared_ptr<CJobManager> jobManager = CServiceBroker::GetJobManager();
+  if (!jobManager ||
+      jobManager->AddJob(new CLambdaJob<decltype(resolve)>(std::move(resolve)), nullptr,
+                         CJob::PRIORITY_DEDICATED) == 0)
+    Resolve(strHostName, lookup);
+
+  return lookup;
+}
+
+void CDNSNameCache::Resolve(const std::string& strHostName, const std::shared_ptr<CLookup>& lookup)
+{
+  CDNSName dnsName;
+  dnsName.m_strHostName = strHostName;
+  dnsName.m_strIpAddress = m_resolver(strHostName);
+  dnsName.m_expires = std::chrono::steady_clock::now() +
+                      (dnsName.m_strIpAddress.empty() ? NEGATIVE_TTL : POSITIVE_TTL);
+
+  std::unique_lock<CCriticalSection> lock(m_critical);
+  auto it = g_DNSCache.m_dnsNames.find(strHostName);
+  // custom entries are never replaced
+  if (it == g_DNSCache.m_dnsNames.end() ||
+      it->second.m_expires != std::chrono::steady_clock::time_point::max())
+  {
+    // a failed refresh doesn't throw away an address which used to work
+    if (it != g_DNSCache.m_dnsNames.end() && dnsName.m_strIpAddress.empty() &&
+        !it->second.m_strIpAddress.empty())
+      dnsName.m_strIpAddress = it->second.m_strIpAddress;
+
+    g_DNSCache.m_dnsNames[strHostName] = dnsName;
+  }
+
+  g_DNSCache.m_lookups.erase(strHostName);
+  lookup->m_strIpAddress = dnsName.m_strIpAddress;
+  lookup->m_done.Set();
+}
+
+std::string CDNSNameCache::ResolveHost(const std::string& strHostName)
+{
+  std::string strIpAddress;
+
+  struct addrinfo hints = {};
+  hints.ai_family = AF_INET;
+  hints.ai_socktype = SOCK_STREAM;
+
+  struct addrinfo* result = nullptr;
+  if (getaddrinfo(strHostName.c_str(), nullptr, &hints, &result) == 0 && result)
+  {
+    char address[INET_ADDRSTRLEN];
+    const struct sockaddr_in* addr = reinterpret_cast<const sockaddr_in*>(result->ai_addr);
+    if (inet_ntop(AF_INET, &addr->sin_addr, address, sizeof(address)))
+      strIpAddress = address;
+  }
+  if (result)
+    freeaddrinfo(result);
+
+  return strIpAddress;
 }
 
 bool CDNSNameCache::GetCached(const std::string& strHostName, std::string& strIpAddress)
@@ -73,14 +217,12 @@ bool CDNSNameCache::GetCached(const std::string& strHostName, std::string& strIp
   {
     std::unique_lock<CCriticalSection> lock(m_critical);
 
-    // loop through all DNSname entries and see if strHostName is cached
-    for (const auto& DNSname : g_DNSCache.m_vecDNSNames)
+    // see if strHostName is cached, expired entries are still better than nothing
+    auto it = g_DNSCache.m_dnsNames.find(strHostName);
+    if (it != g_DNSCache.m_dnsNames.end() && !it->second.m_strIpAddress.empty())
     {
-      if (DNSname.m_strHostName == strHostName)
-      {
-        strIpAddress = DNSname.m_strIpAddress;
-        return true;
-      }
+      strIpAddress = it->second.m_strIpAddress;
+      return true;
     }
   }
 
@@ -107,8 +249,8 @@ void CDNSNameCache::Add(const std::string& strHostName, const std::string& strIp
 
   dnsName.m_strHostName = strHostName;
   dnsName.m_strIpAddress  = strIpAddress;
+  dnsName.m_expires = std::chrono::steady_clock::time_point::max();
 
   std::unique_lock<CCriticalSection> lock(m_critical);
-  g_DNSCache.m_vecDNSNames.push_back(dnsName);
+  g_DNSCache.m_dnsNames[strHostName] = dnsName;
 }
-
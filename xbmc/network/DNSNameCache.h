@@ -8,11 +8,22 @@
 
 #pragma once
 
+#include <chrono>
+#include <map>
+#include <memory>
 #include <string>
-#include <vector>
 
 class CCriticalSection;
 
+/*!
+ \brief Cache of resolved host names.
+
+ Lookups are done in the background and are shared by all callers asking for the same
+ host. Callers only wait a limited time for the result, so that an unreachable name
+ server or an unknown host don't block them (often the GUI) for the whole resolver
+ timeout. Resolved addresses are kept for a while and refreshed in the background once
+ they get old, failed lookups are remembered for a shorter time.
+ */
 class CDNSNameCache
 {
 public:
@@ -20,15 +31,38 @@ public:
   {
   public:
     std::string m_strHostName;
-    std::string m_strIpAddress;
+    std::string m_strIpAddress; ///< empty if the host couldn't be resolved
+    std::chrono::steady_clock::time_point m_expires; ///< max() for custom entries
   };
   CDNSNameCache(void);
   virtual ~CDNSNameCache(void);
+  /*!
+   \brief Add a custom entry, e.g. from the <hosts> section of advancedsettings.xml, which
+   never expires
+   */
   static void Add(const std::string& strHostName, const std::string& strIpAddress);
   static bool GetCached(const std::string& strHostName, std::string& strIpAddress);
   static bool Lookup(const std::string& strHostName, std::string& strIpAddress);
+  /*!
+   \brief Start resolving a host in the background if it isn't cached yet
+   */
+  static void Prefetch(const std::string& strHostName);
 
 protected:
+  class CLookup;
+  using Resolver = std::string (*)(const std::string& strHostName);
+
+  static std::shared_ptr<CLookup> StartLookup(const std::string& strHostName);
+  static void Resolve(const std::string& strHostName, const std::shared_ptr<CLookup>& lookup);
+  /*!
+   \brief Resolve a host with the system resolver
+   \return the ip address, empty if the host couldn't be resolved
+   */
+  static std::string ResolveHost(const std::string& strHostName);
+
+  static Resolver m_resolver; ///< ResolveHost(), can be replaced by tests
+
   static CCriticalSection m_critical;
-  std::vector<CDNSName> m_vecDNSNames;
+  std::map<std::string, CDNSName> m_dnsNames;
+  std::map<std::string, std::shared_ptr<CLookup>> m_lookups;
 };
@@ -30,6 +30,32 @@
 using namespace EVENTCLIENT;
 using namespace EVENTPACKET;
 
+namespace
+{
+// log the time from the arrival of the packet until its event is handed to the input manager,
+// only once per event as repeats are delayed on purpose
+void LogDispatchLatency(const std::string& event, std::chrono::steady_clock::time_point& received)
+{
+  if (received.time_since_epoch().count() == 0)
+    return;
+
+  const auto latency = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - received);
+  CLog::Log(LOGDEBUG, "ES: {} dispatched {} ms after it was received", event, latency.count());
+  received = {};
+}
+
+void LogDispatchLatency(CEventButtonState& state)
+{
+  if (state.m_received.time_since_epoch().count() == 0)
+    return;
+
+  LogDispatchLatency(state.m_buttonName.empty() ? StringUtils::Format("button {}", state.m_iKeyCode)
+                                                 : "button " + state.m_buttonName,
+                     state.m_received);
+}
+} // unnamed namespace
+
 struct ButtonStateFinder
 {
   explicit ButtonStateFinder(const CEventButtonState& state)
@@ -166,6 +192,7 @@ bool CEventClient::GetNextAction(CEventAction &action)
     // grab the next action in line
     action = m_actionQueue.front();
     m_actionQueue.pop();
+    LogDispatchLatency("action " + action.actionName, action.received);
     return true;
   }
   else
@@ -384,6 +411,7 @@ bool CEventClient::OnPacketBUTTON(CEventPacket *packet)
                              (flags & (PTB_AXIS|PTB_AXISSINGLE)) ? true  : false,
                              (flags & PTB_NO_REPEAT)             ? false : true,
                              (flags & PTB_USE_AMOUNT)            ? true : false );
+    state.m_received = packet->Received();
 
     /* correct non active events so they work with rest of code */
     if(!active)
@@ -456,6 +484,7 @@ bool CEventClient::OnPacketBUTTON(CEventPacket *packet)
       m_currentButton.m_bRepeat    = (flags & PTB_NO_REPEAT)  ? false : true;
       m_currentButton.m_bAxis      = (flags & PTB_AXIS)       ? true : false;
       m_currentButton.m_iNextRepeat = {};
+      m_currentButton.m_received = packet->Received();
       m_currentButton.SetActive();
       m_currentButton.Load();
     }
@@ -611,6 +640,7 @@ bool CEventClient::OnPacketACTION(CEventPacket *packet)
     {
       std::unique_lock<CCriticalSection> lock(m_critSection);
       m_actionQueue.push(CEventAction(actionString.c_str(), actionType));
+      m_actionQueue.back().received = packet->Received();
     }
     break;
 
@@ -706,6 +736,8 @@ unsigned int CEventClient::GetButtonCode(std::string& strMapName, bool& isAxis,
       if ( ! CheckButtonRepeat(m_currentButton.m_iNextRepeat) )
         bcode = 0;
     }
+    if (bcode)
+      LogDispatchLatency(m_currentButton);
     return bcode;
   }
 
@@ -734,6 +766,8 @@ unsigned int CEventClient::GetButtonCode(std::string& strMapName, bool& isAxis,
     {
       /* MUST update m_iNextRepeat before resend */
       bool skip = !it->Axis() && !CheckButtonRepeat(it->m_iNextRepeat);
+      if (!skip && bcode)
+        LogDispatchLatency(*it);
 
       repeat.push_back(*it);
       if(skip)
@@ -742,6 +776,8 @@ unsigned int CEventClient::GetButtonCode(std::string& strMapName, bool& isAxis,
         continue;
       }
     }
+    else if (bcode)
+      LogDispatchLatency(*it);
   }
 
   m_buttonQueue.erase(m_buttonQueue.begin(), it);
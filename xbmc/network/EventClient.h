@@ -42,6 +42,7 @@ namespace EVENTCLIENT
 
     std::string    actionName;
     unsigned char  actionType;
+    std::chrono::steady_clock::time_point received;
   };
 
   class CEventButtonState
@@ -104,6 +105,7 @@ namespace EVENTCLIENT
     bool              m_bActive;
     bool              m_bAxis;
     std::chrono::time_point<std::chrono::steady_clock> m_iNextRepeat;
+    std::chrono::steady_clock::time_point m_received; // reset once the press was dispatched
   };
 
 
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <cstdint>
 #include <stdlib.h>
 #include <vector>
@@ -210,6 +211,9 @@ namespace EVENTPACKET
     unsigned int PayloadSize() const { return m_pPayload.size(); }
     unsigned int ClientToken() const { return m_iClientToken; }
     void SetPayload(std::vector<uint8_t> payload);
+    // time the packet arrived, used to measure how long its event waits for the input manager
+    std::chrono::steady_clock::time_point Received() const { return m_received; }
+    void SetReceived(std::chrono::steady_clock::time_point received) { m_received = received; }
 
   protected:
     bool m_bValid{false};
@@ -221,6 +225,7 @@ namespace EVENTPACKET
     unsigned char m_cMajVer{'0'};
     unsigned char m_cMinVer{'0'};
     PacketType m_eType{PT_LAST};
+    std::chrono::steady_clock::time_point m_received;
   };
 
 }
@@ -32,6 +32,13 @@ using namespace EVENTCLIENT;
 using namespace SOCKETS;
 using namespace std::chrono_literals;
 
+namespace
+{
+// datagrams read per wakeup, a remote sending bursts (e.g. held buttons or mouse moves) is
+// drained without going through select() for every packet
+constexpr size_t MAX_DATAGRAMS = 32;
+} // unnamed namespace
+
 /************************************************************************/
 /* CEventServer                                                         */
 /************************************************************************/
@@ -116,7 +123,6 @@ void CEventServer::Process()
 void CEventServer::Run()
 {
   CSocketListener listener;
-  int packetSize = 0;
 
   CLog::Log(LOGINFO, "ES: Starting UDP Event server on port {}", m_iPort);
 
@@ -130,7 +136,9 @@ void CEventServer::Run()
     return;
   }
 
-  m_pPacketBuffer.resize(PACKET_SIZE);
+  m_datagrams.resize(MAX_DATAGRAMS);
+  for (auto& datagram : m_datagrams)
+    datagram.buffer.resize(PACKET_SIZE);
 
   // bind to IP and start listening on port
   const std::shared_ptr<CSettings> settings = CServiceBroker::GetSettingsComponent()->GetSettings();
@@ -166,10 +174,12 @@ void CEventServer::Run()
       // start listening until we timeout
       if (listener.Listen(m_iListenTimeout))
       {
-        CAddress addr;
-        if ((packetSize = m_pSocket->Read(addr, PACKET_SIZE, m_pPacketBuffer.data())) > -1)
+        const int count = m_pSocket->ReadBatch(m_datagrams);
+        const auto received = std::chrono::steady_clock::now();
+        for (int i = 0; i < count; i++)
         {
-          ProcessPacket(addr, packetSize);
+          CUDPSocket::CDatagram& datagram = m_datagrams[i];
+          ProcessPacket(datagram.addr, datagram.buffer.data(), datagram.size, received);
         }
       }
     }
@@ -194,11 +204,13 @@ void CEventServer::Run()
   Cleanup();
 }
 
-void CEventServer::ProcessPacket(CAddress& addr, int pSize)
+void CEventServer::ProcessPacket(CAddress& addr,
+                                 const uint8_t* data,
+                                 int pSize,
+                                 std::chrono::steady_clock::time_point received)
 {
   // check packet validity
-  std::unique_ptr<CEventPacket> packet =
-      std::make_unique<CEventPacket>(pSize, m_pPacketBuffer.data());
+  std::unique_ptr<CEventPacket> packet = std::make_unique<CEventPacket>(pSize, data);
   if (!packet)
   {
     CLog::Log(LOGERROR, "ES: Out of memory, cannot accept packet");
@@ -213,6 +225,8 @@ void CEventServer::ProcessPacket(CAddress& addr, int pSize)
     return;
   }
 
+  packet->SetReceived(received);
+
   clientToken = packet->ClientToken();
   if (!clientToken)
     clientToken = addr.ULong(); // use IP if packet doesn't have a token
@@ -14,6 +14,7 @@
 #include "threads/Thread.h"
 
 #include <atomic>
+#include <chrono>
 #include <map>
 #include <mutex>
 #include <queue>
@@ -61,7 +62,10 @@ namespace EVENTSERVER
   protected:
     void Cleanup();
     void Run();
-    void ProcessPacket(SOCKETS::CAddress& addr, int packetSize);
+    void ProcessPacket(SOCKETS::CAddress& addr,
+                       const uint8_t* data,
+                       int packetSize,
+                       std::chrono::steady_clock::time_point received);
     void ProcessEvents();
     void RefreshClients();
 
@@ -71,7 +75,7 @@ namespace EVENTSERVER
     int              m_iPort;
     int              m_iListenTimeout;
     int              m_iMaxClients;
-    std::vector<uint8_t> m_pPacketBuffer;
+    std::vector<SOCKETS::CUDPSocket::CDatagram> m_datagrams;
     std::atomic<bool> m_bRunning = false;
     CCriticalSection m_critSection;
     bool             m_bRefreshSettings;
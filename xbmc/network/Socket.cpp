@@ -13,6 +13,7 @@
 #include "utils/ScopeGuard.h"
 #include "utils/log.h"
 
+#include <algorithm>
 #include <vector>
 
 using namespace SOCKETS;
@@ -209,6 +210,46 @@ int CPosixUDPSocket::Read(CAddress& addr, const int buffersize, void *buffer)
                        (struct sockaddr*)&addr.saddr, &addr.size);
 }
 
+int CPosixUDPSocket::ReadBatch(std::vector<CDatagram>& datagrams)
+{
+  if (datagrams.empty())
+    return 0;
+
+#if defined(TARGET_LINUX) || defined(TARGET_ANDROID)
+  // fetch everything that is queued with a single call
+  constexpr size_t MAX_BATCH = 64;
+  const size_t count = std::min(datagrams.size(), MAX_BATCH);
+  mmsghdr msgs[MAX_BATCH] = {};
+  iovec iovs[MAX_BATCH];
+
+  for (size_t i = 0; i < count; ++i)
+  {
+    CDatagram& datagram = datagrams[i];
+    iovs[i].iov_base = datagram.buffer.data();
+    iovs[i].iov_len = datagram.buffer.size();
+    msgs[i].msg_hdr.msg_name = &datagram.addr.saddr;
+    msgs[i].msg_hdr.msg_namelen = sizeof(datagram.addr.saddr);
+    msgs[i].msg_hdr.msg_iov = &iovs[i];
+    msgs[i].msg_hdr.msg_iovlen = 1;
+  }
+
+  const int received = recvmmsg(m_iSock, msgs, count, MSG_DONTWAIT, nullptr);
+  if (received < 0)
+    return (errno == EAGAIN || errno == EWOULDBLOCK) ? 0 : -1;
+
+  for (int i = 0; i < received; ++i)
+  {
+    datagrams[i].addr.size = msgs[i].msg_hdr.msg_namelen;
+    datagrams[i].size = static_cast<int>(msgs[i].msg_len);
+  }
+  return received;
+#else
+  CDatagram& datagram = datagrams.front();
+  datagram.size = Read(datagram.addr, datagram.buffer.size(), datagram.buffer.data());
+  return datagram.size < 0 ? -1 : 1;
+#endif
+}
+
 int CPosixUDPSocket::SendTo(const CAddress& addr, const int buffersize,
                           const void *buffer)
 {
@@ -174,6 +174,18 @@ namespace SOCKETS
 
     // read datagrams, return no. of bytes read or -1 or error
     virtual int Read(CAddress& addr, const int buffersize, void *buffer) = 0;
+
+    // datagram received by ReadBatch()
+    struct CDatagram
+    {
+      CAddress addr;
+      std::vector<uint8_t> buffer; // sized by the caller, limits the datagram size
+      int size = 0;
+    };
+
+    // read the datagrams already queued on a readable socket, at most datagrams.size(),
+    // return no. of datagrams read or -1 on error
+    virtual int ReadBatch(std::vector<CDatagram>& datagrams) = 0;
     virtual bool Broadcast(const CAddress& addr, const int datasize,
                            const void* data) = 0;
   };
@@ -197,6 +209,7 @@ namespace SOCKETS
     bool Listen(int timeout);
     int SendTo(const CAddress& addr, const int datasize, const void* data) override;
     int Read(CAddress& addr, const int buffersize, void *buffer) override;
+    int ReadBatch(std::vector<CDatagram>& datagrams) override;
     bool Broadcast(const CAddress& addr, const int datasize, const void* data) override
     {
       //! @todo implement
@@ -55,9 +55,15 @@ using namespace JSONRPC;
 
 #define RECEIVEBUFFER 4096
 
+#if !defined(MSG_DONTWAIT)
+#define MSG_DONTWAIT 0
+#endif
+
 namespace
 {
 constexpr size_t maxBufferLength = 64 * 1024;
+// announcements for clients that don't keep up with them are dropped once that much is pending
+constexpr size_t maxPendingLength = 1024 * 1024;
 }
 
 CTCPServer *CTCPServer::ServerInstance = NULL;
@@ -112,8 +118,10 @@ void CTCPServer::Process()
   {
     SOCKET          max_fd = 0;
     fd_set          rfds;
+    fd_set          wfds;
     struct timeval  to     = {1, 0};
     FD_ZERO(&rfds);
+    FD_ZERO(&wfds);
 
     for (auto& it : m_servers)
     {
@@ -125,11 +133,13 @@ void CTCPServer::Process()
     for (unsigned int i = 0; i < m_connections.size(); i++)
     {
       FD_SET(m_connections[i]->m_socket, &rfds);
+      if (m_connections[i]->GetPendingLength() > 0)
+        FD_SET(m_connections[i]->m_socket, &wfds);
       if ((intptr_t)m_connections[i]->m_socket > (intptr_t)max_fd)
         max_fd = m_connections[i]->m_socket;
     }
 
-    int res = select((intptr_t)max_fd+1, &rfds, NULL, NULL, &to);
+    int res = select((intptr_t)max_fd+1, &rfds, &wfds, NULL, &to);
     if (res < 0)
     {
       CLog::Log(LOGERROR, "JSONRPC Server: Select failed");
@@ -138,6 +148,12 @@ void CTCPServer::Process()
     }
     else if (res > 0)
     {
+      for (auto& connection : m_connections)
+      {
+        if (FD_ISSET(connection->m_socket, &wfds))
+          connection->SendPending();
+      }
+
       for (int i = m_connections.size() - 1; i >= 0; i--)
       {
         int socket = m_connections[i]->m_socket;
@@ -248,6 +264,16 @@ void CTCPServer::Announce(ANNOUNCEMENT::AnnouncementFlag flag,
       std::unique_lock<CCriticalSection> lock(m_connections[i]->m_critSection);
       if ((m_connections[i]->GetAnnouncementFlags() & flag) == 0)
         continue;
+
+      // don't let a client that stopped reading hold up the others or grow without bounds
+      if (m_connections[i]->GetPendingLength() > maxPendingLength)
+      {
+        if (!m_connections[i]->m_dropping)
+          CLog::Log(LOGWARNING, "JSONRPC Server: Client is too slow, dropping announcements");
+        m_connections[i]->m_dropping = true;
+        continue;
+      }
+      m_connections[i]->m_dropping = false;
     }
 
     m_connections[i]->Send(str.c_str(), str.size());
@@ -543,12 +569,39 @@ bool CTCPServer::CTCPClient::SetAnnouncementFlags(int flags)
 
 void CTCPServer::CTCPClient::Send(const char *data, unsigned int size)
 {
-  unsigned int sent = 0;
-  do
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  m_sendBuffer.append(data, size);
+  SendPending();
+}
+
+void CTCPServer::CTCPClient::SendPending()
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  size_t sent = 0;
+  while (sent < m_sendBuffer.size())
   {
-    std::unique_lock<CCriticalSection> lock(m_critSection);
-    sent += send(m_socket, data + sent, size - sent, 0);
-  } while (sent < size);
+    ssize_t res = send(m_socket, m_sendBuffer.data() + sent, m_sendBuffer.size() - sent,
+                       MSG_DONTWAIT);
+    if (res > 0)
+      sent += res;
+    else if (res < 0 && errno == EINTR)
+      continue;
+    else if (res < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+      break; // the rest is sent once the socket is writable again
+    else
+    {
+      // the connection is broken, the disconnection is detected when receiving
+      m_sendBuffer.clear();
+      return;
+    }
+  }
+  m_sendBuffer.erase(0, sent);
+}
+
+size_t CTCPServer::CTCPClient::GetPendingLength()
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  return m_sendBuffer.size();
 }
 
 void CTCPServer::CTCPClient::PushBuffer(CTCPServer *host, const char *buffer, int length)
@@ -646,6 +699,8 @@ void CTCPServer::CTCPClient::Copy(const CTCPClient& client)
   m_beginChar         = client.m_beginChar;
   m_endChar           = client.m_endChar;
   m_buffer            = client.m_buffer;
+  m_sendBuffer        = client.m_sendBuffer;
+  m_dropping          = client.m_dropping;
 }
 
 CTCPServer::CWebSocketClient::CWebSocketClient(CWebSocket *websocket)
@@ -693,6 +748,8 @@ void CTCPServer::CWebSocketClient::Send(const char *data, unsigned int size)
   std::vector<const CWebSocketFrame *> frames = msg->GetFrames();
   for (unsigned int index = 0; index < frames.size(); index++)
     CTCPClient::Send(frames.at(index)->GetFrameData(), (unsigned int)frames.at(index)->GetFrameLength());
+
+  delete msg;
 }
 
 void CTCPServer::CWebSocketClient::PushBuffer(CTCPServer *host, const char *buffer, int length)
@@ -718,8 +775,9 @@ void CTCPServer::CWebSocketClient::PushBuffer(CTCPServer *host, const char *buff
       std::vector<const CWebSocketFrame *> frames = msg->GetFrames();
       if (send)
       {
+        // control frames are already framed, they must not be wrapped in a text message
         for (unsigned int index = 0; index < frames.size(); index++)
-          Send(frames.at(index)->GetFrameData(), (unsigned int)frames.at(index)->GetFrameLength());
+          CTCPClient::Send(frames.at(index)->GetFrameData(), (unsigned int)frames.at(index)->GetFrameLength());
       }
       else
       {
@@ -747,7 +805,7 @@ void CTCPServer::CWebSocketClient::Disconnect()
     {
       const CWebSocketFrame *closeFrame = m_websocket->Close();
       if (closeFrame)
-        Send(closeFrame->GetFrameData(), (unsigned int)closeFrame->GetFrameLength());
+        CTCPClient::Send(closeFrame->GetFrameData(), (unsigned int)closeFrame->GetFrameLength());
     }
 
     if (m_websocket->GetState() == WebSocketStateClosed)
@@ -66,6 +66,11 @@ namespace JSONRPC
 
       virtual void Send(const char *data, unsigned int size);
       virtual void PushBuffer(CTCPServer *host, const char *buffer, int length);
+      /*!
+       \brief Send as much of the data that couldn't be sent yet as the socket accepts
+       */
+      void SendPending();
+      size_t GetPendingLength();
       virtual void Disconnect();
 
       virtual bool IsNew() const { return m_new; }
@@ -75,6 +80,7 @@ namespace JSONRPC
       sockaddr_storage m_cliaddr;
       socklen_t m_addrlen;
       CCriticalSection m_critSection;
+      bool m_dropping = false; ///< whether announcements are dropped because too much is pending
 
     protected:
       void Copy(const CTCPClient& client);
@@ -84,6 +90,7 @@ namespace JSONRPC
       int m_beginBrackets, m_endBrackets;
       char m_beginChar, m_endChar;
       std::string m_buffer;
+      std::string m_sendBuffer;
     };
 
     class CWebSocketClient : public CTCPClient
@@ -10,10 +10,13 @@
 
 #include "CompileInfo.h"
 #include "ServiceBroker.h"
+#include "URL.h"
 #include "XBDateTime.h"
 #include "filesystem/File.h"
+#include "filesystem/SpecialProtocol.h"
 #include "network/httprequesthandler/HTTPRequestHandlerUtils.h"
 #include "network/httprequesthandler/IHTTPRequestHandler.h"
+#include "settings/AdvancedSettings.h"
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
 #include "utils/FileUtils.h"
@@ -30,12 +33,18 @@
 #include <utility>
 
 #if defined(TARGET_POSIX)
+#include <fcntl.h>
 #include <pthread.h>
+#include <unistd.h>
+
+#include <sys/stat.h>
 #endif
 
 #include <inttypes.h>
 
 #define MAX_POST_BUFFER_SIZE 2048
+// size of the reads from files that can't be sent from a file descriptor
+#define FILE_DOWNLOAD_BLOCK_SIZE (64 * 1024)
 
 #define PAGE_FILE_NOT_FOUND \
   "<html><head><title>File not found</title></head><body>File not found</body></html>"
@@ -169,7 +178,10 @@ MHD_RESULT CWebServer::AnswerToConnection(void* cls,
                          version,   {}};
 
   if (connectionHandler->isNew)
+  {
+    webServer->AddRequest(connection);
     webServer->LogRequest(request);
+  }
 
   return webServer->HandlePartialRequest(connection, connectionHandler, request, upload_data,
                                          upload_data_size, con_cls);
@@ -209,6 +221,15 @@ MHD_RESULT CWebServer::HandlePartialRequest(struct MHD_Connection* connection,
         {
           bool cacheable = IsRequestCacheable(request);
 
+          // handle If-None-Match which takes precedence over If-Modified-Since
+          std::string entityTag;
+          handler->GetEntityTag(entityTag);
+          std::string ifNoneMatch = HTTPRequestHandlerUtils::GetRequestHeaderValue(
+              connection, MHD_HEADER_KIND, MHD_HTTP_HEADER_IF_NONE_MATCH);
+          if (cacheable && !ifNoneMatch.empty() &&
+              HTTPRequestHandlerUtils::MatchesEntityTag(ifNoneMatch, entityTag, true))
+            return SendNotModified(handler);
+
           CDateTime lastModified;
           if (handler->GetLastModifiedDate(lastModified) && lastModified.IsValid())
           {
@@ -221,18 +242,10 @@ MHD_RESULT CWebServer::HandlePartialRequest(struct MHD_Connection* connection,
             CDateTime ifModifiedSinceDate;
             CDateTime ifUnmodifiedSinceDate;
             // handle If-Modified-Since (but only if the response is cacheable)
-            if (cacheable && ifModifiedSinceDate.SetFromRFC1123DateTime(ifModifiedSince) &&
+            if (cacheable && ifNoneMatch.empty() &&
+                ifModifiedSinceDate.SetFromRFC1123DateTime(ifModifiedSince) &&
                 lastModified.GetAsUTCDateTime() <= ifModifiedSinceDate)
-            {
-              struct MHD_Response* response = create_response(0, nullptr, MHD_NO, MHD_NO);
-              if (response == nullptr)
-              {
-                m_logger->error("failed to create a HTTP 304 response");
-                return MHD_NO;
-              }
-
-              return FinalizeRequest(handler, MHD_HTTP_NOT_MODIFIED, response);
-            }
+              return SendNotModified(handler);
             // handle If-Unmodified-Since
             else if (ifUnmodifiedSinceDate.SetFromRFC1123DateTime(ifUnmodifiedSince) &&
                      lastModified.GetAsUTCDateTime() > ifUnmodifiedSinceDate)
@@ -240,7 +253,7 @@ MHD_RESULT CWebServer::HandlePartialRequest(struct MHD_Connection* connection,
           }
 
           // pass the requested ranges on to the request handler
-          handler->SetRequestRanged(IsRequestRanged(request, lastModified));
+          handler->SetRequestRanged(IsRequestRanged(request, lastModified, entityTag));
         }
       }
       // if we got a POST request we need to take care of the POST data
@@ -325,6 +338,21 @@ MHD_RESULT CWebServer::HandleRequest(const std::shared_ptr<IHTTPRequestHandler>&
   if (handler == nullptr)
     return MHD_NO;
 
+  const auto start = std::chrono::steady_clock::now();
+  const MHD_RESULT ret = ProcessRequest(handler);
+  const auto time = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start);
+  AddHandlerTime(time);
+
+  if (CServiceBroker::GetLogging().CanLogComponent(LOGWEBSERVER))
+    m_logger->debug("[OUT] {} handled in {} us with {} active connections",
+                    handler->GetRequest().pathUrl, time.count(), m_activeConnections.load());
+
+  return ret;
+}
+
+MHD_RESULT CWebServer::ProcessRequest(const std::shared_ptr<IHTTPRequestHandler>& handler)
+{
   HTTPRequest request = handler->GetRequest();
   MHD_RESULT ret = handler->HandleRequest();
   if (ret == MHD_NO)
@@ -375,6 +403,18 @@ MHD_RESULT CWebServer::HandleRequest(const std::shared_ptr<IHTTPRequestHandler>&
   return FinalizeRequest(handler, responseDetails.status, response);
 }
 
+MHD_RESULT CWebServer::SendNotModified(const std::shared_ptr<IHTTPRequestHandler>& handler)
+{
+  struct MHD_Response* response = create_response(0, nullptr, MHD_NO, MHD_NO);
+  if (response == nullptr)
+  {
+    m_logger->error("failed to create a HTTP 304 response");
+    return MHD_NO;
+  }
+
+  return FinalizeRequest(handler, MHD_HTTP_NOT_MODIFIED, response);
+}
+
 MHD_RESULT CWebServer::FinalizeRequest(const std::shared_ptr<IHTTPRequestHandler>& handler,
                                        int responseStatus,
                                        struct MHD_Response* response)
@@ -394,6 +434,11 @@ MHD_RESULT CWebServer::FinalizeRequest(const std::shared_ptr<IHTTPRequestHandler
   if (handler->GetLastModifiedDate(lastModified) && lastModified.IsValid())
     handler->AddResponseHeader(MHD_HTTP_HEADER_LAST_MODIFIED, lastModified.GetAsRFC1123DateTime());
 
+  // if the request handler has set an entity tag and it hasn't been set as a header, add it
+  std::string entityTag;
+  if (handler->CanBeCached() && handler->GetEntityTag(entityTag) && !entityTag.empty())
+    handler->AddResponseHeader(MHD_HTTP_HEADER_ETAG, entityTag);
+
   // check if the request handler has set Cache-Control and add it if not
   if (!handler->HasResponseHeader(MHD_HTTP_HEADER_CACHE_CONTROL))
   {
@@ -485,7 +530,9 @@ bool CWebServer::IsRequestCacheable(const HTTPRequest& request) const
   return true;
 }
 
-bool CWebServer::IsRequestRanged(const HTTPRequest& request, const CDateTime& lastModified) const
+bool CWebServer::IsRequestRanged(const HTTPRequest& request,
+                                 const CDateTime& lastModified,
+                                 const std::string& entityTag) const
 {
   // parse the Range header and store it in the request object
   CHttpRanges ranges;
@@ -493,11 +540,17 @@ bool CWebServer::IsRequestRanged(const HTTPRequest& request, const CDateTime& la
       request.connection, MHD_HEADER_KIND, MHD_HTTP_HEADER_RANGE));
 
   // handle If-Range header but only if the Range header is present
-  if (ranged && lastModified.IsValid())
+  if (ranged && (lastModified.IsValid() || !entityTag.empty()))
   {
     std::string ifRange = HTTPRequestHandlerUtils::GetRequestHeaderValue(
         request.connection, MHD_HEADER_KIND, MHD_HTTP_HEADER_IF_RANGE);
-    if (!ifRange.empty() && lastModified.IsValid())
+    // If-Range either contains an entity tag (which must match strongly) or a date
+    if (StringUtils::StartsWith(ifRange, "\"") || StringUtils::StartsWith(ifRange, "W/"))
+    {
+      if (!HTTPRequestHandlerUtils::MatchesEntityTag(ifRange, entityTag, false))
+        ranges.Clear();
+    }
+    else if (!ifRange.empty() && lastModified.IsValid())
     {
       CDateTime ifRangeDate;
       ifRangeDate.SetFromRFC1123DateTime(ifRange);
@@ -887,18 +940,27 @@ MHD_RESULT CWebServer::CreateFileDownloadResponse(
   // set the initial write position
   context->ranges.GetFirstPosition(context->writePosition);
 
-  // create the response object
-  response =
-      MHD_create_response_from_callback(totalLength, 2048, &CWebServer::ContentReaderCallback,
-                                        context.get(), &CWebServer::ContentReaderFreeCallback);
+  // create the response object, local files are sent straight from their file descriptor
+  // (using sendfile() where possible) unless the ranges need multipart boundaries
+  response = nullptr;
+  if (context->rangeCountTotal == 1 && fileLength > 0)
+    response =
+        CreateFileDescriptorResponse(filePath, fileLength, context->writePosition, totalLength);
+
   if (response == nullptr)
   {
-    m_logger->error("failed to create a HTTP response for {} to be filled from{}", request.pathUrl,
-                    filePath);
-    return MHD_NO;
-  }
+    response = MHD_create_response_from_callback(totalLength, FILE_DOWNLOAD_BLOCK_SIZE,
+                                                 &CWebServer::ContentReaderCallback, context.get(),
+                                                 &CWebServer::ContentReaderFreeCallback);
+    if (response == nullptr)
+    {
+      m_logger->error("failed to create a HTTP response for {} to be filled from{}",
+                      request.pathUrl, filePath);
+      return MHD_NO;
+    }
 
-  context.release(); // ownership was passed to mhd
+    context.release(); // ownership was passed to mhd
+  }
 
   // add Content-Range header
   if (ranged)
@@ -1000,6 +1062,67 @@ void* CWebServer::UriRequestLogger(void* cls, const char* uri)
   return new ConnectionHandler(uri);
 }
 
+void CWebServer::NotifyConnection(void* cls,
+                                  struct MHD_Connection* connection,
+                                  void** socket_context,
+                                  enum MHD_ConnectionNotificationCode toe)
+{
+  CWebServer* webServer = reinterpret_cast<CWebServer*>(cls);
+  if (webServer == nullptr)
+    return;
+
+  if (toe == MHD_CONNECTION_NOTIFY_STARTED)
+  {
+    ++webServer->m_activeConnections;
+    // remember when the connection was accepted to measure how long it waits for a pool thread
+    *socket_context = new SocketContext();
+  }
+  else if (toe == MHD_CONNECTION_NOTIFY_CLOSED)
+  {
+    --webServer->m_activeConnections;
+    delete static_cast<SocketContext*>(*socket_context);
+    *socket_context = nullptr;
+  }
+}
+
+void CWebServer::AddRequest(struct MHD_Connection* connection)
+{
+  // only the first request of a connection is measured, later ones on a kept alive connection
+  // have no time of arrival
+  SocketContext* context = nullptr;
+  const MHD_ConnectionInfo* info =
+      MHD_get_connection_info(connection, MHD_CONNECTION_INFO_SOCKET_CONTEXT);
+  if (info != nullptr)
+    context = static_cast<SocketContext*>(info->socket_context);
+
+  std::unique_lock<CCriticalSection> lock(m_statisticsSection);
+  m_statistics.requests++;
+  if (context == nullptr || context->answered)
+    return;
+
+  context->answered = true;
+  const auto wait = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - context->accepted);
+  m_statistics.connections++;
+  m_statistics.queueWait += wait;
+  m_statistics.maxQueueWait = std::max(m_statistics.maxQueueWait, wait);
+}
+
+void CWebServer::AddHandlerTime(std::chrono::microseconds time)
+{
+  std::unique_lock<CCriticalSection> lock(m_statisticsSection);
+  m_statistics.handlerTime += time;
+  m_statistics.maxHandlerTime = std::max(m_statistics.maxHandlerTime, time);
+}
+
+CWebServer::Statistics CWebServer::GetStatistics() const
+{
+  std::unique_lock<CCriticalSection> lock(m_statisticsSection);
+  Statistics statistics = m_statistics;
+  statistics.activeConnections = m_activeConnections;
+  return statistics;
+}
+
 void CWebServer::LogRequest(const char* uri) const
 {
   if (uri == nullptr)
@@ -1114,6 +1237,47 @@ void CWebServer::ContentReaderFreeCallback(void* cls)
     GetLogger()->debug("[OUT] done");
 }
 
+struct MHD_Response* CWebServer::CreateFileDescriptorResponse(const std::string& filePath,
+                                                              uint64_t fileLength,
+                                                              uint64_t offset,
+                                                              uint64_t length)
+{
+#if defined(TARGET_POSIX)
+  const std::string localPath = CSpecialProtocol::TranslatePath(filePath);
+  if (!CURL(localPath).GetProtocol().empty())
+    return nullptr;
+
+  int fd = open(localPath.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0)
+    return nullptr;
+
+  // make sure it's still the file whose length the ranges were calculated for
+  struct stat st;
+  if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) ||
+      static_cast<uint64_t>(st.st_size) != fileLength)
+  {
+    close(fd);
+    return nullptr;
+  }
+
+  // mhd takes ownership of the file descriptor
+  struct MHD_Response* response = MHD_create_response_from_fd_at_offset64(length, fd, offset);
+  if (response == nullptr)
+  {
+    close(fd);
+    return nullptr;
+  }
+
+  if (CServiceBroker::GetLogging().CanLogComponent(LOGWEBSERVER))
+    GetLogger()->debug("[OUT] sending {} bytes from {} of {} from its file descriptor", length,
+                       offset, localPath);
+
+  return response;
+#else
+  return nullptr;
+#endif
+}
+
 static Logger GetMhdLogger()
 {
   return CServiceBroker::GetLogging().GetLogger("libmicrohttpd");
@@ -1196,50 +1360,57 @@ struct MHD_Daemon* CWebServer::StartMHD(unsigned int flags, int port)
 
   MHD_set_panic_func(&panicHandlerForMHD, nullptr);
 
+  std::vector<MHD_OptionItem> options;
   if (CServiceBroker::GetSettingsComponent()->GetSettings()->GetBool(
           CSettings::SETTING_SERVICES_WEBSERVERSSL) &&
       MHD_is_feature_supported(MHD_FEATURE_SSL) == MHD_YES && LoadCert(m_key, m_cert))
+  {
     // SSL enabled
-    return MHD_start_daemon(
-        flags |
-            // one thread per connection
-            // WARNING: set MHD_OPTION_CONNECTION_TIMEOUT to something higher than 1
-            // otherwise on libmicrohttpd 0.4.4-1 it spins a busy loop
-            MHD_USE_THREAD_PER_CONNECTION
+    flags |= MHD_USE_SSL;
+    options.push_back({MHD_OPTION_HTTPS_MEM_KEY, 0, const_cast<char*>(m_key.c_str())});
+    options.push_back({MHD_OPTION_HTTPS_MEM_CERT, 0, const_cast<char*>(m_cert.c_str())});
+    options.push_back({MHD_OPTION_HTTPS_PRIORITIES, 0, const_cast<char*>(ciphers)});
+  }
+
+  if (m_threadPoolSize > 0)
+  {
+    // a fixed pool of threads polling all connections, an idle keep-alive connection or a
+    // long-poll doesn't cost a thread and its stack
 #if (MHD_VERSION >= 0x00095207)
-            |
-            MHD_USE_INTERNAL_POLLING_THREAD /* MHD_USE_THREAD_PER_CONNECTION must be used only with
-                                               MHD_USE_INTERNAL_POLLING_THREAD since 0.9.54 */
+    flags |= MHD_USE_INTERNAL_POLLING_THREAD;
+    if (MHD_is_feature_supported(MHD_FEATURE_EPOLL) == MHD_YES)
+      flags |= MHD_USE_EPOLL;
+    else if (MHD_is_feature_supported(MHD_FEATURE_POLL) == MHD_YES)
+      flags |= MHD_USE_POLL;
+#else
+    flags |= MHD_USE_SELECT_INTERNALLY;
 #endif
-            | MHD_USE_DEBUG /* Print MHD error messages to log */
-            | MHD_USE_SSL,
-        port, 0, 0, &CWebServer::AnswerToConnection, this,
-
-        MHD_OPTION_EXTERNAL_LOGGER, &logFromMHD, 0, MHD_OPTION_CONNECTION_LIMIT, 512,
-        MHD_OPTION_CONNECTION_TIMEOUT, timeout, MHD_OPTION_URI_LOG_CALLBACK,
-        &CWebServer::UriRequestLogger, this, MHD_OPTION_THREAD_STACK_SIZE, m_thread_stacksize,
-        MHD_OPTION_HTTPS_MEM_KEY, m_key.c_str(), MHD_OPTION_HTTPS_MEM_CERT, m_cert.c_str(),
-        MHD_OPTION_HTTPS_PRIORITIES, ciphers, MHD_OPTION_END);
-
-  // No SSL
-  return MHD_start_daemon(
-      flags |
-          // one thread per connection
-          // WARNING: set MHD_OPTION_CONNECTION_TIMEOUT to something higher than 1
-          // otherwise on libmicrohttpd 0.4.4-1 it spins a busy loop
-          MHD_USE_THREAD_PER_CONNECTION
+    options.push_back({MHD_OPTION_THREAD_POOL_SIZE, m_threadPoolSize, nullptr});
+  }
+  else
+  {
+    // one thread per connection
+    // WARNING: set MHD_OPTION_CONNECTION_TIMEOUT to something higher than 1
+    // otherwise on libmicrohttpd 0.4.4-1 it spins a busy loop
+    flags |= MHD_USE_THREAD_PER_CONNECTION
 #if (MHD_VERSION >= 0x00095207)
-          | MHD_USE_INTERNAL_POLLING_THREAD /* MHD_USE_THREAD_PER_CONNECTION must be used only with
-                                               MHD_USE_INTERNAL_POLLING_THREAD since 0.9.54 */
+             | MHD_USE_INTERNAL_POLLING_THREAD /* MHD_USE_THREAD_PER_CONNECTION must be used only
+                                                  with MHD_USE_INTERNAL_POLLING_THREAD since
+                                                  0.9.54 */
 #endif
-          | MHD_USE_DEBUG /* Print MHD error messages to log */
-      ,
-      port, 0, 0, &CWebServer::AnswerToConnection, this,
+        ;
+  }
+  options.push_back({MHD_OPTION_END, 0, nullptr});
+
+  return MHD_start_daemon(
+      flags | MHD_USE_DEBUG /* Print MHD error messages to log */, port, 0, 0,
+      &CWebServer::AnswerToConnection, this,
 
       MHD_OPTION_EXTERNAL_LOGGER, &logFromMHD, 0, MHD_OPTION_CONNECTION_LIMIT, 512,
       MHD_OPTION_CONNECTION_TIMEOUT, timeout, MHD_OPTION_URI_LOG_CALLBACK,
-      &CWebServer::UriRequestLogger, this, MHD_OPTION_THREAD_STACK_SIZE, m_thread_stacksize,
-      MHD_OPTION_END);
+      &CWebServer::UriRequestLogger, this, MHD_OPTION_NOTIFY_CONNECTION,
+      &CWebServer::NotifyConnection, this, MHD_OPTION_THREAD_STACK_SIZE, m_thread_stacksize,
+      MHD_OPTION_ARRAY, options.data(), MHD_OPTION_END);
 }
 
 bool CWebServer::Start(uint16_t port, const std::string& username, const std::string& password)
@@ -1250,6 +1421,13 @@ bool CWebServer::Start(uint16_t port, const std::string& username, const std::st
     // use a new logger containing the port in the name
     m_logger = CServiceBroker::GetLogging().GetLogger(StringUtils::Format("CWebserver[{}]", port));
 
+    m_threadPoolSize =
+        CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_webserverThreadPoolSize;
+    {
+      std::unique_lock<CCriticalSection> lock(m_statisticsSection);
+      m_statistics = Statistics();
+    }
+
     int v6testSock;
     if ((v6testSock = socket(AF_INET6, SOCK_STREAM, 0)) >= 0)
     {
@@ -1262,7 +1440,10 @@ bool CWebServer::Start(uint16_t port, const std::string& username, const std::st
     if (m_running)
     {
       m_port = port;
-      m_logger->info("Started");
+      if (m_threadPoolSize > 0)
+        m_logger->info("Started with {} threads", m_threadPoolSize);
+      else
+        m_logger->info("Started with one thread per connection");
     }
     else
       m_logger->error("Failed to start");
@@ -1283,7 +1464,18 @@ bool CWebServer::Stop()
     MHD_stop_daemon(m_daemon_ip4);
 
   m_running = false;
-  m_logger->info("Stopped");
+
+  const Statistics statistics = GetStatistics();
+  if (statistics.requests > 0)
+    m_logger->info("Stopped after {} requests on {} connections, average queue wait {} us (max {} "
+                   "us), average handler time {} us (max {} us)",
+                   statistics.requests, statistics.connections,
+                   statistics.queueWait.count() / std::max<uint64_t>(statistics.connections, 1),
+                   statistics.maxQueueWait.count(),
+                   statistics.handlerTime.count() / statistics.requests,
+                   statistics.maxHandlerTime.count());
+  else
+    m_logger->info("Stopped");
   m_port = 0;
 
   return true;
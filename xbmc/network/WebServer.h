@@ -12,6 +12,8 @@
 #include "threads/CriticalSection.h"
 #include "utils/logtypes.h"
 
+#include <atomic>
+#include <chrono>
 #include <memory>
 #include <vector>
 
@@ -37,6 +39,20 @@ public:
   void RegisterRequestHandler(IHTTPRequestHandler *handler);
   void UnregisterRequestHandler(IHTTPRequestHandler *handler);
 
+  struct Statistics
+  {
+    unsigned int activeConnections = 0;
+    uint64_t requests = 0;
+    uint64_t connections = 0; ///< connections that sent at least one request
+    //! total time between accepting connections and handling their first request
+    std::chrono::microseconds queueWait{0};
+    std::chrono::microseconds maxQueueWait{0};
+    std::chrono::microseconds handlerTime{0}; ///< total time spent in the request handlers
+    std::chrono::microseconds maxHandlerTime{0};
+  };
+
+  Statistics GetStatistics() const;
+
 protected:
   typedef struct ConnectionHandler
   {
@@ -55,6 +71,12 @@ protected:
     { }
   } ConnectionHandler;
 
+  struct SocketContext
+  {
+    std::chrono::steady_clock::time_point accepted = std::chrono::steady_clock::now();
+    bool answered = false;
+  };
+
   virtual void LogRequest(const char* uri) const;
 
   virtual MHD_RESULT HandlePartialRequest(struct MHD_Connection *connection, ConnectionHandler* connectionHandler, const HTTPRequest& request,
@@ -65,13 +87,19 @@ protected:
 private:
   struct MHD_Daemon* StartMHD(unsigned int flags, int port);
 
+  MHD_RESULT ProcessRequest(const std::shared_ptr<IHTTPRequestHandler>& handler);
+  void AddRequest(struct MHD_Connection* connection);
+  void AddHandlerTime(std::chrono::microseconds time);
+
   std::shared_ptr<IHTTPRequestHandler> FindRequestHandler(const HTTPRequest& request) const;
 
   MHD_RESULT AskForAuthentication(const HTTPRequest& request) const;
   bool IsAuthenticated(const HTTPRequest& request) const;
 
   bool IsRequestCacheable(const HTTPRequest& request) const;
-  bool IsRequestRanged(const HTTPRequest& request, const CDateTime &lastModified) const;
+  bool IsRequestRanged(const HTTPRequest& request,
+                       const CDateTime& lastModified,
+                       const std::string& entityTag) const;
 
   void SetupPostDataProcessing(const HTTPRequest& request, ConnectionHandler *connectionHandler, std::shared_ptr<IHTTPRequestHandler> handler, void **con_cls) const;
   bool ProcessPostData(const HTTPRequest& request, ConnectionHandler *connectionHandler, const char *upload_data, size_t *upload_data_size, void **con_cls) const;
@@ -86,6 +114,7 @@ private:
   MHD_RESULT CreateMemoryDownloadResponse(struct MHD_Connection *connection, const void *data, size_t size, bool free, bool copy, struct MHD_Response *&response) const;
 
   MHD_RESULT SendResponse(const HTTPRequest& request, int responseStatus, MHD_Response *response) const;
+  MHD_RESULT SendNotModified(const std::shared_ptr<IHTTPRequestHandler>& handler);
   MHD_RESULT SendErrorResponse(const HTTPRequest& request, int errorType, HTTPMethod method) const;
 
   MHD_RESULT AddHeader(struct MHD_Response *response, const std::string &name, const std::string &value) const;
@@ -98,6 +127,10 @@ private:
   // MHD callback implementations
   static void* UriRequestLogger(void *cls, const char *uri);
 
+  static struct MHD_Response* CreateFileDescriptorResponse(const std::string& filePath,
+                                                           uint64_t fileLength,
+                                                           uint64_t offset,
+                                                           uint64_t length);
   static ssize_t ContentReaderCallback (void *cls, uint64_t pos, char *buf, size_t max);
   static void ContentReaderFreeCallback(void *cls);
 
@@ -105,6 +138,10 @@ private:
                         const char *url, const char *method,
                         const char *version, const char *upload_data,
                         size_t *upload_data_size, void **con_cls);
+  static void NotifyConnection(void* cls,
+                               struct MHD_Connection* connection,
+                               void** socket_context,
+                               enum MHD_ConnectionNotificationCode toe);
   static MHD_RESULT HandlePostField(void *cls, enum MHD_ValueKind kind, const char *key,
                              const char *filename, const char *content_type,
                              const char *transfer_encoding, const char *data, uint64_t off,
@@ -119,6 +156,7 @@ private:
   struct MHD_Daemon *m_daemon_ip4 = nullptr;
   bool m_running = false;
   size_t m_thread_stacksize = 0;
+  unsigned int m_threadPoolSize = 0;
   bool m_authenticationRequired = false;
   std::string m_authenticationUsername;
   std::string m_authenticationPassword;
@@ -127,5 +165,9 @@ private:
   mutable CCriticalSection m_critSection;
   std::vector<IHTTPRequestHandler *> m_requestHandlers;
 
+  std::atomic<unsigned int> m_activeConnections{0};
+  mutable CCriticalSection m_statisticsSection;
+  Statistics m_statistics;
+
   Logger m_logger;
 };
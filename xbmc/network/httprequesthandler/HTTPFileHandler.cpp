@@ -9,6 +9,7 @@
 #include "HTTPFileHandler.h"
 
 #include "filesystem/File.h"
+#include "network/httprequesthandler/HTTPRequestHandlerUtils.h"
 #include "utils/Mime.h"
 #include "utils/StringUtils.h"
 #include "utils/URIUtils.h"
@@ -39,6 +40,15 @@ bool CHTTPFileHandler::GetLastModifiedDate(CDateTime &lastModified) const
   return true;
 }
 
+bool CHTTPFileHandler::GetEntityTag(std::string& entityTag) const
+{
+  if (m_entityTag.empty())
+    return false;
+
+  entityTag = m_entityTag;
+  return true;
+}
+
 void CHTTPFileHandler::SetFile(const std::string& file, int responseStatus)
 {
   m_url = file;
@@ -73,7 +83,10 @@ void CHTTPFileHandler::SetFile(const std::string& file, int responseStatus)
     {
       struct __stat64 statBuffer;
       if (fileObj.Stat(&statBuffer) == 0)
+      {
         SetLastModifiedDate(&statBuffer);
+        SetEntityTag(&statBuffer);
+      }
     }
   }
 
@@ -101,3 +114,8 @@ void CHTTPFileHandler::SetLastModifiedDate(const struct __stat64 *statBuffer)
   if (time != NULL)
     m_lastModified = *time;
 }
+
+void CHTTPFileHandler::SetEntityTag(const struct __stat64* statBuffer)
+{
+  m_entityTag = HTTPRequestHandlerUtils::CreateEntityTag(statBuffer->st_mtime, statBuffer->st_size);
+}
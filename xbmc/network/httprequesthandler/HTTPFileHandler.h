@@ -23,6 +23,7 @@ public:
   bool CanHandleRanges() const override { return m_canHandleRanges; }
   bool CanBeCached() const override { return m_canBeCached; }
   bool GetLastModifiedDate(CDateTime &lastModified) const override;
+  bool GetEntityTag(std::string& entityTag) const override;
 
   std::string GetRedirectUrl() const override { return m_url; }
   std::string GetResponseFile() const override { return m_url; }
@@ -36,6 +37,7 @@ protected:
   void SetCanHandleRanges(bool canHandleRanges) { m_canHandleRanges = canHandleRanges; }
   void SetCanBeCached(bool canBeCached) { m_canBeCached = canBeCached; }
   void SetLastModifiedDate(const struct __stat64 *buffer);
+  void SetEntityTag(const struct __stat64* buffer);
 
 private:
   std::string m_url;
@@ -44,5 +46,6 @@ private:
   bool m_canBeCached = true;
 
   CDateTime m_lastModified;
+  std::string m_entityTag;
 
 };
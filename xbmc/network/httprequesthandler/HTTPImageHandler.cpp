@@ -34,6 +34,7 @@ CHTTPImageHandler::CHTTPImageHandler(const HTTPRequest &request)
       if (imageFile.Stat(pathToUrl, &statBuffer) == 0)
       {
         SetLastModifiedDate(&statBuffer);
+        SetEntityTag(&statBuffer);
         SetCanBeCached(true);
       }
     }
@@ -8,27 +8,59 @@
 
 #include "HTTPImageTransformationHandler.h"
 
+#include "FileItem.h"
 #include "TextureCacheJob.h"
 #include "URL.h"
+#include "filesystem/Directory.h"
+#include "filesystem/File.h"
 #include "filesystem/ImageFile.h"
 #include "network/WebServer.h"
 #include "network/httprequesthandler/HTTPRequestHandlerUtils.h"
+#include "utils/Crc32.h"
+#include "utils/Digest.h"
 #include "utils/Mime.h"
 #include "utils/StringUtils.h"
 #include "utils/URIUtils.h"
+#include "utils/log.h"
 
+#include <algorithm>
+#include <atomic>
 #include <map>
 
 #define TRANSFORMATION_OPTION_WIDTH             "width"
 #define TRANSFORMATION_OPTION_HEIGHT            "height"
 #define TRANSFORMATION_OPTION_SCALING_ALGORITHM "scaling_algorithm"
 
+// transformed images are kept on disk so they don't have to be decoded and resized again
+#define TRANSFORMATION_CACHE_PATH "special://temp/webserver/"
+#define TRANSFORMATION_CACHE_MAX_FILES 500
+// how many transformations are stored between checks of the cache size
+#define TRANSFORMATION_CACHE_CHECK_INTERVAL 50
+
 static const std::string ImageBasePath = "/image/";
 
+static std::atomic<unsigned int> s_transformationsStored{0};
+
+static void LimitTransformationCache()
+{
+  CFileItemList items;
+  if (!XFILE::CDirectory::GetDirectory(TRANSFORMATION_CACHE_PATH, items, "",
+                                       XFILE::DIR_FLAG_NO_FILE_DIRS | XFILE::DIR_FLAG_BYPASS_CACHE) ||
+      items.Size() <= TRANSFORMATION_CACHE_MAX_FILES)
+    return;
+
+  // remove the least recently stored transformations
+  std::vector<CFileItemPtr> files(items.cbegin(), items.cend());
+  std::sort(files.begin(), files.end(), [](const CFileItemPtr& left, const CFileItemPtr& right) {
+    return left->m_dateTime < right->m_dateTime;
+  });
+  for (size_t i = 0; i < files.size() - TRANSFORMATION_CACHE_MAX_FILES / 2; i++)
+    XFILE::CFile::Delete(files[i]->GetPath());
+}
+
 CHTTPImageTransformationHandler::CHTTPImageTransformationHandler()
   : m_url(),
     m_lastModified(),
-    m_buffer(NULL),
     m_responseData()
 { }
 
@@ -36,7 +68,6 @@ CHTTPImageTransformationHandler::CHTTPImageTransformationHandler(const HTTPReque
   : IHTTPRequestHandler(request),
     m_url(),
     m_lastModified(),
-    m_buffer(NULL),
     m_responseData()
 {
   m_url = m_request.pathUrl.substr(ImageBasePath.size());
@@ -64,6 +95,30 @@ CHTTPImageTransformationHandler::CHTTPImageTransformationHandler(const HTTPReque
   StringUtils::ToLower(ext);
   m_response.contentType = CMime::GetMimeType(ext);
 
+  // get the transformation options
+  std::map<std::string, std::string> options;
+  HTTPRequestHandlerUtils::GetRequestHeaderValues(m_request.connection, MHD_GET_ARGUMENT_KIND, options);
+
+  std::vector<std::string> urlOptions;
+  std::map<std::string, std::string>::const_iterator option = options.find(TRANSFORMATION_OPTION_WIDTH);
+  if (option != options.end())
+    urlOptions.push_back(TRANSFORMATION_OPTION_WIDTH "=" + option->second);
+
+  option = options.find(TRANSFORMATION_OPTION_HEIGHT);
+  if (option != options.end())
+    urlOptions.push_back(TRANSFORMATION_OPTION_HEIGHT "=" + option->second);
+
+  option = options.find(TRANSFORMATION_OPTION_SCALING_ALGORITHM);
+  if (option != options.end())
+    urlOptions.push_back(TRANSFORMATION_OPTION_SCALING_ALGORITHM "=" + option->second);
+
+  m_imagePath = m_url;
+  if (!urlOptions.empty())
+  {
+    m_imagePath += "?";
+    m_imagePath += StringUtils::Join(urlOptions, "&");
+  }
+
   //! @todo determine the maximum age
 
   // determine the last modified date
@@ -71,6 +126,10 @@ CHTTPImageTransformationHandler::CHTTPImageTransformationHandler(const HTTPReque
   if (imageFile.Stat(pathToUrl, &statBuffer) != 0)
     return;
 
+  // the transformation is identified by the cached original and the transformation options
+  m_entityTag = HTTPRequestHandlerUtils::CreateEntityTag(statBuffer.st_mtime, statBuffer.st_size,
+                                                         Crc32::Compute(m_imagePath));
+
   struct tm *time;
 #ifdef HAVE_LOCALTIME_R
   struct tm result = {};
@@ -87,8 +146,6 @@ CHTTPImageTransformationHandler::CHTTPImageTransformationHandler(const HTTPReque
 CHTTPImageTransformationHandler::~CHTTPImageTransformationHandler()
 {
   m_responseData.clear();
-  delete m_buffer;
-  m_buffer = NULL;
 }
 
 bool CHTTPImageTransformationHandler::CanHandleRequest(const HTTPRequest &request) const
@@ -110,33 +167,7 @@ MHD_RESULT CHTTPImageTransformationHandler::HandleRequest()
   if (m_response.type == HTTPError)
     return MHD_YES;
 
-  // get the transformation options
-  std::map<std::string, std::string> options;
-  HTTPRequestHandlerUtils::GetRequestHeaderValues(m_request.connection, MHD_GET_ARGUMENT_KIND, options);
-
-  std::vector<std::string> urlOptions;
-  std::map<std::string, std::string>::const_iterator option = options.find(TRANSFORMATION_OPTION_WIDTH);
-  if (option != options.end())
-    urlOptions.push_back(TRANSFORMATION_OPTION_WIDTH "=" + option->second);
-
-  option = options.find(TRANSFORMATION_OPTION_HEIGHT);
-  if (option != options.end())
-    urlOptions.push_back(TRANSFORMATION_OPTION_HEIGHT "=" + option->second);
-
-  option = options.find(TRANSFORMATION_OPTION_SCALING_ALGORITHM);
-  if (option != options.end())
-    urlOptions.push_back(TRANSFORMATION_OPTION_SCALING_ALGORITHM "=" + option->second);
-
-  std::string imagePath = m_url;
-  if (!urlOptions.empty())
-  {
-    imagePath += "?";
-    imagePath += StringUtils::Join(urlOptions, "&");
-  }
-
-  // resize the image into the local buffer
-  size_t bufferSize;
-  if (!CTextureCacheJob::ResizeTexture(imagePath, m_buffer, bufferSize))
+  if (!LoadCachedTransformation() && !Transform())
   {
     m_response.status = MHD_HTTP_INTERNAL_SERVER_ERROR;
     m_response.type = HTTPError;
@@ -145,17 +176,17 @@ MHD_RESULT CHTTPImageTransformationHandler::HandleRequest()
   }
 
   // store the size of the image
-  m_response.totalLength = bufferSize;
+  m_response.totalLength = m_buffer.size();
 
   // nothing else to do if the request is not ranged
   if (!GetRequestedRanges(m_response.totalLength))
   {
-    m_responseData.push_back(CHttpResponseRange(m_buffer, 0, m_response.totalLength - 1));
+    m_responseData.push_back(CHttpResponseRange(m_buffer.data(), 0, m_response.totalLength - 1));
     return MHD_YES;
   }
 
   for (HttpRanges::const_iterator range = m_request.ranges.Begin(); range != m_request.ranges.End(); ++range)
-    m_responseData.push_back(CHttpResponseRange(m_buffer + range->GetFirstPosition(), range->GetFirstPosition(), range->GetLastPosition()));
+    m_responseData.push_back(CHttpResponseRange(m_buffer.data() + range->GetFirstPosition(), range->GetFirstPosition(), range->GetLastPosition()));
 
   return MHD_YES;
 }
@@ -168,3 +199,75 @@ bool CHTTPImageTransformationHandler::GetLastModifiedDate(CDateTime &lastModifie
   lastModified = m_lastModified;
   return true;
 }
+
+bool CHTTPImageTransformationHandler::GetEntityTag(std::string& entityTag) const
+{
+  if (m_entityTag.empty())
+    return false;
+
+  entityTag = m_entityTag;
+  return true;
+}
+
+std::string CHTTPImageTransformationHandler::GetCachedTransformationPath() const
+{
+  // without an entity tag there's no way to tell if the original has changed
+  if (m_entityTag.empty())
+    return "";
+
+  // named by a SHA-256 of the key, a collision of a short checksum would silently serve the
+  // transformation of another image
+  return TRANSFORMATION_CACHE_PATH +
+         KODI::UTILITY::CDigest::Calculate(KODI::UTILITY::CDigest::Type::SHA256,
+                                           m_imagePath + m_entityTag) +
+         URIUtils::GetExtension(CURL(m_url).GetHostName());
+}
+
+bool CHTTPImageTransformationHandler::LoadCachedTransformation()
+{
+  const std::string cachedPath = GetCachedTransformationPath();
+  if (cachedPath.empty() || !XFILE::CFile::Exists(cachedPath, false))
+    return false;
+
+  XFILE::CFile file;
+  return file.LoadFile(cachedPath, m_buffer) > 0;
+}
+
+bool CHTTPImageTransformationHandler::Transform()
+{
+  // resize the image into the local buffer
+  uint8_t* buffer = nullptr;
+  size_t bufferSize = 0;
+  if (!CTextureCacheJob::ResizeTexture(m_imagePath, buffer, bufferSize))
+    return false;
+
+  m_buffer.assign(buffer, buffer + bufferSize);
+  delete[] buffer;
+
+  const std::string cachedPath = GetCachedTransformationPath();
+  if (cachedPath.empty())
+    return true;
+
+  // write to a temporary file first so concurrent requests never read a partial image
+  const std::string temporaryPath = cachedPath + StringUtils::Format(".{}", s_transformationsStored++);
+  XFILE::CDirectory::Create(TRANSFORMATION_CACHE_PATH);
+  XFILE::CFile file;
+  if (!file.OpenForWrite(temporaryPath, true))
+    return true;
+
+  const bool written =
+      file.Write(m_buffer.data(), m_buffer.size()) == static_cast<ssize_t>(m_buffer.size());
+  file.Close();
+  if (!written || !XFILE::CFile::Rename(temporaryPath, cachedPath))
+  {
+    CLog::Log(LOGDEBUG, "CHTTPImageTransformationHandler: failed to cache {}",
+              CURL::GetRedacted(m_imagePath));
+    XFILE::CFile::Delete(temporaryPath);
+    return true;
+  }
+
+  if (s_transformationsStored % TRANSFORMATION_CACHE_CHECK_INTERVAL == 0)
+    LimitTransformationCache();
+
+  return true;
+}
@@ -13,6 +13,7 @@
 
 #include <stdint.h>
 #include <string>
+#include <vector>
 
 class CHTTPImageTransformationHandler : public IHTTPRequestHandler
 {
@@ -28,6 +29,7 @@ public:
   bool CanHandleRanges() const override { return true; }
   bool CanBeCached() const override { return true; }
   bool GetLastModifiedDate(CDateTime &lastModified) const override;
+  bool GetEntityTag(std::string& entityTag) const override;
 
   HttpResponseRanges GetResponseData() const override { return m_responseData; }
 
@@ -38,9 +40,15 @@ protected:
   explicit CHTTPImageTransformationHandler(const HTTPRequest &request);
 
 private:
+  std::string GetCachedTransformationPath() const;
+  bool LoadCachedTransformation();
+  bool Transform();
+
   std::string m_url;
+  std::string m_imagePath; ///< m_url with the transformation options
   CDateTime m_lastModified;
+  std::string m_entityTag;
 
-  uint8_t* m_buffer;
+  std::vector<uint8_t> m_buffer;
   HttpResponseRanges m_responseData;
 };
@@ -13,12 +13,17 @@
 #include "interfaces/json-rpc/JSONRPC.h"
 #include "interfaces/json-rpc/JSONServiceDescription.h"
 #include "network/httprequesthandler/HTTPRequestHandlerUtils.h"
+#include "utils/CompressionUtils.h"
 #include "utils/FileUtils.h"
 #include "utils/JSONVariantWriter.h"
 #include "utils/Variant.h"
 #include "utils/log.h"
 
+#include <utility>
+
 #define MAX_HTTP_POST_SIZE 65536
+// smaller responses fit into a few packets anyway
+#define MIN_HTTP_COMPRESSION_SIZE 1024
 
 bool CHTTPJsonRpcHandler::CanHandleRequest(const HTTPRequest &request) const
 {
@@ -100,6 +105,23 @@ MHD_RESULT CHTTPJsonRpcHandler::HandleRequest()
 
   m_requestData.clear();
 
+  // library listings are large and compress very well
+  if (m_responseData.size() >= MIN_HTTP_COMPRESSION_SIZE)
+  {
+    AddResponseHeader(MHD_HTTP_HEADER_VARY, MHD_HTTP_HEADER_ACCEPT_ENCODING);
+
+    std::string compressed;
+    if (HTTPRequestHandlerUtils::AcceptsEncoding(
+            HTTPRequestHandlerUtils::GetRequestHeaderValue(m_request.connection, MHD_HEADER_KIND,
+                                                           MHD_HTTP_HEADER_ACCEPT_ENCODING),
+            "gzip") &&
+        CCompressionUtils::Gzip(m_responseData.c_str(), m_responseData.size(), compressed))
+    {
+      m_responseData = std::move(compressed);
+      AddResponseHeader(MHD_HTTP_HEADER_CONTENT_ENCODING, "gzip");
+    }
+  }
+
   m_responseRange.SetData(m_responseData.c_str(), m_responseData.size());
 
   m_response.type = HTTPMemoryDownloadNoFreeCopy;
@@ -10,6 +10,7 @@
 
 #include "utils/StringUtils.h"
 
+#include <cstdlib>
 #include <map>
 
 std::string HTTPRequestHandlerUtils::GetRequestHeaderValue(struct MHD_Connection *connection, enum MHD_ValueKind kind, const std::string &key)
@@ -83,3 +84,75 @@ MHD_RESULT HTTPRequestHandlerUtils::FillArgumentMultiMap(void *cls, enum MHD_Val
 
   return MHD_YES;
 }
+
+std::string HTTPRequestHandlerUtils::CreateEntityTag(int64_t modified, int64_t size, uint32_t variant)
+{
+  if (variant == 0)
+    return StringUtils::Format("\"{:x}-{:x}\"", modified, size);
+
+  return StringUtils::Format("\"{:x}-{:x}-{:08x}\"", modified, size, variant);
+}
+
+bool HTTPRequestHandlerUtils::MatchesEntityTag(const std::string& header, const std::string& entityTag, bool weak)
+{
+  if (entityTag.empty())
+    return false;
+
+  std::string values = header;
+  if (StringUtils::Trim(values) == "*")
+    return true;
+
+  static const std::string weakPrefix = "W/";
+  std::string tag = entityTag;
+  if (StringUtils::StartsWith(tag, weakPrefix))
+  {
+    if (!weak)
+      return false;
+    tag.erase(0, weakPrefix.size());
+  }
+
+  for (auto& value : StringUtils::Split(values, ","))
+  {
+    StringUtils::Trim(value);
+    if (StringUtils::StartsWith(value, weakPrefix))
+    {
+      if (!weak)
+        continue;
+      value.erase(0, weakPrefix.size());
+    }
+
+    if (value == tag)
+      return true;
+  }
+
+  return false;
+}
+
+bool HTTPRequestHandlerUtils::AcceptsEncoding(const std::string& header, const std::string& encoding)
+{
+  bool wildcard = false;
+  for (const auto& value : StringUtils::Split(header, ","))
+  {
+    std::vector<std::string> parameters = StringUtils::Split(value, ";");
+    if (parameters.empty())
+      continue;
+
+    std::string coding = StringUtils::Trim(parameters.front());
+
+    // a quality value of 0 means the coding must not be used
+    bool acceptable = true;
+    for (auto parameter = parameters.begin() + 1; parameter != parameters.end(); ++parameter)
+    {
+      StringUtils::Trim(*parameter);
+      if (StringUtils::StartsWithNoCase(*parameter, "q="))
+        acceptable = std::strtod(parameter->c_str() + 2, nullptr) > 0.0;
+    }
+
+    if (StringUtils::EqualsNoCase(coding, encoding))
+      return acceptable;
+    if (coding == "*")
+      wildcard = acceptable;
+  }
+
+  return wildcard;
+}
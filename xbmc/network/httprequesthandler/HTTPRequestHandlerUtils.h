@@ -22,6 +22,23 @@ public:
 
   static bool GetRequestedRanges(struct MHD_Connection *connection, uint64_t totalLength, CHttpRanges &ranges);
 
+  /*!
+   * \brief Creates an entity tag from the modification time and size of a file and an optional
+   * hash of the variant of the file (e.g. a transformation) that is served.
+   */
+  static std::string CreateEntityTag(int64_t modified, int64_t size, uint32_t variant = 0);
+  /*!
+   * \brief Checks if the value of an If-None-Match or If-Range header matches the given entity
+   * tag.
+   *
+   * \param weak whether weak entity tags match (If-None-Match) or not (If-Range)
+   */
+  static bool MatchesEntityTag(const std::string& header, const std::string& entityTag, bool weak);
+  /*!
+   * \brief Checks if the value of an Accept-Encoding header allows the given content coding.
+   */
+  static bool AcceptsEncoding(const std::string& header, const std::string& encoding);
+
 private:
   HTTPRequestHandlerUtils() = delete;
 
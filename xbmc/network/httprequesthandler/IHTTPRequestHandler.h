@@ -146,6 +146,13 @@ public:
   */
   virtual bool GetLastModifiedDate(CDateTime &lastModified) const { return false; }
 
+  /*!
+  * \brief Returns the entity tag (including the quotes) identifying the response data.
+  *
+  * \details This is only used if the response can be cached.
+  */
+  virtual bool GetEntityTag(std::string& entityTag) const { return false; }
+
   /*!
    * \brief Returns the ranges with raw data belonging to the response.
    *
@@ -0,0 +1,137 @@
+/*
+ *  Copyright (C) 2023 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "network/DNSNameCache.h"
+#include "threads/Event.h"
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+using namespace std::chrono_literals;
+
+namespace
+{
+std::atomic<int> resolveCount{0};
+CEvent resolveStarted;
+CEvent resolveRelease(true);
+
+std::string ResolveFail(const std::string& strHostName)
+{
+  ++resolveCount;
+  return "";
+}
+
+std::string ResolveBlocking(const std::string& strHostName)
+{
+  ++resolveCount;
+  resolveStarted.Set();
+  resolveRelease.Wait(10s);
+  return "10.4.5.6";
+}
+
+class CTestDNSNameCache : public CDNSNameCache
+{
+public:
+  using CDNSNameCache::CLookup;
+  using CDNSNameCache::StartLookup;
+
+  explicit CTestDNSNameCache(Resolver resolver)
+  {
+    resolveCount = 0;
+    resolveRelease.Reset();
+    m_resolver = resolver;
+  }
+  ~CTestDNSNameCache() override { m_resolver = ResolveHost; }
+};
+} // unnamed namespace
+
+TEST(TestDNSNameCache, IpAddress)
+{
+  std::string ip;
+  EXPECT_TRUE(CDNSNameCache::Lookup("192.168.1.10", ip));
+  EXPECT_EQ("192.168.1.10", ip);
+}
+
+TEST(TestDNSNameCache, CustomEntry)
+{
+  std::string ip;
+  CDNSNameCache::Add("kodi-test-custom.invalid", "10.1.2.3");
+  EXPECT_TRUE(CDNSNameCache::GetCached("kodi-test-custom.invalid", ip));
+  EXPECT_EQ("10.1.2.3", ip);
+
+  ip.clear();
+  EXPECT_TRUE(CDNSNameCache::Lookup("kodi-test-custom.invalid", ip));
+  EXPECT_EQ("10.1.2.3", ip);
+}
+
+TEST(TestDNSNameCache, Localhost)
+{
+  std::string ip;
+  ASSERT_TRUE(CDNSNameCache::Lookup("localhost", ip));
+  EXPECT_EQ("127.0.0.1", ip);
+  EXPECT_TRUE(CDNSNameCache::GetCached("localhost", ip));
+}
+
+TEST(TestDNSNameCache, UnknownHost)
+{
+  // .invalid never resolves, the failure is remembered
+  std::string ip;
+  EXPECT_FALSE(CDNSNameCache::Lookup("kodi-test-unknown.invalid", ip));
+  EXPECT_TRUE(ip.empty());
+  EXPECT_FALSE(CDNSNameCache::GetCached("kodi-test-unknown.invalid", ip));
+  EXPECT_FALSE(CDNSNameCache::Lookup("kodi-test-unknown.invalid", ip));
+}
+
+TEST(TestDNSNameCache, CachedFailure)
+{
+  CTestDNSNameCache cache(ResolveFail);
+
+  std::string ip;
+  EXPECT_FALSE(CDNSNameCache::Lookup("kodi-test-failure.invalid", ip));
+  EXPECT_EQ(1, resolveCount);
+
+  // the failure is answered from the cache without asking the resolver again
+  EXPECT_FALSE(CDNSNameCache::Lookup("kodi-test-failure.invalid", ip));
+  EXPECT_TRUE(ip.empty());
+  CDNSNameCache::Prefetch("kodi-test-failure.invalid");
+  EXPECT_EQ(1, resolveCount);
+}
+
+TEST(TestDNSNameCache, SharedLookup)
+{
+  CTestDNSNameCache cache(ResolveBlocking);
+
+  std::string ip1;
+  std::string ip2;
+  bool found1 = false;
+  bool found2 = false;
+  std::thread lookup1(
+      [&ip1, &found1]() { found1 = CDNSNameCache::Lookup("kodi-test-shared.invalid", ip1); });
+  ASSERT_TRUE(resolveStarted.Wait(5s));
+  std::thread lookup2(
+      [&ip2, &found2]() { found2 = CDNSNameCache::Lookup("kodi-test-shared.invalid", ip2); });
+
+  // further lookups of the host join the running one
+  std::shared_ptr<CTestDNSNameCache::CLookup> lookup =
+      CTestDNSNameCache::StartLookup("kodi-test-shared.invalid");
+  EXPECT_EQ(lookup, CTestDNSNameCache::StartLookup("kodi-test-shared.invalid"));
+
+  resolveRelease.Set();
+  lookup1.join();
+  lookup2.join();
+
+  EXPECT_EQ(1, resolveCount);
+  EXPECT_TRUE(found1);
+  EXPECT_TRUE(found2);
+  EXPECT_EQ("10.4.5.6", ip1);
+  EXPECT_EQ("10.4.5.6", ip2);
+}
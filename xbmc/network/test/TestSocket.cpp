@@ -0,0 +1,61 @@
+/*
+ *  Copyright (C) 2023 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "network/Socket.h"
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace SOCKETS;
+
+TEST(TestSocket, ReadBatch)
+{
+  CPosixUDPSocket server;
+  ASSERT_TRUE(server.Bind(true, 34000, 100));
+  CPosixUDPSocket client;
+  ASSERT_TRUE(client.Bind(true, server.Port() + 1, 100));
+
+  CAddress addr("127.0.0.1");
+  addr.saddr.saddr4.sin_port = htons(server.Port());
+  const int count = 10;
+  for (int i = 0; i < count; i++)
+  {
+    const std::string packet = "packet " + std::to_string(i);
+    ASSERT_EQ(static_cast<int>(packet.size()), client.SendTo(addr, packet.size(), packet.data()));
+  }
+
+  std::vector<CUDPSocket::CDatagram> datagrams(4);
+  for (auto& datagram : datagrams)
+    datagram.buffer.resize(64);
+
+  CSocketListener listener;
+  listener.AddSocket(&server);
+
+  // datagrams are read in order, at most as many as there are buffers at a time
+  int received = 0;
+  while (received < count && listener.Listen(1000))
+  {
+    const int read = server.ReadBatch(datagrams);
+    ASSERT_GE(read, 0);
+    ASSERT_LE(read, 4);
+    for (int i = 0; i < read; i++)
+    {
+      const CUDPSocket::CDatagram& datagram = datagrams[i];
+      EXPECT_EQ("packet " + std::to_string(received + i),
+                std::string(reinterpret_cast<const char*>(datagram.buffer.data()), datagram.size));
+      EXPECT_EQ(client.Port(), ntohs(datagram.addr.saddr.saddr4.sin_port));
+    }
+    received += read;
+  }
+  EXPECT_EQ(count, received);
+
+  // nothing is left, reading doesn't block
+  EXPECT_FALSE(listener.Listen(0));
+}
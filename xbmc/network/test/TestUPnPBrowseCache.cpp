@@ -0,0 +1,195 @@
+/*
+ *  Copyright (C) 2023 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "network/upnp/UPnPBrowseCache.h"
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+using namespace UPNP;
+using namespace std::chrono_literals;
+
+namespace
+{
+class CTestEntry : public CUPnPBrowseCache::CEntry
+{
+public:
+  void ClearDidl() override
+  {
+    cleared++;
+    didlSize = 0;
+  }
+
+  int cleared = 0;
+};
+
+CUPnPBrowseCache::Limits GetLimits()
+{
+  CUPnPBrowseCache::Limits limits;
+  limits.maxContainers = 3;
+  limits.maxItems = 100;
+  limits.maxDidlSize = 1000;
+  return limits;
+}
+
+// lists a container the way the server does, checking the cache first
+std::shared_ptr<CTestEntry> List(CUPnPBrowseCache& cache,
+                                 const std::string& id,
+                                 size_t items,
+                                 size_t didlSize = 0)
+{
+  unsigned int generation;
+  auto entry = std::static_pointer_cast<CTestEntry>(cache.Get(id, generation));
+  if (!entry)
+    entry = std::make_shared<CTestEntry>();
+  entry->didlSize = didlSize;
+  cache.Put(id, entry, items, generation);
+  return entry;
+}
+
+bool IsCached(CUPnPBrowseCache& cache, const std::string& id)
+{
+  unsigned int generation;
+  return cache.Get(id, generation) != nullptr;
+}
+} // unnamed namespace
+
+TEST(TestUPnPBrowseCache, Cached)
+{
+  CUPnPBrowseCache cache(GetLimits());
+  auto entry = List(cache, "musicdb://songs/", 10);
+
+  unsigned int generation;
+  EXPECT_EQ(entry, cache.Get("musicdb://songs/", generation));
+  EXPECT_EQ(nullptr, cache.Get("musicdb://albums/", generation));
+  EXPECT_EQ(1u, cache.Size());
+}
+
+TEST(TestUPnPBrowseCache, LeastRecentlyUsed)
+{
+  CUPnPBrowseCache cache(GetLimits());
+  List(cache, "a", 10);
+  List(cache, "b", 10);
+  List(cache, "c", 10);
+
+  // paging through a makes b the least recently used listing
+  List(cache, "a", 10);
+  List(cache, "d", 10);
+
+  EXPECT_EQ(3u, cache.Size());
+  EXPECT_FALSE(IsCached(cache, "b"));
+  EXPECT_TRUE(IsCached(cache, "a"));
+  EXPECT_TRUE(IsCached(cache, "c"));
+  EXPECT_TRUE(IsCached(cache, "d"));
+}
+
+TEST(TestUPnPBrowseCache, ItemBudget)
+{
+  CUPnPBrowseCache cache(GetLimits());
+  List(cache, "a", 40);
+  List(cache, "b", 40);
+  EXPECT_EQ(2u, cache.Size());
+
+  // a is dropped to stay within 100 items
+  List(cache, "c", 40);
+  EXPECT_EQ(2u, cache.Size());
+  EXPECT_FALSE(IsCached(cache, "a"));
+  EXPECT_TRUE(IsCached(cache, "b"));
+  EXPECT_TRUE(IsCached(cache, "c"));
+}
+
+TEST(TestUPnPBrowseCache, PagedListingSurvives)
+{
+  CUPnPBrowseCache cache(GetLimits());
+  List(cache, "a", 10);
+
+  // a listing larger than the budget is kept while it is paged through
+  auto large = List(cache, "large", 500);
+  EXPECT_EQ(1u, cache.Size());
+  EXPECT_FALSE(IsCached(cache, "a"));
+
+  for (int page = 0; page < 5; page++)
+    EXPECT_EQ(large, List(cache, "large", 500));
+  EXPECT_EQ(1u, cache.Size());
+
+  // until another one is listed
+  List(cache, "b", 10);
+  EXPECT_EQ(1u, cache.Size());
+  EXPECT_FALSE(IsCached(cache, "large"));
+  EXPECT_TRUE(IsCached(cache, "b"));
+}
+
+TEST(TestUPnPBrowseCache, DidlTrimKeepsListings)
+{
+  CUPnPBrowseCache cache(GetLimits());
+  auto a = List(cache, "a", 10, 600);
+  auto b = List(cache, "b", 10, 600);
+
+  // the DIDL of the least recently used listing is dropped, not the listing
+  EXPECT_EQ(1, a->cleared);
+  EXPECT_EQ(0u, a->didlSize);
+  EXPECT_EQ(0, b->cleared);
+  EXPECT_EQ(600u, b->didlSize);
+  EXPECT_EQ(2u, cache.Size());
+  EXPECT_TRUE(IsCached(cache, "a"));
+  EXPECT_TRUE(IsCached(cache, "b"));
+
+  // a single listing is trimmed as well once its DIDL gets too large
+  List(cache, "b", 10, 2000);
+  EXPECT_EQ(1, b->cleared);
+  EXPECT_TRUE(IsCached(cache, "b"));
+}
+
+TEST(TestUPnPBrowseCache, IdleExpiry)
+{
+  CUPnPBrowseCache::Limits limits = GetLimits();
+  limits.idleTime = 50ms;
+  CUPnPBrowseCache cache(limits);
+
+  List(cache, "a", 10);
+  List(cache, "b", 10);
+  std::this_thread::sleep_for(100ms);
+
+  // idle listings are dropped when they are asked for and when another one is cached
+  EXPECT_FALSE(IsCached(cache, "a"));
+  List(cache, "c", 10);
+  EXPECT_EQ(1u, cache.Size());
+  EXPECT_FALSE(IsCached(cache, "b"));
+  EXPECT_TRUE(IsCached(cache, "c"));
+}
+
+TEST(TestUPnPBrowseCache, AnnouncementDuringListing)
+{
+  CUPnPBrowseCache cache(GetLimits());
+  List(cache, "a", 10);
+
+  // the library changes while b is being listed
+  unsigned int generation;
+  EXPECT_EQ(nullptr, cache.Get("b", generation));
+  cache.Clear();
+  cache.Put("b", std::make_shared<CTestEntry>(), 10, generation);
+
+  EXPECT_EQ(0u, cache.Size());
+  EXPECT_FALSE(IsCached(cache, "a"));
+  EXPECT_FALSE(IsCached(cache, "b"));
+
+  // the same happens to a cached listing being paged through
+  auto entry = List(cache, "a", 10);
+  EXPECT_EQ(entry, cache.Get("a", generation));
+  cache.Clear();
+  cache.Put("a", entry, 10, generation);
+  EXPECT_FALSE(IsCached(cache, "a"));
+
+  // listings started after the change are cached again
+  List(cache, "b", 10);
+  EXPECT_TRUE(IsCached(cache, "b"));
+}
@@ -29,6 +29,8 @@
 #include "utils/Variant.h"
 
 #include <random>
+#include <thread>
+#include <vector>
 
 using namespace XFILE;
 
@@ -569,6 +571,34 @@ TEST_F(TestWebServer, CanGetFile)
   CheckHtmlTestFileResponse(curl);
 }
 
+TEST_F(TestWebServer, CanGetFilesConcurrently)
+{
+  constexpr int clients = 8;
+  std::vector<std::string> results(clients);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < clients; i++)
+  {
+    threads.emplace_back([this, &results, i]() {
+      CCurlFile curl;
+      curl.SetRequestHeader(MHD_HTTP_HEADER_RANGE, "");
+      curl.Get(GetUrlOfTestFile(TEST_FILES_HTML), results[i]);
+    });
+  }
+  for (auto& thread : threads)
+    thread.join();
+
+  for (const auto& result : results)
+    EXPECT_STREQ(TEST_FILES_DATA, result.c_str());
+
+  const CWebServer::Statistics statistics = webserver.GetStatistics();
+  EXPECT_GE(statistics.requests, static_cast<uint64_t>(clients));
+  EXPECT_GE(statistics.maxHandlerTime, statistics.handlerTime / statistics.requests);
+  // every client opened its own connection, the queue wait is measured once per connection
+  EXPECT_GE(statistics.connections, static_cast<uint64_t>(clients));
+  EXPECT_LE(statistics.connections, statistics.requests);
+  EXPECT_GE(statistics.maxQueueWait, statistics.queueWait / statistics.connections);
+}
+
 TEST_F(TestWebServer, CanGetFileForcingNoCache)
 {
   // check non-cacheable HTML with Control-Cache: no-cache
@@ -632,6 +662,45 @@ TEST_F(TestWebServer, CanGetCachedFileWithExactIfModifiedSince)
   CheckRangesTestFileResponse(curl, MHD_HTTP_NOT_MODIFIED, true);
 }
 
+TEST_F(TestWebServer, CanGetCachedFileWithMatchingIfNoneMatch)
+{
+  // get the entity tag of the file
+  std::string result;
+  CCurlFile curl;
+  curl.SetRequestHeader(MHD_HTTP_HEADER_RANGE, "");
+  ASSERT_TRUE(curl.Get(GetUrlOfTestFile(TEST_FILES_RANGES), result));
+  const std::string entityTag = curl.GetHttpHeader().GetValue(MHD_HTTP_HEADER_ETAG);
+  ASSERT_FALSE(entityTag.empty());
+
+  // get the file with a list of entity tags containing the weak version of it
+  result.clear();
+  CCurlFile curlCached;
+  curlCached.SetRequestHeader(MHD_HTTP_HEADER_RANGE, "");
+  curlCached.SetRequestHeader(MHD_HTTP_HEADER_IF_NONE_MATCH, "\"other\", W/" + entityTag);
+  ASSERT_TRUE(curlCached.Get(GetUrlOfTestFile(TEST_FILES_RANGES), result));
+  ASSERT_TRUE(result.empty());
+  CheckRangesTestFileResponse(curlCached, MHD_HTTP_NOT_MODIFIED, true);
+  EXPECT_STREQ(entityTag.c_str(),
+               curlCached.GetHttpHeader().GetValue(MHD_HTTP_HEADER_ETAG).c_str());
+}
+
+TEST_F(TestWebServer, CanGetCachedFileWithOtherIfNoneMatch)
+{
+  // get the last modified date of the file
+  CDateTime lastModified;
+  ASSERT_TRUE(GetLastModifiedOfTestFile(TEST_FILES_RANGES, lastModified));
+
+  // If-None-Match takes precedence over a matching If-Modified-Since
+  std::string result;
+  CCurlFile curl;
+  curl.SetRequestHeader(MHD_HTTP_HEADER_RANGE, "");
+  curl.SetRequestHeader(MHD_HTTP_HEADER_IF_NONE_MATCH, "\"other\"");
+  curl.SetRequestHeader(MHD_HTTP_HEADER_IF_MODIFIED_SINCE, lastModified.GetAsRFC1123DateTime());
+  ASSERT_TRUE(curl.Get(GetUrlOfTestFile(TEST_FILES_RANGES), result));
+  EXPECT_STREQ(TEST_FILES_DATA_RANGES, result.c_str());
+  CheckRangesTestFileResponse(curl);
+}
+
 TEST_F(TestWebServer, CanGetCachedFileWithNewerIfModifiedSince)
 {
   // get the last modified date of the file
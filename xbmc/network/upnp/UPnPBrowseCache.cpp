@@ -0,0 +1,119 @@
+/*
+ *  Copyright (C) 2023 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "UPnPBrowseCache.h"
+
+#include <algorithm>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+using namespace UPNP;
+
+CUPnPBrowseCache::CUPnPBrowseCache() : CUPnPBrowseCache(Limits())
+{
+}
+
+CUPnPBrowseCache::CUPnPBrowseCache(const Limits& limits) : m_limits(limits)
+{
+}
+
+std::shared_ptr<CUPnPBrowseCache::CEntry> CUPnPBrowseCache::Get(const std::string& id,
+                                                                unsigned int& generation)
+{
+  std::unique_lock<CCriticalSection> lock(m_section);
+  generation = m_generation;
+
+  auto it = m_entries.find(id);
+  if (it == m_entries.end())
+    return nullptr;
+
+  const auto now = std::chrono::steady_clock::now();
+  if (now - it->second->m_lastAccess > m_limits.idleTime)
+  {
+    m_entries.erase(it);
+    return nullptr;
+  }
+
+  it->second->m_lastUsed = ++m_uses;
+  it->second->m_lastAccess = now;
+  return it->second;
+}
+
+void CUPnPBrowseCache::Put(const std::string& id,
+                           const std::shared_ptr<CEntry>& entry,
+                           size_t itemCount,
+                           unsigned int generation)
+{
+  std::vector<std::shared_ptr<CEntry>> trimmed;
+  {
+    std::unique_lock<CCriticalSection> lock(m_section);
+
+    // the library has changed while the container was listed
+    if (generation != m_generation)
+      return;
+
+    const auto now = std::chrono::steady_clock::now();
+    entry->m_itemCount = itemCount;
+    entry->m_lastUsed = ++m_uses;
+    entry->m_lastAccess = now;
+    m_entries[id] = entry;
+
+    std::vector<std::pair<unsigned int, std::string>> lru;
+    size_t items = 0;
+    size_t didlSize = 0;
+    for (auto it = m_entries.begin(); it != m_entries.end();)
+    {
+      if (now - it->second->m_lastAccess > m_limits.idleTime)
+      {
+        it = m_entries.erase(it);
+        continue;
+      }
+      lru.emplace_back(it->second->m_lastUsed, it->first);
+      items += it->second->m_itemCount;
+      didlSize += it->second->didlSize;
+      ++it;
+    }
+    std::sort(lru.begin(), lru.end());
+
+    for (const auto& cached : lru)
+    {
+      auto it = m_entries.find(cached.second);
+      // the listing being paged through is kept, even if it is larger than the limit
+      if (it->second != entry &&
+          (m_entries.size() > m_limits.maxContainers || items > m_limits.maxItems))
+      {
+        items -= it->second->m_itemCount;
+        didlSize -= it->second->didlSize;
+        m_entries.erase(it);
+      }
+      else if (didlSize > m_limits.maxDidlSize)
+      {
+        didlSize -= it->second->didlSize;
+        trimmed.push_back(it->second);
+      }
+    }
+  }
+
+  // the listings are kept, the DIDL is rebuilt on demand
+  for (const auto& cached : trimmed)
+    cached->ClearDidl();
+}
+
+void CUPnPBrowseCache::Clear()
+{
+  std::unique_lock<CCriticalSection> lock(m_section);
+  ++m_generation;
+  m_entries.clear();
+}
+
+size_t CUPnPBrowseCache::Size() const
+{
+  std::unique_lock<CCriticalSection> lock(m_section);
+  return m_entries.size();
+}
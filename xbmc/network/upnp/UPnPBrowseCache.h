@@ -0,0 +1,106 @@
+/*
+ *  Copyright (C) 2023 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "threads/CriticalSection.h"
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <string>
+
+namespace UPNP
+{
+
+/*!
+ \brief Listings of library containers and the DIDL of their items, so that clients paging
+ through large containers don't have them rebuilt for every page.
+
+ The least recently used listings are dropped once there are too many of them or they hold too
+ many items in total, the listing being paged through is always kept. If the DIDL of all
+ listings grows too large it is dropped, but the listings themselves are kept. Listings no
+ client has paged through for a while are dropped.
+
+ Any change to the library invalidates all listings with Clear(). A listing that was built
+ while the library changed isn't cached, the generation returned by Get() tells Put() whether
+ that happened.
+ */
+class CUPnPBrowseCache
+{
+public:
+  struct Limits
+  {
+    size_t maxContainers = 8;
+    size_t maxItems = 100000;
+    size_t maxDidlSize = 16 * 1024 * 1024;
+    std::chrono::steady_clock::duration idleTime = std::chrono::minutes(5);
+  };
+
+  class CEntry
+  {
+  public:
+    virtual ~CEntry() = default;
+
+    /*!
+     \brief Drop the DIDL built so far, it is rebuilt on demand. Called without the cache lock
+     held, so it may wait for a response that is being built from the entry.
+     */
+    virtual void ClearDidl() = 0;
+
+    std::atomic<size_t> didlSize{0}; ///< size of the DIDL built so far
+
+  private:
+    friend class CUPnPBrowseCache;
+
+    size_t m_itemCount = 0;
+    unsigned int m_lastUsed = 0;
+    std::chrono::steady_clock::time_point m_lastAccess;
+  };
+
+  CUPnPBrowseCache();
+  explicit CUPnPBrowseCache(const Limits& limits);
+
+  /*!
+   \brief Get the cached listing of a container
+   \param id the container and the kind of listing
+   \param generation [out] the current generation, to be passed to Put() once a listing was built
+   \return the listing, nullptr if it isn't cached
+   */
+  std::shared_ptr<CEntry> Get(const std::string& id, unsigned int& generation);
+
+  /*!
+   \brief Cache the listing of a container, or mark it as used if it is already cached
+   \param id the container and the kind of listing
+   \param entry the listing, which doesn't change once it is cached
+   \param itemCount the number of items in the listing
+   \param generation the generation returned by Get() before the listing was built
+   */
+  void Put(const std::string& id,
+           const std::shared_ptr<CEntry>& entry,
+           size_t itemCount,
+           unsigned int generation);
+
+  /*!
+   \brief Drop all listings, including the ones currently being built
+   */
+  void Clear();
+
+  size_t Size() const;
+
+private:
+  const Limits m_limits;
+
+  mutable CCriticalSection m_section;
+  std::map<std::string, std::shared_ptr<CEntry>> m_entries;
+  unsigned int m_generation = 0;
+  unsigned int m_uses = 0;
+};
+
+} // namespace UPNP
@@ -43,6 +43,10 @@
 #include "view/GUIViewState.h"
 #include "xbmc/interfaces/AnnouncementManager.h"
 
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
 #include <Platinum/Source/Platinum/Platinum.h>
 
 NPT_SET_LOCAL_LOGGER("xbmc.upnp.server")
@@ -56,6 +60,27 @@ namespace UPNP
 
 NPT_UInt32 CUPnPServer::m_MaxReturnedItems = 0;
 
+struct CUPnPServer::CBrowseCacheEntry : public CUPnPBrowseCache::CEntry
+{
+    struct Fragment
+    {
+        bool       built = false;
+        NPT_String didl; // empty if the item couldn't be built
+    };
+
+    void ClearDidl() override
+    {
+        NPT_AutoLock lock(mutex);
+        didl.clear();
+        didlSize = 0;
+    }
+
+    NPT_Mutex     mutex;
+    CFileItemList items;
+    // DIDL of the items built so far, by filter and client
+    std::map<std::string, std::vector<Fragment> > didl;
+};
+
 const char* audio_containers[] = { "musicdb://genres/", "musicdb://artists/", "musicdb://albums/",
                                    "musicdb://songs/", "musicdb://recentlyaddedalbums/", "musicdb://years/",
                                    "musicdb://singles/" };
@@ -146,11 +171,13 @@ CUPnPServer::OnScanCompleted(int type)
 void
 CUPnPServer::UpdateContainer(const std::string& id)
 {
-    std::map<std::string, std::pair<bool, unsigned long> >::iterator itr = m_UpdateIDs.find(id);
-    unsigned long count = 0;
-    if (itr != m_UpdateIDs.end())
-        count = ++itr->second.second;
-    m_UpdateIDs[id] = std::make_pair(true, count);
+    { NPT_AutoLock lock(m_UpdateIDsMutex);
+      std::map<std::string, std::pair<bool, unsigned long> >::iterator itr = m_UpdateIDs.find(id);
+      unsigned long count = 0;
+      if (itr != m_UpdateIDs.end())
+          count = ++itr->second.second;
+      m_UpdateIDs[id] = std::make_pair(true, count);
+    }
     PropagateUpdates();
 }
 
@@ -179,11 +206,13 @@ CUPnPServer::PropagateUpdates()
         buffer.append(",");
 
     // only broadcast ids with modified bit set
-    for (itr = m_UpdateIDs.begin(); itr != m_UpdateIDs.end(); ++itr) {
-        if (itr->second.first) {
-          buffer.append(StringUtils::Format("{},{},", itr->first, itr->second.second));
-          itr->second.first = false;
-        }
+    { NPT_AutoLock lock(m_UpdateIDsMutex);
+      for (itr = m_UpdateIDs.begin(); itr != m_UpdateIDs.end(); ++itr) {
+          if (itr->second.first) {
+            buffer.append(StringUtils::Format("{},{},", itr->first, itr->second.second));
+            itr->second.first = false;
+          }
+      }
     }
 
     // set the value, Platinum will clear ContainerUpdateIDs after sending
@@ -199,6 +228,82 @@ failed:
     m_logger->error("Unable to propagate updates");
 }
 
+/*----------------------------------------------------------------------
+|   CUPnPServer::GetUpdateId
++---------------------------------------------------------------------*/
+NPT_String
+CUPnPServer::GetUpdateId(const std::string& id)
+{
+    // containers which are tracked report their own ContainerUpdateID,
+    // everything else the SystemUpdateID
+    if (!id.empty()) {
+        NPT_AutoLock lock(m_UpdateIDsMutex);
+        std::string other_id(id);
+        if (URIUtils::HasSlashAtEnd(other_id))
+            URIUtils::RemoveSlashAtEnd(other_id);
+        else
+            URIUtils::AddSlashAtEnd(other_id);
+
+        std::map<std::string, std::pair<bool, unsigned long> >::const_iterator itr = m_UpdateIDs.find(id);
+        if (itr == m_UpdateIDs.end())
+            itr = m_UpdateIDs.find(other_id);
+        if (itr != m_UpdateIDs.end())
+            return NPT_String::FromIntegerU(itr->second.second);
+    }
+
+    PLT_Service* service = NULL;
+    NPT_String system_update_id;
+    if (NPT_FAILED(FindServiceById("urn:upnp-org:serviceId:ContentDirectory", service)) ||
+        NPT_FAILED(service->GetStateVariableValue("SystemUpdateID", system_update_id)) ||
+        system_update_id.IsEmpty())
+        return "0";
+
+    return system_update_id;
+}
+
+/*----------------------------------------------------------------------
+|   CUPnPServer::IsCacheableContainer
++---------------------------------------------------------------------*/
+bool
+CUPnPServer::IsCacheableContainer(const NPT_String& id)
+{
+    // only library listings, their changes are announced
+    std::string path(id.GetChars());
+    return URIUtils::IsMusicDb(path) || URIUtils::IsVideoDb(path) ||
+           StringUtils::StartsWithNoCase(path, "library://video/") ||
+           StringUtils::StartsWith(path, "virtualpath://upnproot");
+}
+
+/*----------------------------------------------------------------------
+|   CUPnPServer::GetCachedContainer
++---------------------------------------------------------------------*/
+std::shared_ptr<CUPnPServer::CBrowseCacheEntry>
+CUPnPServer::GetCachedContainer(const std::string& id, unsigned int& generation)
+{
+    return std::static_pointer_cast<CBrowseCacheEntry>(m_BrowseCache.Get(id, generation));
+}
+
+/*----------------------------------------------------------------------
+|   CUPnPServer::CacheContainer
++---------------------------------------------------------------------*/
+void
+CUPnPServer::CacheContainer(const std::string& id,
+                            const std::shared_ptr<CBrowseCacheEntry>& entry,
+                            unsigned int generation)
+{
+    // the listing doesn't change once it is cached
+    m_BrowseCache.Put(id, entry, static_cast<size_t>(entry->items.Size()), generation);
+}
+
+/*----------------------------------------------------------------------
+|   CUPnPServer::ClearBrowseCache
++---------------------------------------------------------------------*/
+void
+CUPnPServer::ClearBrowseCache()
+{
+    m_BrowseCache.Clear();
+}
+
 /*----------------------------------------------------------------------
 |   CUPnPServer::SetupIcons
 +---------------------------------------------------------------------*/
@@ -469,6 +574,10 @@ void CUPnPServer::Announce(AnnouncementFlag flag,
         message != "OnScanFinished")
       return;
 
+    // listings can't be matched to the changed items, e.g. genres or years
+    if (message != "OnScanStarted")
+      ClearBrowseCache();
+
     if (data.isNull()) {
       if (message == "OnScanStarted" || message == "OnCleanStarted")
       {
@@ -662,10 +771,7 @@ CUPnPServer::OnBrowseMetadata(PLT_ActionReference&          action,
     NPT_CHECK(action->SetArgumentValue("NumberReturned", "1"));
     NPT_CHECK(action->SetArgumentValue("TotalMatches", "1"));
 
-    // update ID may be wrong here, it should be the one of the container?
-    NPT_CHECK(action->SetArgumentValue("UpdateId", "0"));
-
-    //! @todo We need to keep track of the overall SystemUpdateID of the CDS
+    NPT_CHECK(action->SetArgumentValue("UpdateId", GetUpdateId((const char*)id)));
 
     return NPT_SUCCESS;
 }
@@ -682,7 +788,6 @@ CUPnPServer::OnBrowseDirectChildren(PLT_ActionReference&          action,
                                     const char*                   sort_criteria,
                                     const PLT_HttpRequestContext& context)
 {
-    CFileItemList items;
     NPT_String parent_id = TranslateWMPObjectId(object_id, m_logger);
 
     m_logger->info("Received Browse DirectChildren request for object '{}', with sort criteria {}",
@@ -693,6 +798,35 @@ CUPnPServer::OnBrowseDirectChildren(PLT_ActionReference&          action,
         return NPT_FAILURE;
     }
 
+    // Don't pass parent_id if action is Search not BrowseDirectChildren, as
+    // we want the engine to determine the best parent id, not necessarily the one
+    // passed
+    NPT_String action_name = action->GetActionDesc().GetName();
+    const char* response_parent_id = (action_name.Compare("Search", true)==0)?NULL:parent_id.GetChars();
+
+    // clients page through large containers, only list them once
+    const bool cacheable = IsCacheableContainer(parent_id);
+    const std::string cache_id = StringUtils::Format("{}|{}", (const char*)parent_id,
+                                                     response_parent_id ? "" : "search");
+    unsigned int cache_generation = 0;
+    std::shared_ptr<CBrowseCacheEntry> entry;
+    if (cacheable)
+        entry = GetCachedContainer(cache_id, cache_generation);
+
+    if (entry) {
+        m_logger->debug("Using cached listing of '{}'", (const char*)parent_id);
+
+        NPT_Result result;
+        { NPT_AutoLock lock(entry->mutex);
+          result = BuildResponse(action, entry->items, filter, starting_index, requested_count,
+                                 sort_criteria, context, response_parent_id, entry.get());
+        }
+        CacheContainer(cache_id, entry, cache_generation);
+        return result;
+    }
+
+    entry = std::make_shared<CBrowseCacheEntry>();
+    CFileItemList& items = entry->items;
     items.SetPath(std::string(parent_id));
 
     // guard against loading while saving to the same cache file
@@ -761,19 +895,17 @@ CUPnPServer::OnBrowseDirectChildren(PLT_ActionReference&          action,
       }
     }
 
-    // Don't pass parent_id if action is Search not BrowseDirectChildren, as
-    // we want the engine to determine the best parent id, not necessarily the one
-    // passed
-    NPT_String action_name = action->GetActionDesc().GetName();
-    return BuildResponse(
-        action,
-        items,
-        filter,
-        starting_index,
-        requested_count,
-        sort_criteria,
-        context,
-        (action_name.Compare("Search", true)==0)?NULL:parent_id.GetChars());
+    if (!cacheable)
+        return BuildResponse(action, items, filter, starting_index, requested_count,
+                             sort_criteria, context, response_parent_id);
+
+    NPT_Result result;
+    { NPT_AutoLock lock(entry->mutex);
+      result = BuildResponse(action, items, filter, starting_index, requested_count,
+                             sort_criteria, context, response_parent_id, entry.get());
+    }
+    CacheContainer(cache_id, entry, cache_generation);
+    return result;
 }
 
 /*----------------------------------------------------------------------
@@ -787,14 +919,16 @@ CUPnPServer::BuildResponse(PLT_ActionReference&          action,
                            NPT_UInt32                    requested_count,
                            const char*                   sort_criteria,
                            const PLT_HttpRequestContext& context,
-                           const char*                   parent_id /* = NULL */)
+                           const char*                   parent_id /* = NULL */,
+                           CBrowseCacheEntry*            cache_entry /* = NULL */)
 {
     NPT_COMPILER_UNUSED(sort_criteria);
 
     m_logger->debug("Building UPnP response with filter '{}', starting @ {} with {} requested",
                     filter, starting_index, requested_count);
 
-    // we will reuse this ThumbLoader for all items
+    // we will reuse this ThumbLoader for all items, it's only started once
+    // an item actually has to be built
     NPT_Reference<CThumbLoader> thumb_loader;
 
     if (URIUtils::IsVideoDb(items.GetPath()) ||
@@ -808,9 +942,7 @@ CUPnPServer::BuildResponse(PLT_ActionReference&          action,
 
         thumb_loader = NPT_Reference<CThumbLoader>(new CMusicThumbLoader());
     }
-    if (!thumb_loader.IsNull()) {
-        thumb_loader->OnLoaderStart();
-    }
+    bool thumb_loader_started = false;
 
     // this isn't pretty but needed to properly hide the addons node from clients
     if (StringUtils::StartsWith(items.GetPath(), "library")) {
@@ -826,21 +958,54 @@ CUPnPServer::BuildResponse(PLT_ActionReference&          action,
     NPT_UInt32 max_count  = (requested_count == 0)?m_MaxReturnedItems:std::min((unsigned long)requested_count, (unsigned long)m_MaxReturnedItems);
     NPT_UInt32 stop_index = std::min((unsigned long)(starting_index + max_count), (unsigned long)items.Size()); // don't return more than we can
 
+    // the DIDL depends on the requested properties and on the address and
+    // quirks of the client
+    std::vector<CBrowseCacheEntry::Fragment>* fragments = NULL;
+    if (cache_entry) {
+        const NPT_String* user_agent = context.GetRequest().GetHeaders().GetHeaderValue(NPT_HTTP_HEADER_USER_AGENT);
+        const NPT_String* server = context.GetRequest().GetHeaders().GetHeaderValue(NPT_HTTP_HEADER_SERVER);
+        std::string variant = StringUtils::Format("{}|{}:{}|{}|{}", filter ? filter : "",
+            (const char*)context.GetLocalAddress().GetIpAddress().ToString(),
+            context.GetLocalAddress().GetPort(),
+            user_agent ? (const char*)*user_agent : "",
+            server ? (const char*)*server : "");
+
+        fragments = &cache_entry->didl[variant];
+        fragments->resize(items.Size());
+    }
+
     NPT_Cardinal count = 0;
     NPT_Cardinal total = items.Size();
     NPT_String didl = didl_header;
     PLT_MediaObjectReference object;
     for (unsigned long i=starting_index; i<stop_index; ++i) {
-        object = Build(items[i], true, context, thumb_loader, parent_id);
-        if (object.IsNull()) {
+        NPT_String tmp;
+        if (fragments && (*fragments)[i].built) {
+            tmp = (*fragments)[i].didl;
+        }
+        else {
+            if (!thumb_loader.IsNull() && !thumb_loader_started) {
+                thumb_loader->OnLoaderStart();
+                thumb_loader_started = true;
+            }
+
+            object = Build(items[i], true, context, thumb_loader, parent_id);
+            if (!object.IsNull())
+                NPT_CHECK(PLT_Didl::ToDidl(*object.AsPointer(), filter, tmp));
+
+            if (fragments) {
+                (*fragments)[i].built = true;
+                (*fragments)[i].didl = tmp;
+                cache_entry->didlSize += tmp.GetLength();
+            }
+        }
+
+        if (tmp.IsEmpty()) {
             // don't tell the client this item ever existed
             --total;
             continue;
         }
 
-        NPT_String tmp;
-        NPT_CHECK(PLT_Didl::ToDidl(*object.AsPointer(), filter, tmp));
-
         // Neptunes string growing is dead slow for small additions
         if (didl.GetCapacity() < tmp.GetLength() + didl.GetLength()) {
             didl.Reserve((tmp.GetLength() + didl.GetLength())*2);
@@ -856,7 +1021,7 @@ CUPnPServer::BuildResponse(PLT_ActionReference&          action,
     NPT_CHECK(action->SetArgumentValue("Result", didl));
     NPT_CHECK(action->SetArgumentValue("NumberReturned", NPT_String::FromInteger(count)));
     NPT_CHECK(action->SetArgumentValue("TotalMatches", NPT_String::FromInteger(total)));
-    NPT_CHECK(action->SetArgumentValue("UpdateId", "0"));
+    NPT_CHECK(action->SetArgumentValue("UpdateId", GetUpdateId(parent_id ? parent_id : "")));
     return NPT_SUCCESS;
 }
 
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include "UPnPBrowseCache.h"
 #include "interfaces/IAnnouncer.h"
 #include "utils/logtypes.h"
 
@@ -109,9 +110,19 @@ public:
 
 
   private:
+    struct CBrowseCacheEntry;
+
     void OnScanCompleted(int type);
     void UpdateContainer(const std::string& id);
     void PropagateUpdates();
+    NPT_String GetUpdateId(const std::string& id);
+
+    static bool IsCacheableContainer(const NPT_String& id);
+    std::shared_ptr<CBrowseCacheEntry> GetCachedContainer(const std::string& id, unsigned int& generation);
+    void CacheContainer(const std::string& id,
+                        const std::shared_ptr<CBrowseCacheEntry>& entry,
+                        unsigned int generation);
+    void ClearBrowseCache();
 
     PLT_MediaObject* Build(const std::shared_ptr<CFileItem>& item,
                            bool with_count,
@@ -125,7 +136,8 @@ public:
                              NPT_UInt32                    requested_count,
                              const char*                   sort_criteria,
                              const PLT_HttpRequestContext& context,
-                             const char*                   parent_id /* = NULL */);
+                             const char*                   parent_id /* = NULL */,
+                             CBrowseCacheEntry*            cache_entry = NULL);
 
     // class methods
     static void DefaultSortItems(CFileItemList& items);
@@ -145,9 +157,12 @@ public:
     NPT_Mutex m_FileMutex;
     NPT_Map<NPT_String, NPT_String> m_FileMap;
 
+    NPT_Mutex m_UpdateIDsMutex;
     std::map<std::string, std::pair<bool, unsigned long> > m_UpdateIDs;
     bool m_scanning;
 
+    CUPnPBrowseCache m_BrowseCache;
+
     Logger m_logger;
 
   public:
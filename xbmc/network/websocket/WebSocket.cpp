@@ -8,6 +8,7 @@
 
 #include "WebSocket.h"
 
+#include "utils/CompressionUtils.h"
 #include "utils/EndianSwap.h"
 #include "utils/HttpParser.h"
 #include "utils/StringUtils.h"
@@ -29,6 +30,15 @@
 
 #define LENGTH_MIN    0x2
 
+// RSV1 as returned by CWebSocketFrame::GetExtension()
+#define EXTENSION_DEFLATE 0x04
+// the empty stored block ending every deflated message, which isn't transmitted
+#define DEFLATE_TRAILER     "\x00\x00\xff\xff"
+#define DEFLATE_TRAILER_LEN 4
+// short messages don't get any smaller
+#define DEFLATE_MIN_LENGTH  256
+#define INFLATE_MAX_LENGTH  (1024 * 1024)
+
 CWebSocketFrame::CWebSocketFrame(const char* data, uint64_t length)
 {
   reset();
@@ -43,9 +53,7 @@ CWebSocketFrame::CWebSocketFrame(const char* data, uint64_t length)
   // Get the FIN flag
   m_final = ((m_data[0] & MASK_FIN) == MASK_FIN);
   // Get the RSV1 - RSV3 flags
-  m_extension |= m_data[0] & MASK_RSV1;
-  m_extension |= (m_data[0] & MASK_RSV2) << 1;
-  m_extension |= (m_data[0] & MASK_RSV3) << 2;
+  m_extension = (m_data[0] & MASK_RSV) >> 4;
   // Get the opcode
   m_opcode = (WebSocketFrameOpcode)(m_data[0] & MASK_OPCODE);
   if (m_opcode >= WebSocketUnknownFrame)
@@ -351,6 +359,15 @@ const CWebSocketMessage* CWebSocket::Handle(const char* &buffer, size_t &length,
           return msg;
         }
 
+        // only the first frame of a message may be marked as compressed
+        if ((frame->GetExtension() & EXTENSION_DEFLATE) == EXTENSION_DEFLATE &&
+            (!m_deflate || frame->GetOpcode() == WebSocketContinuationFrame))
+        {
+          CLog::Log(LOGINFO, "WebSocket: Unexpected compressed frame received");
+          delete frame;
+          return NULL;
+        }
+
         if (m_message == NULL && (m_message = GetMessage()) == NULL)
         {
           CLog::Log(LOGINFO, "WebSocket: Could not allocate a new websocket message");
@@ -369,6 +386,14 @@ const CWebSocketMessage* CWebSocket::Handle(const char* &buffer, size_t &length,
 
         CWebSocketMessage *msg = m_message;
         m_message = NULL;
+
+        if ((msg->GetFrames().front()->GetExtension() & EXTENSION_DEFLATE) == EXTENSION_DEFLATE)
+        {
+          CWebSocketMessage* inflated = Inflate(msg);
+          delete msg;
+          return inflated;
+        }
+
         return msg;
       }
 
@@ -408,7 +433,20 @@ const CWebSocketMessage* CWebSocket::Handle(const char* &buffer, size_t &length,
 
 const CWebSocketMessage* CWebSocket::Send(WebSocketFrameOpcode opcode, const char* data /* = NULL */, uint32_t length /* = 0 */)
 {
-  CWebSocketFrame *frame = GetFrame(opcode, data, length);
+  CWebSocketFrame* frame = NULL;
+  if (m_deflate && data != NULL && length >= DEFLATE_MIN_LENGTH &&
+      (opcode == WebSocketTextFrame || opcode == WebSocketBinaryFrame))
+  {
+    std::string compressed;
+    if (CCompressionUtils::DeflateRaw(data, length, compressed) &&
+        compressed.size() < length + DEFLATE_TRAILER_LEN)
+      frame = GetFrame(opcode, compressed.c_str(),
+                       static_cast<uint32_t>(compressed.size() - DEFLATE_TRAILER_LEN), true,
+                       false, 0, EXTENSION_DEFLATE);
+  }
+
+  if (frame == NULL)
+    frame = GetFrame(opcode, data, length);
   if (frame == NULL || !frame->IsValid())
   {
     CLog::Log(LOGINFO, "WebSocket: Trying to send an invalid frame");
@@ -428,3 +466,33 @@ const CWebSocketMessage* CWebSocket::Send(WebSocketFrameOpcode opcode, const cha
 
   return NULL;
 }
+
+CWebSocketMessage* CWebSocket::Inflate(const CWebSocketMessage* message)
+{
+  const std::vector<const CWebSocketFrame*>& frames = message->GetFrames();
+
+  std::string compressed;
+  for (const auto& frame : frames)
+  {
+    if (frame->GetApplicationData() != NULL)
+      compressed.append(frame->GetApplicationData(), static_cast<size_t>(frame->GetLength()));
+  }
+  compressed.append(DEFLATE_TRAILER, DEFLATE_TRAILER_LEN);
+
+  std::string data;
+  if (!CCompressionUtils::InflateRaw(compressed.c_str(), compressed.size(), data,
+                                     INFLATE_MAX_LENGTH))
+  {
+    CLog::Log(LOGINFO, "WebSocket: Invalid or too large compressed message received");
+    return NULL;
+  }
+
+  CWebSocketMessage* msg = GetMessage();
+  if (msg == NULL)
+    return NULL;
+
+  // hand the uncompressed data on as a single unfragmented frame
+  msg->AddFrame(GetFrame(frames.front()->GetOpcode(), data.c_str(),
+                         static_cast<uint32_t>(data.size())));
+  return msg;
+}
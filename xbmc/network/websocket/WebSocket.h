@@ -107,7 +107,7 @@ protected:
 class CWebSocket
 {
 public:
-  CWebSocket() { m_state = WebSocketStateNotConnected; m_message = NULL; }
+  CWebSocket() { m_state = WebSocketStateNotConnected; m_message = NULL; m_deflate = false; }
   virtual ~CWebSocket()
   {
     if (m_message)
@@ -116,6 +116,7 @@ public:
 
   int GetVersion() { return m_version; }
   WebSocketState GetState() { return m_state; }
+  bool IsDeflateEnabled() const { return m_deflate; }
 
   virtual bool Handshake(const char* data, size_t length, std::string &response) = 0;
   virtual const CWebSocketMessage* Handle(const char* &buffer, size_t &length, bool &send);
@@ -129,8 +130,13 @@ protected:
   int m_version;
   WebSocketState m_state;
   CWebSocketMessage *m_message;
+  // whether the permessage-deflate extension (RFC 7692) has been negotiated
+  bool m_deflate;
 
   virtual CWebSocketFrame* GetFrame(const char* data, uint64_t length) = 0;
   virtual CWebSocketFrame* GetFrame(WebSocketFrameOpcode opcode, const char* data = NULL, uint32_t length = 0, bool final = true, bool masked = false, int32_t mask = 0, int8_t extension = 0) = 0;
   virtual CWebSocketMessage* GetMessage() = 0;
+
+private:
+  CWebSocketMessage* Inflate(const CWebSocketMessage* message);
 };
@@ -31,9 +31,53 @@
 #define WS_HEADER_PROTOCOL      "Sec-WebSocket-Protocol"
 #define WS_HEADER_PROTOCOL_LC   "sec-websocket-protocol"    // "Sec-WebSocket-Protocol"
 
+#define WS_HEADER_EXTENSIONS    "Sec-WebSocket-Extensions"
+#define WS_HEADER_EXTENSIONS_LC "sec-websocket-extensions"  // "Sec-WebSocket-Extensions"
+
 #define WS_PROTOCOL_JSONRPC     "jsonrpc.xbmc.org"
 #define WS_HEADER_UPGRADE_VALUE "websocket"
 
+#define WS_EXTENSION_DEFLATE    "permessage-deflate"
+// every message is compressed on its own so no state has to be kept per connection
+#define WS_EXTENSION_DEFLATE_RESPONSE \
+  WS_EXTENSION_DEFLATE "; server_no_context_takeover; client_no_context_takeover"
+
+namespace
+{
+bool AcceptDeflateOffer(const std::string& offer)
+{
+  std::vector<std::string> parameters = StringUtils::Split(offer, ";");
+  if (parameters.empty() || StringUtils::Trim(parameters.front()) != WS_EXTENSION_DEFLATE)
+    return false;
+
+  for (auto parameter = parameters.begin() + 1; parameter != parameters.end(); ++parameter)
+  {
+    std::string name = StringUtils::Trim(*parameter);
+    std::string value;
+    size_t pos = name.find('=');
+    if (pos != std::string::npos)
+    {
+      value = name.substr(pos + 1);
+      name.erase(pos);
+      StringUtils::Trim(name);
+      StringUtils::Trim(value);
+      StringUtils::Trim(value, "\"");
+    }
+
+    // any window size the client uses can be inflated, the server always uses the largest one
+    if (name == "server_no_context_takeover" || name == "client_no_context_takeover" ||
+        name == "client_max_window_bits")
+      continue;
+    if (name == "server_max_window_bits" && value == "15")
+      continue;
+
+    return false;
+  }
+
+  return true;
+}
+} // unnamed namespace
+
 bool CWebSocketV13::Handshake(const char* data, size_t length, std::string &response)
 {
   std::string strHeader(data, length);
@@ -127,6 +171,14 @@ bool CWebSocketV13::Handshake(const char* data, size_t length, std::string &resp
     }
   }
 
+  // There might be a "Sec-WebSocket-Extensions" header offering permessage-deflate
+  value = header.getValue(WS_HEADER_EXTENSIONS_LC);
+  if (value && strlen(value) > 0)
+  {
+    std::vector<std::string> offers = StringUtils::Split(value, ",");
+    m_deflate = std::any_of(offers.begin(), offers.end(), AcceptDeflateOffer);
+  }
+
   CHttpResponse httpResponse(HTTP::Get, HTTP::SwitchingProtocols, HTTP::Version1_1);
   httpResponse.AddHeader(WS_HEADER_UPGRADE, WS_HEADER_UPGRADE_VALUE);
   httpResponse.AddHeader(WS_HEADER_CONNECTION, WS_HEADER_UPGRADE);
@@ -134,6 +186,8 @@ bool CWebSocketV13::Handshake(const char* data, size_t length, std::string &resp
   httpResponse.AddHeader(WS_HEADER_ACCEPT, responseKey);
   if (!websocketProtocol.empty())
     httpResponse.AddHeader(WS_HEADER_PROTOCOL, websocketProtocol);
+  if (m_deflate)
+    httpResponse.AddHeader(WS_HEADER_EXTENSIONS, WS_EXTENSION_DEFLATE_RESPONSE);
 
   response = httpResponse.Create();
 
@@ -1065,7 +1065,29 @@ std::string CSmartPlaylistRule::FormatWhereClause(const std::string &negate, con
     }
   }
   if (query.empty())
+  {
     query = CDatabaseQueryRule::FormatWhereClause(negate, oper, param, db, strType);
+
+    // let the full-text index narrow down the rows to check for "contains" rules on titles
+    if (m_operator == OPERATOR_CONTAINS)
+    {
+      std::string table;
+      if (m_field == FieldTitle && strType == "songs")
+        table = "song";
+      else if (m_field == FieldAlbum && strType == "albums")
+        table = "album";
+      else if (m_field == FieldArtist && strType == "artists")
+        table = "artist";
+      else if (m_field == FieldTitle && (strType == "movies" || strType == "tvshows" ||
+                                         strType == "episodes" || strType == "musicvideos"))
+        table = CMediaTypes::FromString(strType);
+
+      const std::string fullText =
+          table.empty() ? "" : db.GetFullTextCondition(table, GetField(FieldId, strType), param);
+      if (!fullText.empty())
+        query = "(" + query + ") AND " + fullText;
+    }
+  }
   return query;
 }
 
@@ -1173,6 +1195,27 @@ void CSmartPlaylistRuleCombination::GetVirtualFolders(const std::string& strType
   }
 }
 
+bool CSmartPlaylistRuleCombination::IsCacheable() const
+{
+  for (const auto& it : m_combinations)
+  {
+    std::shared_ptr<CSmartPlaylistRuleCombination> combo = std::static_pointer_cast<CSmartPlaylistRuleCombination>(it);
+    if (combo && !combo->IsCacheable())
+      return false;
+  }
+
+  for (const auto& it : m_rules)
+  {
+    // dates may be relative to now and playlists may change on disk
+    std::shared_ptr<CSmartPlaylistRule> rule = std::static_pointer_cast<CSmartPlaylistRule>(it);
+    const CDatabaseQueryRule::FIELD_TYPE type = rule->GetFieldType(rule->m_field);
+    if (type == CDatabaseQueryRule::DATE_FIELD || type == CDatabaseQueryRule::PLAYLIST_FIELD)
+      return false;
+  }
+
+  return true;
+}
+
 void CSmartPlaylistRuleCombination::AddRule(const CSmartPlaylistRule &rule)
 {
   std::shared_ptr<CSmartPlaylistRule> ptr(new CSmartPlaylistRule(rule));
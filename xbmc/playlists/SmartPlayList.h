@@ -83,6 +83,7 @@ public:
                              std::set<std::string> &referencedPlaylists) const;
   void GetVirtualFolders(const std::string& strType,
                          std::vector<std::string> &virtualFolders) const;
+  bool IsCacheable() const;
 
   void AddRule(const CSmartPlaylistRule &rule);
 };
@@ -147,6 +148,11 @@ public:
   std::string GetWhereClause(const CDatabase &db, std::set<std::string> &referencedPlaylists) const;
   void GetVirtualFolders(std::vector<std::string> &virtualFolders) const;
 
+  /*! \brief whether the where clause only depends on the library content
+   Rules on dates (e.g. "in the last") and on other playlists can't be cached.
+   */
+  bool IsCacheable() const { return m_ruleCombination.IsCacheable(); }
+
   std::string GetSaveLocation() const;
 
   static void GetAvailableFields(const std::string &type, std::vector<std::string> &fieldList);
@@ -0,0 +1,188 @@
+/*
+ *  Copyright (C) 2023 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "SmartPlaylistCache.h"
+
+#include "ServiceBroker.h"
+#include "interfaces/AnnouncementManager.h"
+#include "media/MediaType.h"
+#include "utils/Variant.h"
+
+#include <mutex>
+
+using namespace ANNOUNCEMENT;
+
+namespace
+{
+// playlists are usually few, a cache full of them means the keys are unique listings
+constexpr size_t MAX_ENTRIES = 100;
+// don't keep id lists that would make the listing query larger than evaluating the rules
+constexpr size_t MAX_RESOLVED_LENGTH = 64 * 1024;
+
+bool AffectsItemType(const std::string& mediaType, const std::string& itemType)
+{
+  if (mediaType == MediaTypeMovie)
+    return itemType == "movies";
+  if (mediaType == MediaTypeMusicVideo)
+    return itemType == "musicvideos";
+  // tvshow rules use the watched state of the episodes and episode rules the tvshow details
+  if (mediaType == MediaTypeTvShow || mediaType == MediaTypeSeason ||
+      mediaType == MediaTypeEpisode)
+    return itemType == "tvshows" || itemType == "episodes";
+
+  // sets, tags etc. and changes without a type may affect anything
+  return true;
+}
+} // unnamed namespace
+
+CSmartPlaylistCache::~CSmartPlaylistCache()
+{
+  Deinitialize();
+}
+
+void CSmartPlaylistCache::Initialize()
+{
+  if (m_enabled)
+    return;
+
+  CServiceBroker::GetAnnouncementManager()->AddAnnouncer(this);
+  m_enabled = true;
+}
+
+void CSmartPlaylistCache::Deinitialize()
+{
+  if (!m_enabled)
+    return;
+
+  m_enabled = false;
+  CServiceBroker::GetAnnouncementManager()->RemoveAnnouncer(this);
+  Clear();
+}
+
+bool CSmartPlaylistCache::Lookup(const std::string& key, Query& query)
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  auto it = m_entries.find(key);
+  if (it == m_entries.end())
+    return false;
+
+  Entry& entry = it->second;
+  entry.uses++;
+  if (!entry.resolved.empty())
+  {
+    query.where = entry.resolved;
+    query.resolve = false;
+  }
+  else
+  {
+    query.where = entry.where;
+    // only resolve playlists that are listed repeatedly
+    query.resolve = entry.resolvable && entry.uses > 1;
+  }
+  query.generation = entry.generation;
+
+  return true;
+}
+
+void CSmartPlaylistCache::Add(const std::string& key,
+                              AnnouncementFlag library,
+                              const std::string& itemType,
+                              const std::string& where,
+                              bool resolvable)
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  if (m_entries.size() >= MAX_ENTRIES && m_entries.find(key) == m_entries.end())
+    m_entries.clear();
+
+  Entry& entry = m_entries[key];
+  entry.library = library;
+  entry.itemType = itemType;
+  entry.where = where;
+  entry.resolved.clear();
+  entry.resolvable = resolvable && !where.empty();
+  entry.uses = 1;
+  entry.generation++;
+}
+
+bool CSmartPlaylistCache::SetResolved(const std::string& key,
+                                      unsigned int generation,
+                                      const std::string& where)
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  auto it = m_entries.find(key);
+  if (it == m_entries.end() || it->second.generation != generation)
+    return false;
+
+  if (where.empty() || where.size() > MAX_RESOLVED_LENGTH)
+  {
+    it->second.resolvable = false;
+    return false;
+  }
+
+  it->second.resolved = where;
+  return true;
+}
+
+void CSmartPlaylistCache::Clear()
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  m_entries.clear();
+}
+
+std::string CSmartPlaylistCache::GetKey(const std::string& database,
+                                        const std::string& itemType,
+                                        const std::string& playlist)
+{
+  return database + "|" + itemType + "|" + playlist;
+}
+
+std::string CSmartPlaylistCache::FormatIdClause(const std::string& idField, const std::string& ids)
+{
+  // same as an empty rule combination when nothing matches
+  if (ids.empty())
+    return "'0'";
+
+  return idField + " IN (" + ids + ")";
+}
+
+void CSmartPlaylistCache::Announce(AnnouncementFlag flag,
+                                   const std::string& sender,
+                                   const std::string& message,
+                                   const CVariant& data)
+{
+  if (flag != VideoLibrary && flag != AudioLibrary)
+    return;
+
+  if (message == "OnUpdate" || message == "OnRemove")
+  {
+    // the music views derive songs, albums and artists from each other
+    if (flag == AudioLibrary || !data.isObject())
+      Invalidate(flag, "");
+    else
+      Invalidate(flag, data["type"].asString());
+  }
+  else if (message == "OnScanFinished" || message == "OnCleanFinished")
+    Invalidate(flag, "");
+}
+
+void CSmartPlaylistCache::Invalidate(AnnouncementFlag library, const std::string& mediaType)
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  for (auto& it : m_entries)
+  {
+    Entry& entry = it.second;
+    if (entry.library != library ||
+        (!mediaType.empty() && !AffectsItemType(mediaType, entry.itemType)))
+      continue;
+
+    // the compiled rules don't depend on the library content, only the ids do
+    entry.resolved.clear();
+    entry.uses = 0;
+    entry.generation++;
+  }
+}
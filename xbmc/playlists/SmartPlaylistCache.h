@@ -0,0 +1,123 @@
+/*
+ *  Copyright (C) 2023 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "interfaces/IAnnouncer.h"
+#include "threads/CriticalSection.h"
+
+#include <atomic>
+#include <map>
+#include <string>
+
+/*!
+ \brief Cache of the where clauses used to list the items of smart playlists.
+
+ Smart playlist rules are compiled into SQL once per playlist and item type. When
+ a playlist is listed again the ids of the matching items are resolved and stored
+ instead, so later listings (e.g. home screen widgets) no longer have to evaluate
+ the rules at all. Resolved ids are dropped again whenever the library announces
+ changes to items of the affected type.
+ */
+class CSmartPlaylistCache : public ANNOUNCEMENT::IAnnouncer
+{
+public:
+  CSmartPlaylistCache() = default;
+  ~CSmartPlaylistCache() override;
+
+  /*!
+   \brief Register for library announcements, the cache is only used by the databases
+   while it is notified about changes
+   */
+  void Initialize();
+  void Deinitialize();
+  bool IsEnabled() const { return m_enabled; }
+
+  struct Query
+  {
+    std::string where; ///< where clause to use for the listing
+    bool resolve = false; ///< whether the ids of the matching items should be resolved now
+    unsigned int generation = 0; ///< state of the entry, passed back to SetResolved()
+  };
+
+  /*!
+   \brief Look up the where clause of a smart playlist
+   \param key identifies the playlist and item type, see GetKey()
+   \param query filled with the where clause to use
+   \return true if the playlist is cached, false if it has to be compiled and added
+   */
+  bool Lookup(const std::string& key, Query& query);
+
+  /*!
+   \brief Add the compiled where clause of a smart playlist
+   \param key identifies the playlist and item type, see GetKey()
+   \param library AudioLibrary or VideoLibrary, the library whose changes affect the result
+   \param itemType type of the listed items
+   \param where the compiled where clause
+   \param resolvable whether the matching ids can be resolved for this listing
+   */
+  void Add(const std::string& key,
+           ANNOUNCEMENT::AnnouncementFlag library,
+           const std::string& itemType,
+           const std::string& where,
+           bool resolvable);
+
+  /*!
+   \brief Store the where clause matching the resolved ids of a smart playlist
+   \param key identifies the playlist and item type, see GetKey()
+   \param generation the generation returned by Lookup(), the ids are discarded if the
+   library changed in the meantime
+   \param where where clause selecting the matching ids, empty if they can't be resolved
+   \return true if the where clause was stored and can be used for the listing
+   */
+  bool SetResolved(const std::string& key, unsigned int generation, const std::string& where);
+
+  void Clear();
+
+  /*!
+   \brief Build the key of a smart playlist
+   \param database identifies the database the playlist is listed from, including its
+   location as databases of different profiles share the same name
+   \param itemType type of the listed items
+   \param playlist the smart playlist, e.g. in its JSON representation
+   */
+  static std::string GetKey(const std::string& database,
+                            const std::string& itemType,
+                            const std::string& playlist);
+
+  /*!
+   \brief Build a where clause selecting the given ids
+   \param idField the qualified id column, e.g. movie_view.idMovie
+   \param ids comma separated list of ids as returned by GROUP_CONCAT
+   */
+  static std::string FormatIdClause(const std::string& idField, const std::string& ids);
+
+  // implementation of IAnnouncer
+  void Announce(ANNOUNCEMENT::AnnouncementFlag flag,
+                const std::string& sender,
+                const std::string& message,
+                const CVariant& data) override;
+
+private:
+  struct Entry
+  {
+    ANNOUNCEMENT::AnnouncementFlag library;
+    std::string itemType;
+    std::string where;
+    std::string resolved;
+    bool resolvable = false;
+    unsigned int uses = 0;
+    unsigned int generation = 0;
+  };
+
+  void Invalidate(ANNOUNCEMENT::AnnouncementFlag library, const std::string& mediaType);
+
+  CCriticalSection m_critSection;
+  std::map<std::string, Entry> m_entries;
+  std::atomic<bool> m_enabled{false};
+};
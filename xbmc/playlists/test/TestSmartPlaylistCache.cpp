@@ -0,0 +1,146 @@
+/*
+ *  Copyright (C) 2023 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "playlists/SmartPlaylistCache.h"
+#include "utils/Variant.h"
+
+#include <gtest/gtest.h>
+
+using namespace ANNOUNCEMENT;
+
+namespace
+{
+void AnnounceUpdate(CSmartPlaylistCache& cache, AnnouncementFlag flag, const std::string& type)
+{
+  CVariant data;
+  data["type"] = type;
+  data["id"] = 1;
+  cache.Announce(flag, "xbmc", "OnUpdate", data);
+}
+
+// list a playlist once and resolve its ids on the second listing
+void Resolve(CSmartPlaylistCache& cache, const std::string& key, const std::string& where)
+{
+  CSmartPlaylistCache::Query query;
+  ASSERT_TRUE(cache.Lookup(key, query));
+  ASSERT_TRUE(query.resolve);
+  EXPECT_TRUE(cache.SetResolved(key, query.generation, where));
+}
+} // unnamed namespace
+
+TEST(TestSmartPlaylistCache, CompileThenResolve)
+{
+  CSmartPlaylistCache cache;
+  const std::string key = CSmartPlaylistCache::GetKey("MyVideos", "movies", "{}");
+  CSmartPlaylistCache::Query query;
+
+  EXPECT_FALSE(cache.Lookup(key, query));
+  cache.Add(key, VideoLibrary, "movies", "(movie_view.c14 LIKE '%Drama%')", true);
+
+  Resolve(cache, key, CSmartPlaylistCache::FormatIdClause("movie_view.idMovie", "1,5,7"));
+
+  EXPECT_TRUE(cache.Lookup(key, query));
+  EXPECT_FALSE(query.resolve);
+  EXPECT_EQ("movie_view.idMovie IN (1,5,7)", query.where);
+}
+
+TEST(TestSmartPlaylistCache, NotResolvable)
+{
+  CSmartPlaylistCache cache;
+  const std::string key = CSmartPlaylistCache::GetKey("MyMusic", "artists", "{}");
+  cache.Add(key, AudioLibrary, "artists", "(artistview.strArtist LIKE 'A%')", false);
+
+  CSmartPlaylistCache::Query query;
+  for (int i = 0; i < 3; i++)
+  {
+    EXPECT_TRUE(cache.Lookup(key, query));
+    EXPECT_FALSE(query.resolve);
+    EXPECT_EQ("(artistview.strArtist LIKE 'A%')", query.where);
+  }
+}
+
+TEST(TestSmartPlaylistCache, NoMatches)
+{
+  EXPECT_EQ("'0'", CSmartPlaylistCache::FormatIdClause("movie_view.idMovie", ""));
+}
+
+TEST(TestSmartPlaylistCache, InvalidateByType)
+{
+  CSmartPlaylistCache cache;
+  const std::string movies = CSmartPlaylistCache::GetKey("MyVideos", "movies", "{}");
+  const std::string episodes = CSmartPlaylistCache::GetKey("MyVideos", "episodes", "{}");
+  const std::string songs = CSmartPlaylistCache::GetKey("MyMusic", "songs", "{}");
+  cache.Add(movies, VideoLibrary, "movies", "movies", true);
+  cache.Add(episodes, VideoLibrary, "episodes", "episodes", true);
+  cache.Add(songs, AudioLibrary, "songs", "songs", true);
+  Resolve(cache, movies, "movie_view.idMovie IN (1)");
+  Resolve(cache, episodes, "episode_view.idEpisode IN (2)");
+  Resolve(cache, songs, "songview.idSong IN (3)");
+
+  // a tvshow change only affects tvshow and episode listings
+  AnnounceUpdate(cache, VideoLibrary, "tvshow");
+
+  CSmartPlaylistCache::Query query;
+  EXPECT_TRUE(cache.Lookup(movies, query));
+  EXPECT_EQ("movie_view.idMovie IN (1)", query.where);
+  EXPECT_TRUE(cache.Lookup(episodes, query));
+  EXPECT_EQ("episodes", query.where);
+  EXPECT_FALSE(query.resolve);
+  EXPECT_TRUE(cache.Lookup(songs, query));
+  EXPECT_EQ("songview.idSong IN (3)", query.where);
+
+  // changes without a known type affect the whole library
+  AnnounceUpdate(cache, VideoLibrary, "set");
+  EXPECT_TRUE(cache.Lookup(movies, query));
+  EXPECT_EQ("movies", query.where);
+  EXPECT_TRUE(cache.Lookup(songs, query));
+  EXPECT_EQ("songview.idSong IN (3)", query.where);
+
+  cache.Announce(AudioLibrary, "xbmc", "OnScanFinished", CVariant());
+  EXPECT_TRUE(cache.Lookup(songs, query));
+  EXPECT_EQ("songs", query.where);
+}
+
+TEST(TestSmartPlaylistCache, ChangedWhileResolving)
+{
+  CSmartPlaylistCache cache;
+  const std::string key = CSmartPlaylistCache::GetKey("MyVideos", "movies", "{}");
+  cache.Add(key, VideoLibrary, "movies", "movies", true);
+
+  CSmartPlaylistCache::Query query;
+  EXPECT_TRUE(cache.Lookup(key, query));
+  EXPECT_TRUE(query.resolve);
+
+  cache.Announce(VideoLibrary, "xbmc", "OnRemove", CVariant());
+
+  // the ids resolved before the change must not be used
+  EXPECT_FALSE(cache.SetResolved(key, query.generation, "movie_view.idMovie IN (1)"));
+  EXPECT_TRUE(cache.Lookup(key, query));
+  EXPECT_EQ("movies", query.where);
+}
+
+TEST(TestSmartPlaylistCache, TooManyIds)
+{
+  CSmartPlaylistCache cache;
+  const std::string key = CSmartPlaylistCache::GetKey("MyVideos", "movies", "{}");
+  cache.Add(key, VideoLibrary, "movies", "movies", true);
+
+  std::string ids = "1";
+  for (int i = 2; i < 20000; i++)
+    ids += "," + std::to_string(i);
+
+  CSmartPlaylistCache::Query query;
+  EXPECT_TRUE(cache.Lookup(key, query));
+  EXPECT_FALSE(cache.SetResolved(key, query.generation,
+                                 CSmartPlaylistCache::FormatIdClause("movie_view.idMovie", ids)));
+
+  // the rules keep being used and resolving isn't attempted again
+  EXPECT_TRUE(cache.Lookup(key, query));
+  EXPECT_FALSE(query.resolve);
+  EXPECT_EQ("movies", query.where);
+}
@@ -21,6 +21,7 @@
 #include "settings/lib/SettingsManager.h"
 #include "utils/FileUtils.h"
 #include "utils/LangCodeExpander.h"
+#include "utils/RegExp.h"
 #include "utils/StringUtils.h"
 #include "utils/SystemInfo.h"
 #include "utils/URIUtils.h"
@@ -368,6 +369,8 @@ void CAdvancedSettings::Initialize()
                                   //with ipv6.
   m_curlDisableHTTP2 = false;
 
+  m_webserverThreadPoolSize = 4;
+
 #if defined(TARGET_WINDOWS_DESKTOP)
   m_minimizeToTray = false;
 #endif
@@ -471,6 +474,9 @@ bool CAdvancedSettings::Load(const CProfileManager &profileManager)
 
   ParseSettingsFile(profileManager.GetUserDataItem("advancedsettings.xml"));
 
+  // expressions may have changed, drop the ones compiled for the previous settings
+  CRegExp::ClearSharedCache();
+
   // Add the list of disc stub extensions (if any) to the list of video extensions
   if (!m_discStubExtensions.empty())
     m_videoExtensions += "|" + m_discStubExtensions;
@@ -594,6 +600,8 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetFloat(pElement, "limiterrelease", m_limiterRelease, 0.001f, 100.0f);
     XMLUtils::GetUInt(pElement, "maxpassthroughoffsyncduration", m_maxPassthroughOffSyncDuration,
                       10, 100);
+    XMLUtils::GetBoolean(pElement, "lowlatency", m_audioLowLatency);
+    XMLUtils::GetUInt(pElement, "lowlatencyperiod", m_audioLowLatencyPeriod, 2, 50);
   }
 
   pElement = pRootElement->FirstChildElement("x11");
@@ -742,6 +750,7 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
 
     //0 = disable fps detect, 1 = only detect on timestamps with uniform spacing, 2 detect on all timestamps
     XMLUtils::GetInt(pElement, "fpsdetect", m_videoFpsDetect, 0, 2);
+    XMLUtils::GetUInt(pElement, "thumbextractjobs", m_videoThumbExtractJobs, 1, 16);
     XMLUtils::GetFloat(pElement, "maxtempo", m_maxTempo, 1.5, 2.1);
     XMLUtils::GetBoolean(pElement, "preferstereostream", m_videoPreferStereoStream);
 
@@ -865,6 +874,7 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetBoolean(pElement, "disableipv6", m_curlDisableIPV6);
     XMLUtils::GetBoolean(pElement, "disablehttp2", m_curlDisableHTTP2);
     XMLUtils::GetString(pElement, "catrustfile", m_caTrustFile);
+    XMLUtils::GetUInt(pElement, "webserverthreadpoolsize", m_webserverThreadPoolSize, 0, 64);
   }
 
   pElement = pRootElement->FirstChildElement("cache");
@@ -160,6 +160,8 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     float m_videoIgnorePercentAtEnd;
     float m_audioApplyDrc;
     unsigned int m_maxPassthroughOffSyncDuration = 10; // when 10 ms off adjust
+    bool m_audioLowLatency = false; // small sink periods and engine buffers
+    unsigned int m_audioLowLatencyPeriod = 10; // ms
 
     int   m_videoVDPAUScaling;
     float m_videoNonLinStretchRatio;
@@ -171,6 +173,7 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     bool m_DXVACheckCompatibility;
     bool m_DXVACheckCompatibilityPresent;
     int  m_videoFpsDetect;
+    unsigned int m_videoThumbExtractJobs = 2; ///< \brief number of thumbs extracted in parallel
     float m_maxTempo;
     bool m_videoPreferStereoStream = false;
 
@@ -304,6 +307,8 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
 
     std::string m_caTrustFile;
 
+    unsigned int m_webserverThreadPoolSize; ///< 0 to use one thread per connection
+
     bool m_minimizeToTray; /* win32 only */
     bool m_fullScreen;
     bool m_startFullScreen;
@@ -12,6 +12,7 @@
 #include "URL.h"
 #include "Util.h"
 #include "media/MediaLockState.h"
+#include "network/DNSNameCache.h"
 #include "network/WakeOnAccess.h"
 #include "profiles/ProfileManager.h"
 #include "settings/SettingsComponent.h"
@@ -101,6 +102,21 @@ bool CMediaSourceSettings::Load(const std::string &file)
   GetSources(pRootElement, "music", m_musicSources, m_defaultMusicSource);
   GetSources(pRootElement, "games", m_gameSources, dummy);
 
+  // resolve the hosts of network sources before they are browsed the first time
+  for (const VECSOURCES* sources : {&m_videoSources, &m_programSources, &m_pictureSources,
+                                    &m_fileSources, &m_musicSources, &m_gameSources})
+  {
+    for (const CMediaSource& source : *sources)
+    {
+      for (const std::string& path : source.vecPaths)
+      {
+        if (URIUtils::IsSmb(path) || URIUtils::IsNfs(path) || URIUtils::IsFTP(path) ||
+            URIUtils::IsDAV(path))
+          CDNSNameCache::Prefetch(CURL(path).GetHostName());
+      }
+    }
+  }
+
   return true;
 }
 
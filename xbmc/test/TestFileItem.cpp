@@ -9,10 +9,20 @@
 #include "FileItem.h"
 #include "ServiceBroker.h"
 #include "URL.h"
+#include "music/tags/MusicInfoTag.h"
 #include "settings/AdvancedSettings.h"
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
 #include "settings/lib/SettingsManager.h"
+#include "video/VideoInfoTag.h"
+
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#if defined(TARGET_POSIX)
+#include <unistd.h>
+#endif
 
 #include <gtest/gtest.h>
 
@@ -130,3 +140,106 @@ const TestFileData BaseMovies[] = {{ "c:\\dir\\filename.avi", false, "c:\\dir\\f
                                    { "/home/user/movies/movie_name/BDMV/index.bdmv", true, "/home/user/movies/movie_name/" }};
 
 INSTANTIATE_TEST_SUITE_P(BaseNameMovies, TestFileItemBasePath, ValuesIn(BaseMovies));
+
+TEST(TestFileItem, MimeTypeShared)
+{
+  CFileItem first("/music/first.flac", false);
+  CFileItem second("/music/second.flac", false);
+  first.SetMimeType("audio/flac");
+  second.SetMimeType(std::string("audio/") + "flac");
+  EXPECT_EQ("audio/flac", first.GetMimeType());
+  EXPECT_EQ(&first.GetMimeType(), &second.GetMimeType());
+
+  CFileItem copy(first);
+  EXPECT_EQ(&first.GetMimeType(), &copy.GetMimeType());
+
+  copy.Reset();
+  EXPECT_TRUE(copy.GetMimeType().empty());
+}
+
+TEST(TestFileItem, SortLabelFollowsLabel)
+{
+  CFileItem item("First");
+  item.SetLabel("Second");
+  EXPECT_EQ(L"Second", item.GetSortLabel());
+
+  item.SetSortLabel(L"Sort");
+  item.SetLabel("Third");
+  EXPECT_EQ(L"Sort", item.GetSortLabel());
+}
+
+namespace
+{
+// resident memory of the process in bytes, 0 if unknown
+size_t GetResidentMemory()
+{
+#if defined(TARGET_LINUX)
+  std::ifstream statm("/proc/self/statm");
+  size_t size = 0;
+  size_t resident = 0;
+  if (statm >> size >> resident)
+    return resident * sysconf(_SC_PAGESIZE);
+#endif
+  return 0;
+}
+} // namespace
+
+// Memory benchmark, run with --gtest_also_run_disabled_tests
+TEST(TestFileItem, DISABLED_BenchmarkMemory)
+{
+  // lists like the ones the library databases return for their movie and song nodes
+  constexpr int count = 20000;
+  const size_t before = GetResidentMemory();
+  {
+    CFileItemList movies;
+    CFileItemList songs;
+    for (int i = 0; i < count; ++i)
+    {
+      const std::string number = std::to_string(i);
+
+      CVideoInfoTag movie;
+      movie.m_iDbId = i;
+      movie.m_type = MediaTypeMovie;
+      movie.SetTitle("Movie title " + number);
+      movie.SetPlot("A plot that is about as long as the ones of the online scrapers, which is "
+                    "usually a paragraph of a few hundred characters. " + number);
+      movie.SetGenre({"Action", "Drama"});
+      movie.SetYear(1950 + i % 70);
+      movie.m_strFileNameAndPath = "nfs://server/storage/movies/Movie " + number + "/movie.mkv";
+      CFileItemPtr movieItem(new CFileItem(movie));
+      movieItem->SetPath("videodb://movies/titles/" + number);
+      movieItem->SetMimeType("video/x-matroska");
+      movieItem->SetArt("poster", "image://nfs%3a%2f%2fserver%2fposter" + number + ".jpg/");
+      movieItem->SetArt("fanart", "image://nfs%3a%2f%2fserver%2ffanart" + number + ".jpg/");
+      movieItem->SetProperty("dbid", i);
+      movies.Add(movieItem);
+
+      CFileItemPtr songItem(new CFileItem("nfs://server/storage/music/Artist/Album/" + number +
+                                          ".flac", false));
+      MUSIC_INFO::CMusicInfoTag& song = *songItem->GetMusicInfoTag();
+      song.SetTitle("Song title " + number);
+      song.SetArtist("Artist");
+      song.SetAlbum("Album " + std::to_string(i / 12));
+      song.SetGenre("Rock");
+      song.SetDuration(180 + i % 120);
+      song.SetDatabaseId(i, MediaTypeSong);
+      song.SetLoaded(true);
+      songItem->SetLabel(song.GetTitle());
+      songItem->SetMimeType("audio/flac");
+      songItem->SetArt("thumb", "image://music@nfs%3a%2f%2fserver%2f" + number + ".flac/");
+      songs.Add(songItem);
+    }
+
+    const size_t after = GetResidentMemory();
+    std::cout << "sizeof(CFileItem): " << sizeof(CFileItem) << " bytes\n";
+    if (before != 0 && after > before)
+      std::cout << count << " movies and " << count
+                << " songs: " << (after - before) / (1024 * 1024) << " MiB\n";
+
+    movies.Sort(SortByLabel, SortOrderAscending);
+    songs.Sort(SortByLabel, SortOrderAscending);
+    const size_t sorted = GetResidentMemory();
+    if (after != 0 && sorted > after)
+      std::cout << "after sorting: +" << (sorted - after) / 1024 << " KiB\n";
+  }
+}
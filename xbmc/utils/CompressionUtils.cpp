@@ -0,0 +1,108 @@
+/*
+ *  Copyright (C) 2023 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "CompressionUtils.h"
+
+#include <zlib.h>
+
+namespace
+{
+constexpr size_t CHUNK_SIZE = 16 * 1024;
+// windowBits + 16 makes zlib write a gzip header and trailer
+constexpr int GZIP_WINDOW_BITS = MAX_WBITS + 16;
+constexpr int RAW_WINDOW_BITS = -MAX_WBITS;
+} // unnamed namespace
+
+bool CCompressionUtils::Gzip(const char* data, size_t size, std::string& output)
+{
+  return Deflate(data, size, output, GZIP_WINDOW_BITS, Z_FINISH);
+}
+
+bool CCompressionUtils::DeflateRaw(const char* data, size_t size, std::string& output)
+{
+  return Deflate(data, size, output, RAW_WINDOW_BITS, Z_SYNC_FLUSH);
+}
+
+bool CCompressionUtils::Deflate(
+    const char* data, size_t size, std::string& output, int windowBits, int flush)
+{
+  output.clear();
+
+  z_stream stream = {};
+  if (deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, windowBits, 8,
+                   Z_DEFAULT_STRATEGY) != Z_OK)
+    return false;
+
+  stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+  stream.avail_in = static_cast<uInt>(size);
+
+  // text like JSON usually compresses to a fraction of its size
+  output.resize(deflateBound(&stream, static_cast<uLong>(size)) + 8);
+  stream.next_out = reinterpret_cast<Bytef*>(&output[0]);
+  stream.avail_out = static_cast<uInt>(output.size());
+
+  int ret = deflate(&stream, flush);
+  while (ret == Z_OK && stream.avail_out == 0)
+  {
+    // deflateBound() doesn't include the flush markers, make room for them
+    const size_t written = output.size();
+    output.resize(written + CHUNK_SIZE);
+    stream.next_out = reinterpret_cast<Bytef*>(&output[written]);
+    stream.avail_out = CHUNK_SIZE;
+    ret = deflate(&stream, flush);
+  }
+
+  const bool success = flush == Z_FINISH ? ret == Z_STREAM_END : ret == Z_OK;
+  output.resize(stream.total_out);
+  deflateEnd(&stream);
+
+  if (!success)
+    output.clear();
+
+  return success;
+}
+
+bool CCompressionUtils::InflateRaw(const char* data, size_t size, std::string& output, size_t maxSize)
+{
+  output.clear();
+
+  z_stream stream = {};
+  if (inflateInit2(&stream, RAW_WINDOW_BITS) != Z_OK)
+    return false;
+
+  stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+  stream.avail_in = static_cast<uInt>(size);
+
+  int ret = Z_OK;
+  char buffer[CHUNK_SIZE];
+  do
+  {
+    stream.next_out = reinterpret_cast<Bytef*>(buffer);
+    stream.avail_out = sizeof(buffer);
+    ret = inflate(&stream, Z_SYNC_FLUSH);
+    if (ret != Z_OK && ret != Z_STREAM_END && ret != Z_BUF_ERROR)
+      break;
+
+    output.append(buffer, sizeof(buffer) - stream.avail_out);
+    if (output.size() > maxSize)
+    {
+      ret = Z_MEM_ERROR;
+      break;
+    }
+  } while (ret == Z_OK && (stream.avail_in > 0 || stream.avail_out == 0));
+
+  inflateEnd(&stream);
+
+  if (ret != Z_OK && ret != Z_STREAM_END && ret != Z_BUF_ERROR)
+  {
+    output.clear();
+    return false;
+  }
+
+  return true;
+}
@@ -0,0 +1,42 @@
+/*
+ *  Copyright (C) 2023 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <string>
+
+class CCompressionUtils
+{
+public:
+  /*!
+   \brief Compress data into the gzip format (e.g. for Content-Encoding: gzip)
+   \param data the data to compress
+   \param size the size of the data
+   \param output the compressed data
+   \return true on success, false otherwise
+   */
+  static bool Gzip(const char* data, size_t size, std::string& output);
+
+  /*!
+   \brief Compress data into a raw deflate stream that is flushed but not finished, i.e. it ends
+   with an empty stored block (0x00 0x00 0xff 0xff) as used by permessage-deflate (RFC 7692)
+   */
+  static bool DeflateRaw(const char* data, size_t size, std::string& output);
+
+  /*!
+   \brief Decompress a raw deflate stream
+   \param maxSize maximum size of the decompressed data, larger data fails
+   */
+  static bool InflateRaw(const char* data, size_t size, std::string& output, size_t maxSize);
+
+private:
+  CCompressionUtils() = delete;
+
+  static bool Deflate(const char* data, size_t size, std::string& output, int windowBits, int flush);
+};
@@ -9,6 +9,9 @@
 #include "EmbeddedArt.h"
 
 #include "Archive.h"
+#include "Digest.h"
+
+using KODI::UTILITY::CDigest;
 
 EmbeddedArtInfo::EmbeddedArtInfo(size_t size,
                                  const std::string &mime, const std::string& type)
@@ -21,12 +24,14 @@ void EmbeddedArtInfo::Set(size_t size, const std::string &mime, const std::strin
   m_size = size;
   m_mime = mime;
   m_type = type;
+  m_hash.clear();
 }
 
 void EmbeddedArtInfo::Clear()
 {
   m_mime.clear();
   m_size = 0;
+  m_hash.clear();
 }
 
 bool EmbeddedArtInfo::Empty() const
@@ -36,9 +41,17 @@ bool EmbeddedArtInfo::Empty() const
 
 bool EmbeddedArtInfo::Matches(const EmbeddedArtInfo &right) const
 {
+  // only compare the hashes if both are known
   return (m_size == right.m_size &&
           m_mime == right.m_mime &&
-          m_type == right.m_type);
+          m_type == right.m_type &&
+          (m_hash.empty() || right.m_hash.empty() || m_hash == right.m_hash));
+}
+
+std::string EmbeddedArtInfo::ComputeHash(const uint8_t* data, size_t size)
+{
+  // a cryptographic hash, so equal hashes can be taken for equal data without comparing it
+  return CDigest::Calculate(CDigest::Type::SHA256, data, size);
 }
 
 void EmbeddedArtInfo::Archive(CArchive &ar)
@@ -30,9 +30,15 @@ public:
   bool Matches(const EmbeddedArtInfo &right) const;
   void SetType(const std::string& type) { m_type = type; }
 
+  /*! \brief Hash of the image data to tell identical art apart from art of the same size
+   \return the SHA-256 digest of the data
+   */
+  static std::string ComputeHash(const uint8_t* data, size_t size);
+
   size_t m_size = 0;
   std::string m_mime;
   std::string m_type;
+  std::string m_hash; ///< hash of the image data, empty if unknown. Not archived.
 };
 
 class EmbeddedArt : public EmbeddedArtInfo
@@ -11,9 +11,29 @@
 #include "utils/Variant.h"
 
 #include <rapidjson/prettywriter.h>
-#include <rapidjson/stringbuffer.h>
 #include <rapidjson/writer.h>
 
+namespace
+{
+/*!
+ * \brief rapidjson output stream appending to a std::string, so the
+ * document is written once instead of being copied out of a buffer
+ */
+class StringOutputStream
+{
+public:
+  typedef char Ch;
+
+  explicit StringOutputStream(std::string& output) : m_output(output) {}
+
+  void Put(Ch c) { m_output.push_back(c); }
+  void Flush() {}
+
+private:
+  std::string& m_output;
+};
+} // namespace
+
 template<class TWriter>
 bool InternalWrite(TWriter& writer, const CVariant &value)
 {
@@ -70,23 +90,29 @@ bool InternalWrite(TWriter& writer, const CVariant &value)
 
 bool CJSONVariantWriter::Write(const CVariant &value, std::string& output, bool compact)
 {
-  rapidjson::StringBuffer stringBuffer;
+  output.clear();
+  StringOutputStream stream(output);
   if (compact)
   {
-    rapidjson::Writer<rapidjson::StringBuffer> writer(stringBuffer);
+    rapidjson::Writer<StringOutputStream> writer(stream);
 
     if (!InternalWrite(writer, value) || !writer.IsComplete())
+    {
+      output.clear();
       return false;
+    }
   }
   else
   {
-    rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(stringBuffer);
+    rapidjson::PrettyWriter<StringOutputStream> writer(stream);
     writer.SetIndent('\t', 1);
 
     if (!InternalWrite(writer, value) || !writer.IsComplete())
+    {
+      output.clear();
       return false;
+    }
   }
 
-  output = stringBuffer.GetString();
   return true;
 }
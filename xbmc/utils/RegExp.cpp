@@ -9,12 +9,16 @@
 #include "RegExp.h"
 
 #include "log.h"
+#include "threads/CriticalSection.h"
 #include "utils/StringUtils.h"
 #include "utils/Utf8Utils.h"
 
 #include <algorithm>
+#include <cctype>
+#include <mutex>
 #include <stdlib.h>
 #include <string.h>
+#include <unordered_map>
 
 using namespace PCRE;
 
@@ -41,6 +45,55 @@ int CRegExp::m_Utf8Supported = -1;
 int CRegExp::m_UcpSupported  = -1;
 int CRegExp::m_JitSupported  = -1;
 
+struct CRegExp::CompiledCode
+{
+  ~CompiledCode()
+  {
+    if (sd)
+      pcre_free_study(sd);
+    if (re)
+      pcre_free(re);
+  }
+
+  pcre* re = nullptr;
+  pcre_extra* sd = nullptr;
+  bool jitCompiled = false;
+};
+
+struct CRegExp::SharedCache
+{
+  CCriticalSection lock;
+  // keyed by compile options and expression, failed compilations are stored as nullptr
+  std::unordered_map<std::string, std::shared_ptr<const CompiledCode>> entries;
+};
+
+namespace
+{
+#ifdef PCRE_HAS_JIT_CODE
+// compiled code is shared between threads, so every thread brings its own JIT stack
+pcre_jit_stack* GetThreadJitStack(void*)
+{
+  struct JitStack
+  {
+    JitStack() : stack(pcre_jit_stack_alloc(32 * 1024, 512 * 1024))
+    {
+      if (!stack)
+        CLog::Log(LOGWARNING, "CRegExp: can't allocate address space for JIT stack");
+    }
+    ~JitStack()
+    {
+      if (stack)
+        pcre_jit_stack_free(stack);
+    }
+    pcre_jit_stack* stack;
+  };
+
+  thread_local JitStack jitStack;
+  return jitStack.stack; // PCRE falls back to 32K of machine stack on nullptr
+}
+#endif
+} // unnamed namespace
+
 
 CRegExp::CRegExp(bool caseless /*= false*/, CRegExp::utf8Mode utf8 /*= asciiOnly*/)
 {
@@ -52,6 +105,7 @@ void CRegExp::InitValues(bool caseless /*= false*/, CRegExp::utf8Mode utf8 /*= a
   m_utf8Mode    = utf8;
   m_re          = NULL;
   m_sd          = NULL;
+  m_code.reset();
   m_iOptions    = PCRE_DOTALL | PCRE_NEWLINE_ANY;
   if(caseless)
     m_iOptions |= PCRE_CASELESS;
@@ -67,7 +121,6 @@ void CRegExp::InitValues(bool caseless /*= false*/, CRegExp::utf8Mode utf8 /*= a
   m_jitCompiled = false;
   m_bMatched    = false;
   m_iMatchCount = 0;
-  m_jitStack    = NULL;
 
   memset(m_iOvector, 0, sizeof(m_iOvector));
 }
@@ -226,7 +279,6 @@ CRegExp::CRegExp(const CRegExp& re)
 {
   m_re = NULL;
   m_sd = NULL;
-  m_jitStack = NULL;
   m_utf8Mode = re.m_utf8Mode;
   m_iOptions = re.m_iOptions;
   *this = re;
@@ -234,27 +286,25 @@ CRegExp::CRegExp(const CRegExp& re)
 
 CRegExp& CRegExp::operator=(const CRegExp& re)
 {
-  size_t size;
+  if (this == &re)
+    return *this;
+
   Cleanup();
   m_jitCompiled = false;
   m_pattern = re.m_pattern;
-  if (re.m_re)
+  if (re.m_code)
   {
-    if (pcre_fullinfo(re.m_re, NULL, PCRE_INFO_SIZE, &size) >= 0)
-    {
-      if ((m_re = (pcre*)malloc(size)))
-      {
-        memcpy(m_re, re.m_re, size);
-        memcpy(m_iOvector, re.m_iOvector, OVECCOUNT*sizeof(int));
-        m_offset = re.m_offset;
-        m_iMatchCount = re.m_iMatchCount;
-        m_bMatched = re.m_bMatched;
-        m_subject = re.m_subject;
-        m_iOptions = re.m_iOptions;
-      }
-      else
-        CLog::Log(LOGFATAL, "{}: Failed to allocate memory", __FUNCTION__);
-    }
+    // compiled code is immutable, copies only need their own match state
+    m_code = re.m_code;
+    m_re = m_code->re;
+    m_sd = m_code->sd;
+    m_jitCompiled = m_code->jitCompiled;
+    memcpy(m_iOvector, re.m_iOvector, OVECCOUNT*sizeof(int));
+    m_offset = re.m_offset;
+    m_iMatchCount = re.m_iMatchCount;
+    m_bMatched = re.m_bMatched;
+    m_subject = re.m_subject;
+    m_iOptions = re.m_iOptions;
   }
   return *this;
 }
@@ -273,49 +323,138 @@ bool CRegExp::RegComp(const char *re, studyMode study /*= NoStudy*/)
   m_jitCompiled      = false;
   m_bMatched         = false;
   m_iMatchCount      = 0;
-  const char *errMsg = NULL;
-  int errOffset      = 0;
-  int options        = m_iOptions;
-  if (m_utf8Mode == autoUtf8 && requireUtf8(re))
-    options |= (IsUtf8Supported() ? PCRE_UTF8 : 0) | (AreUnicodePropertiesSupported() ? PCRE_UCP : 0);
 
   Cleanup();
 
-  m_re = pcre_compile(re, options, &errMsg, &errOffset, NULL);
-  if (!m_re)
+  std::shared_ptr<const CompiledCode> code = Compile(re, GetCompileOptions(re), study);
+  if (!code)
   {
     m_pattern.clear();
-    CLog::Log(LOGERROR, "PCRE: {}. Compilation failed at offset {} in expression '{}'", errMsg,
-              errOffset, re);
     return false;
   }
 
-  m_pattern = re;
+  Assign(std::move(code), re);
+  return true;
+}
+
+bool CRegExp::RegCompShared(const std::string& re)
+{
+  m_offset           = 0;
+  m_jitCompiled      = false;
+  m_bMatched         = false;
+  m_iMatchCount      = 0;
+
+  Cleanup();
+
+  const int options = GetCompileOptions(re.c_str());
+  const std::string key = std::to_string(options) + ':' + re;
+
+  SharedCache& cache = GetSharedCache();
+  std::shared_ptr<const CompiledCode> code;
+  bool cached = false;
+  {
+    std::unique_lock<CCriticalSection> lock(cache.lock);
+    const auto it = cache.entries.find(key);
+    if (it != cache.entries.end())
+    {
+      code = it->second;
+      cached = true;
+    }
+  }
+
+  if (!cached)
+  {
+    // compile outside of the lock, a concurrent compilation of the same
+    // expression is harmless and the first one to finish wins
+    code = Compile(re.c_str(), options, StudyWithJitComp);
+    std::unique_lock<CCriticalSection> lock(cache.lock);
+    code = cache.entries.emplace(key, code).first->second;
+  }
+
+  if (!code)
+  {
+    m_pattern.clear();
+    return false;
+  }
+
+  Assign(std::move(code), re.c_str());
+  return true;
+}
+
+void CRegExp::ClearSharedCache()
+{
+  SharedCache& cache = GetSharedCache();
+  std::unique_lock<CCriticalSection> lock(cache.lock);
+  cache.entries.clear();
+}
+
+CRegExp::SharedCache& CRegExp::GetSharedCache()
+{
+  static SharedCache cache;
+  return cache;
+}
+
+int CRegExp::GetCompileOptions(const char* re) const
+{
+  int options = m_iOptions;
+  if (m_utf8Mode == autoUtf8 && requireUtf8(re))
+    options |= (IsUtf8Supported() ? PCRE_UTF8 : 0) | (AreUnicodePropertiesSupported() ? PCRE_UCP : 0);
+  return options;
+}
+
+std::shared_ptr<const CRegExp::CompiledCode> CRegExp::Compile(const char* re,
+                                                              int options,
+                                                              studyMode study)
+{
+  const char *errMsg = NULL;
+  int errOffset      = 0;
+
+  auto code = std::make_shared<CompiledCode>();
+  code->re = pcre_compile(re, options, &errMsg, &errOffset, NULL);
+  if (!code->re)
+  {
+    CLog::Log(LOGERROR, "PCRE: {}. Compilation failed at offset {} in expression '{}'", errMsg,
+              errOffset, re);
+    return {};
+  }
 
   if (study)
   {
     const bool jitCompile = (study == StudyWithJitComp) && IsJitSupported();
     const int studyOptions = jitCompile ? PCRE_STUDY_JIT_COMPILE : 0;
 
-    m_sd = pcre_study(m_re, studyOptions, &errMsg);
+    code->sd = pcre_study(code->re, studyOptions, &errMsg);
     if (errMsg != NULL)
     {
       CLog::Log(LOGWARNING, "{}: PCRE error \"{}\" while studying expression", __FUNCTION__,
                 errMsg);
-      if (m_sd != NULL)
+      if (code->sd != NULL)
       {
-        pcre_free_study(m_sd);
-        m_sd = NULL;
+        pcre_free_study(code->sd);
+        code->sd = NULL;
       }
     }
     else if (jitCompile)
     {
       int jitPresent = 0;
-      m_jitCompiled = (pcre_fullinfo(m_re, m_sd, PCRE_INFO_JIT, &jitPresent) == 0 && jitPresent == 1);
+      code->jitCompiled = (pcre_fullinfo(code->re, code->sd, PCRE_INFO_JIT, &jitPresent) == 0 && jitPresent == 1);
+#ifdef PCRE_HAS_JIT_CODE
+      if (code->jitCompiled)
+        pcre_assign_jit_stack(code->sd, GetThreadJitStack, NULL);
+#endif
     }
   }
 
-  return true;
+  return code;
+}
+
+void CRegExp::Assign(std::shared_ptr<const CompiledCode> code, const char* re)
+{
+  m_code = std::move(code);
+  m_re = m_code->re;
+  m_sd = m_code->sd;
+  m_jitCompiled = m_code->jitCompiled;
+  m_pattern = re;
 }
 
 int CRegExp::RegFind(const char *str, unsigned int startoffset /*= 0*/, int maxNumberOfCharsToTest /*= -1*/)
@@ -347,22 +486,11 @@ int CRegExp::PrivateRegFind(size_t bufferLen, const char *str, unsigned int star
     return -1;
   }
 
-#ifdef PCRE_HAS_JIT_CODE
-  if (m_jitCompiled && !m_jitStack)
-  {
-    m_jitStack = pcre_jit_stack_alloc(32*1024, 512*1024);
-    if (m_jitStack == NULL)
-      CLog::Log(LOGWARNING, "{}: can't allocate address space for JIT stack", __FUNCTION__);
-
-    pcre_assign_jit_stack(m_sd, NULL, m_jitStack);
-  }
-#endif
-
   if (maxNumberOfCharsToTest >= 0)
     bufferLen = std::min<size_t>(bufferLen, startoffset + maxNumberOfCharsToTest);
 
   m_subject.assign(str + startoffset, bufferLen - startoffset);
-  int rc = pcre_exec(m_re, NULL, m_subject.c_str(), m_subject.length(), 0, 0, m_iOvector, OVECCOUNT);
+  int rc = pcre_exec(m_re, m_sd, m_subject.c_str(), m_subject.length(), 0, 0, m_iOvector, OVECCOUNT);
 
   if (rc<1)
   {
@@ -556,25 +684,9 @@ void CRegExp::DumpOvector(int iLog /* = LOGDEBUG */)
 
 void CRegExp::Cleanup()
 {
-  if (m_re)
-  {
-    pcre_free(m_re);
-    m_re = NULL;
-  }
-
-  if (m_sd)
-  {
-    pcre_free_study(m_sd);
-    m_sd = NULL;
-  }
-
-#ifdef PCRE_HAS_JIT_CODE
-  if (m_jitStack)
-  {
-    pcre_jit_stack_free(m_jitStack);
-    m_jitStack = NULL;
-  }
-#endif
+  m_code.reset();
+  m_re = NULL;
+  m_sd = NULL;
 }
 
 inline bool CRegExp::IsValidSubNumber(int iSub) const
@@ -649,3 +761,126 @@ bool CRegExp::IsJitSupported(void)
 
   return m_JitSupported == 1;
 }
+
+CRegExpSet::CRegExpSet(bool caseless /* = false */, CRegExp::utf8Mode utf8 /* = asciiOnly */)
+  : m_caseless(caseless), m_utf8Mode(utf8), m_combined(caseless, utf8)
+{
+}
+
+bool CRegExpSet::Add(const std::string& re)
+{
+  m_patterns.push_back(re);
+  m_regexps.emplace_back(m_caseless, m_utf8Mode);
+  m_dirty = true;
+  return m_regexps.back().RegCompShared(re);
+}
+
+void CRegExpSet::BuildCombined()
+{
+  m_dirty = false;
+  m_combined = CRegExp(m_caseless, m_utf8Mode);
+  m_groups.assign(m_regexps.size(), -1);
+
+  if (m_regexps.size() < 2)
+    return;
+
+  // back references and recursion would refer to the wrong groups once the
+  // expressions are nested into one, verbs are only valid at the very start
+  static const char* const unsupported[] = {"\\g", "\\k", "(?P=", "(?P>", "(?R", "(?&",
+                                            "(?+", "(?-", "(*"};
+
+  std::string combined = "(?J)"; // the expressions may use the same group names
+  std::vector<size_t> included;
+  int utf8 = -1;
+  for (size_t i = 0; i < m_regexps.size(); ++i)
+  {
+    if (!m_regexps[i].IsCompiled())
+      continue;
+
+    const std::string& re = m_patterns[i];
+    for (const char* token : unsupported)
+    {
+      if (re.find(token) != std::string::npos)
+        return;
+    }
+    for (size_t pos = re.find('\\'); pos != std::string::npos; pos = re.find('\\', pos + 2))
+    {
+      if (pos + 1 < re.size() && re[pos + 1] >= '1' && re[pos + 1] <= '9')
+        return;
+    }
+    for (size_t pos = re.find("(?"); pos != std::string::npos; pos = re.find("(?", pos + 2))
+    {
+      if (pos + 2 < re.size() && isdigit(static_cast<unsigned char>(re[pos + 2])))
+        return;
+    }
+
+    // all expressions have to agree on UTF-8 mode
+    const int needUtf8 = m_utf8Mode == CRegExp::autoUtf8 && CRegExp::requireUtf8(re) ? 1 : 0;
+    if (utf8 != -1 && utf8 != needUtf8)
+      return;
+    utf8 = needUtf8;
+
+    // unnamed groups don't capture in the combined expression, each expression is wrapped
+    // into a named group instead to keep the group count within the ovector
+    if (combined.size() > 4)
+      combined += '|';
+    combined += "(?<regexpset_" + std::to_string(i) + '>' + re + ')';
+    included.push_back(i);
+  }
+
+  if (included.empty())
+    return;
+
+  m_combined.m_iOptions |= PCRE_NO_AUTO_CAPTURE;
+  if (!m_combined.RegCompShared(combined) ||
+      m_combined.GetCaptureTotal() > CRegExp::m_MaxNumOfBackrefrences)
+  {
+    CLog::Log(LOGDEBUG, "CRegExpSet: expressions can't be combined, matching one by one");
+    m_combined = CRegExp(m_caseless, m_utf8Mode);
+    return;
+  }
+
+  for (size_t i : included)
+    m_groups[i] = m_combined.GetNamedSubPatternNumber(("regexpset_" + std::to_string(i)).c_str());
+}
+
+int CRegExpSet::RegFind(const std::string& str, size_t first /* = 0 */)
+{
+  if (m_dirty)
+    BuildCombined();
+
+  size_t next = first;
+  if (first == 0 && m_combined.IsCompiled())
+  {
+    if (m_combined.RegFind(str) < 0)
+      return -1;
+
+    // the combined expression reports the first expression matching at the leftmost
+    // position, an earlier one may still match further to the right
+    size_t matched = m_groups.size();
+    for (size_t i = 0; i < m_groups.size(); ++i)
+    {
+      if (m_groups[i] > 0 && m_combined.GetSubStart(m_groups[i]) >= 0)
+      {
+        matched = i;
+        break;
+      }
+    }
+
+    for (; next < matched; ++next)
+    {
+      if (m_regexps[next].IsCompiled() && m_regexps[next].RegFind(str) >= 0)
+        return static_cast<int>(next);
+    }
+    if (matched < m_regexps.size() && m_regexps[matched].RegFind(str) >= 0)
+      return static_cast<int>(matched);
+    next = matched + 1;
+  }
+
+  for (; next < m_regexps.size(); ++next)
+  {
+    if (m_regexps[next].IsCompiled() && m_regexps[next].RegFind(str) >= 0)
+      return static_cast<int>(next);
+  }
+  return -1;
+}
@@ -10,6 +10,7 @@
 
 //! @todo - move to std::regex (after switching to gcc 4.9 or higher) and get rid of CRegExp
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -82,6 +83,24 @@ public:
   bool RegComp(const std::string& re, studyMode study = NoStudy)
   { return RegComp(re.c_str(), study); }
 
+  /**
+   * Compile (prepare) regular expression using the process wide cache of compiled expressions
+   *
+   * The expression is compiled, studied and JIT-compiled once per process and the compiled code
+   * is shared by all CRegExp objects using the same expression and options. Only the match state
+   * is owned by this object, so it must not be used by multiple threads at the same time.
+   * Expressions failing to compile are cached as well and only logged once.
+   * @param re          The regular expression
+   * @return true on success, false on any error
+   */
+  bool RegCompShared(const std::string& re);
+
+  /**
+   * Drop all expressions from the process wide cache, e.g. after the expressions from
+   * advancedsettings.xml have been reloaded. Objects using cached code stay valid.
+   */
+  static void ClearSharedCache();
+
   /**
    * Find first match of regular expression in given string
    * @param str         The string to match against regular expression
@@ -134,6 +153,14 @@ public:
   static bool IsJitSupported(void);
 
 private:
+  friend class CRegExpSet;
+  struct CompiledCode;
+  struct SharedCache;
+
+  static SharedCache& GetSharedCache();
+  static std::shared_ptr<const CompiledCode> Compile(const char* re, int options, studyMode study);
+  int GetCompileOptions(const char* re) const;
+  void Assign(std::shared_ptr<const CompiledCode> code, const char* re);
   int PrivateRegFind(size_t bufferLen, const char *str, unsigned int startoffset = 0, int maxNumberOfCharsToTest = -1);
   void InitValues(bool caseless = false, CRegExp::utf8Mode utf8 = asciiOnly);
   static bool requireUtf8(const std::string& regexp);
@@ -143,6 +170,7 @@ private:
   void Cleanup();
   inline bool IsValidSubNumber(int iSub) const;
 
+  std::shared_ptr<const CompiledCode> m_code; // owns m_re and m_sd, shared between copies
   PCRE::pcre* m_re;
   PCRE::pcre_extra* m_sd;
   static const int OVECCOUNT=(m_MaxNumOfBackrefrences + 1) * 3;
@@ -153,7 +181,6 @@ private:
   int         m_iOptions;
   bool        m_jitCompiled;
   bool        m_bMatched;
-  PCRE::pcre_jit_stack* m_jitStack;
   std::string m_subject;
   std::string m_pattern;
   static int  m_Utf8Supported;
@@ -163,3 +190,50 @@ private:
 
 typedef std::vector<CRegExp> VECCREGEXP;
 
+/**
+ * Matches a string against a list of expressions, e.g. the tv show episode expressions.
+ *
+ * Expressions are compiled through the shared cache. If the expressions can be combined
+ * (no back references, same UTF-8 mode) a single alternation of all of them is used to find
+ * the first matching expression in one pass; otherwise they are tried one after the other.
+ * Like CRegExp, an object holds match state and must only be used by one thread at a time.
+ */
+class CRegExpSet
+{
+public:
+  CRegExpSet(bool caseless = false, CRegExp::utf8Mode utf8 = CRegExp::asciiOnly);
+
+  /**
+   * Append an expression to the set. Expressions failing to compile keep their index
+   * but never match.
+   * @return true if the expression compiled
+   */
+  bool Add(const std::string& re);
+
+  /**
+   * Find the first expression, in the order they were added, matching the string
+   * @param str         The string to match
+   * @param first (optional) Index of the first expression to try
+   * @return index of the matching expression, its match state is available via GetRegExp(),
+   *         or -1 if none matches
+   */
+  int RegFind(const std::string& str, size_t first = 0);
+
+  CRegExp& GetRegExp(size_t index) { return m_regexps[index]; }
+  const std::string& GetPattern(size_t index) const { return m_patterns[index]; }
+  const std::vector<std::string>& GetPatterns() const { return m_patterns; }
+  size_t Size() const { return m_patterns.size(); }
+  bool IsCombined() const { return m_combined.IsCompiled(); }
+
+private:
+  void BuildCombined();
+
+  bool m_caseless;
+  CRegExp::utf8Mode m_utf8Mode;
+  std::vector<std::string> m_patterns;
+  std::vector<CRegExp> m_regexps;
+  std::vector<int> m_groups; // group wrapping each expression in the combined expression
+  CRegExp m_combined;
+  bool m_dirty = false;
+};
+
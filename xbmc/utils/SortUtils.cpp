@@ -9,14 +9,20 @@
 #include "SortUtils.h"
 
 #include "LangInfo.h"
+#include "ServiceBroker.h"
 #include "URL.h"
 #include "Util.h"
+#include "threads/Event.h"
+#include "utils/CPUInfo.h"
 #include "utils/CharsetConverter.h"
+#include "utils/JobManager.h"
 #include "utils/StringUtils.h"
 #include "utils/Variant.h"
 
 #include <algorithm>
+#include <atomic>
 #include <inttypes.h>
+#include <memory>
 
 std::string ArrayToString(SortAttribute attributes, const CVariant &variant, const std::string &separator = " / ")
 {
@@ -630,6 +636,67 @@ bool SorterIndirectIgnoreFoldersDescending(const SortItemPtr &left, const SortIt
   return SorterIgnoreFoldersDescending(*left, *right);
 }
 
+// lists shorter than this are sorted on the calling thread
+constexpr size_t PARALLEL_SORT_MIN_ITEMS = 8192;
+constexpr int PARALLEL_SORT_MAX_CHUNKS = 4;
+
+struct ParallelSortState
+{
+  std::atomic<size_t> next{0};
+  std::atomic<size_t> done{0};
+  CEvent finished{true};
+};
+
+template<typename Iterator, typename Compare>
+void ParallelStableSort(Iterator begin, Iterator end, Compare compare)
+{
+  const size_t count = end - begin;
+  const auto cpuInfo = CServiceBroker::GetCPUInfo();
+  const auto jobManager = CServiceBroker::GetJobManager();
+  const size_t chunks =
+      cpuInfo ? static_cast<size_t>(std::min(PARALLEL_SORT_MAX_CHUNKS, cpuInfo->GetCPUCount())) : 1;
+  if (count < PARALLEL_SORT_MIN_ITEMS || chunks < 2 || !jobManager)
+  {
+    std::stable_sort(begin, end, compare);
+    return;
+  }
+
+  // sort a chunk per worker and merge neighbouring chunks until a single one is left
+  std::vector<Iterator> bounds;
+  for (size_t i = 0; i <= chunks; ++i)
+    bounds.push_back(begin + count * i / chunks);
+
+  // chunks are claimed by whoever gets to them first, the calling thread included, so the
+  // sort never waits for a job that hasn't started. Jobs started after all chunks were
+  // claimed only touch the shared state.
+  auto state = std::make_shared<ParallelSortState>();
+  auto sortChunks = [state, &bounds, compare, chunks]() {
+    for (size_t i = state->next++; i < chunks; i = state->next++)
+    {
+      std::stable_sort(bounds[i], bounds[i + 1], compare);
+      if (++state->done == chunks)
+        state->finished.Set();
+    }
+  };
+  for (size_t i = 1; i < chunks; ++i)
+    jobManager->Submit([sortChunks]() { sortChunks(); }, CJob::PRIORITY_HIGH);
+  sortChunks();
+  state->finished.Wait();
+
+  while (bounds.size() > 2)
+  {
+    std::vector<Iterator> merged{bounds[0]};
+    for (size_t i = 0; i + 2 < bounds.size(); i += 2)
+    {
+      std::inplace_merge(bounds[i], bounds[i + 1], bounds[i + 2], compare);
+      merged.push_back(bounds[i + 2]);
+    }
+    if (bounds.size() % 2 == 0)
+      merged.push_back(bounds.back());
+    bounds = std::move(merged);
+  }
+}
+
 // clang-format off
 std::map<SortBy, SortUtils::SortPreparator> fillPreparators()
 {
@@ -994,6 +1061,11 @@ void SortUtils::Sort(SortBy sortBy, SortOrder sortOrder, SortAttribute attribute
     {
       Fields sortingFields = GetFieldsForSorting(sortBy);
 
+      std::vector<const SortItem*> sortItems;
+      std::vector<std::wstring> labels;
+      sortItems.reserve(items.size());
+      labels.reserve(items.size());
+
       // Prepare the string used for sorting and store it under FieldSort
       for (DatabaseResults::iterator item = items.begin(); item != items.end(); ++item)
       {
@@ -1004,13 +1076,29 @@ void SortUtils::Sort(SortBy sortBy, SortOrder sortOrder, SortAttribute attribute
             item->insert(std::pair<Field, CVariant>(*field, CVariant::ConstNullVariant));
         }
 
-        std::wstring sortLabel;
-        g_charsetConverter.utf8ToW(preparator(attributes, *item), sortLabel, false);
-        item->insert(std::pair<Field, CVariant>(FieldSort, CVariant(sortLabel)));
+        auto sort = item->find(FieldSort);
+        if (sort == item->end())
+        {
+          std::wstring sortLabel;
+          g_charsetConverter.utf8ToW(preparator(attributes, *item), sortLabel, false);
+          sort = item->insert(std::pair<Field, CVariant>(FieldSort, CVariant(sortLabel))).first;
+        }
+        sortItems.push_back(&*item);
+        labels.push_back(sort->second.asWideString());
       }
 
       // Do the sorting
-      std::stable_sort(items.begin(), items.end(), getSorter(sortOrder, attributes));
+      std::vector<size_t> order;
+      if (sortByKeys(sortItems, labels, sortOrder, attributes, order))
+      {
+        DatabaseResults sorted;
+        sorted.reserve(items.size());
+        for (size_t index : order)
+          sorted.push_back(std::move(items[index]));
+        items = std::move(sorted);
+      }
+      else
+        std::stable_sort(items.begin(), items.end(), getSorter(sortOrder, attributes));
     }
   }
 
@@ -1033,6 +1121,11 @@ void SortUtils::Sort(SortBy sortBy, SortOrder sortOrder, SortAttribute attribute
     {
       Fields sortingFields = GetFieldsForSorting(sortBy);
 
+      std::vector<const SortItem*> sortItems;
+      std::vector<std::wstring> labels;
+      sortItems.reserve(items.size());
+      labels.reserve(items.size());
+
       // Prepare the string used for sorting and store it under FieldSort
       for (SortItems::iterator item = items.begin(); item != items.end(); ++item)
       {
@@ -1043,13 +1136,29 @@ void SortUtils::Sort(SortBy sortBy, SortOrder sortOrder, SortAttribute attribute
             (*item)->insert(std::pair<Field, CVariant>(*field, CVariant::ConstNullVariant));
         }
 
-        std::wstring sortLabel;
-        g_charsetConverter.utf8ToW(preparator(attributes, **item), sortLabel, false);
-        (*item)->insert(std::pair<Field, CVariant>(FieldSort, CVariant(sortLabel)));
+        auto sort = (*item)->find(FieldSort);
+        if (sort == (*item)->end())
+        {
+          std::wstring sortLabel;
+          g_charsetConverter.utf8ToW(preparator(attributes, **item), sortLabel, false);
+          sort = (*item)->insert(std::pair<Field, CVariant>(FieldSort, CVariant(sortLabel))).first;
+        }
+        sortItems.push_back(item->get());
+        labels.push_back(sort->second.asWideString());
       }
 
       // Do the sorting
-      std::stable_sort(items.begin(), items.end(), getSorterIndirect(sortOrder, attributes));
+      std::vector<size_t> order;
+      if (sortByKeys(sortItems, labels, sortOrder, attributes, order))
+      {
+        SortItems sorted;
+        sorted.reserve(items.size());
+        for (size_t index : order)
+          sorted.push_back(std::move(items[index]));
+        items = std::move(sorted);
+      }
+      else
+        std::stable_sort(items.begin(), items.end(), getSorterIndirect(sortOrder, attributes));
     }
   }
 
@@ -1102,6 +1211,77 @@ const SortUtils::SortPreparator& SortUtils::getPreparator(SortBy sortBy)
   return m_preparators[SortByNone];
 }
 
+bool SortUtils::sortByKeys(const std::vector<const SortItem*>& items,
+                           const std::vector<std::wstring>& labels,
+                           SortOrder sortOrder,
+                           SortAttribute attributes,
+                           std::vector<size_t>& order)
+{
+  struct SortEntry
+  {
+    size_t index;
+    int special; // 0 on top, 1 none, 2 on bottom
+    bool folder;
+    std::vector<uint32_t> key;
+  };
+
+  std::vector<std::vector<uint32_t>> keys;
+  if (!StringUtils::AlphaNumericSortKeys(labels, keys))
+    return false;
+
+  // preliminarySort() only compares folders if both items have the field, which can't be
+  // expressed as a single order when only some of the items have it
+  bool handleFolder = !(attributes & SortAttributeIgnoreFolders);
+  size_t folderFields = 0;
+  std::vector<SortEntry> entries;
+  entries.reserve(items.size());
+  for (size_t i = 0; i < items.size(); ++i)
+  {
+    const SortItem& item = *items[i];
+    SortEntry entry{i, 1, false, std::move(keys[i])};
+
+    auto it = item.find(FieldSortSpecial);
+    if (it != item.end() && it->second.asInteger() <= (int64_t)SortSpecialOnBottom)
+    {
+      if (it->second.asInteger() == SortSpecialOnTop)
+        entry.special = 0;
+      else if (it->second.asInteger() == SortSpecialOnBottom)
+        entry.special = 2;
+    }
+
+    it = item.find(FieldFolder);
+    if (it != item.end())
+    {
+      entry.folder = it->second.asBoolean();
+      folderFields++;
+    }
+    entries.push_back(std::move(entry));
+  }
+  if (handleFolder && folderFields != 0 && folderFields != items.size())
+    return false;
+  handleFolder = handleFolder && folderFields != 0;
+
+  const bool descending = sortOrder == SortOrderDescending;
+  ParallelStableSort(entries.begin(), entries.end(),
+                     [descending, handleFolder](const SortEntry& left, const SortEntry& right) {
+                       if (left.special != right.special)
+                         return left.special < right.special;
+                       // both are sorted on top or on bottom, leave them as they are
+                       if (left.special != 1)
+                         return false;
+                       if (handleFolder && left.folder != right.folder)
+                         return left.folder;
+                       return descending ? right.key < left.key : left.key < right.key;
+                     });
+
+  order.clear();
+  order.reserve(entries.size());
+  for (const auto& entry : entries)
+    order.push_back(entry.index);
+
+  return true;
+}
+
 SortUtils::Sorter SortUtils::getSorter(SortOrder sortOrder, SortAttribute attributes)
 {
   if (attributes & SortAttributeIgnoreFolders)
@@ -228,6 +228,17 @@ private:
   static Sorter getSorter(SortOrder sortOrder, SortAttribute attributes);
   static SorterIndirect getSorterIndirect(SortOrder sortOrder, SortAttribute attributes);
 
+  /*! \brief Order items by precomputed collation keys of their sort labels
+   \param items the items to sort, with their sort labels in labels
+   \param order receives the indices of the items in sorted order
+   \return false if the items have to be sorted with the Sorter from getSorter() instead
+   */
+  static bool sortByKeys(const std::vector<const SortItem*>& items,
+                         const std::vector<std::wstring>& labels,
+                         SortOrder sortOrder,
+                         SortAttribute attributes,
+                         std::vector<size_t>& order);
+
   static std::map<SortBy, SortPreparator> m_preparators;
   static std::map<SortBy, Fields> m_sortingFields;
 };
@@ -1191,6 +1191,145 @@ int64_t StringUtils::AlphaNumericCompare(const wchar_t* left, const wchar_t* rig
   return 0; // files are the same
 }
 
+namespace
+{
+// AlphaNumericSortKeys() element weights, ascii symbols are ordered before everything else
+constexpr uint32_t SORT_KEY_SYMBOL = 0x1;
+constexpr uint32_t SORT_KEY_CHARACTER = 0x100;
+// AlphaNumericCompare() only compares up to 15 digits of a number at once
+constexpr int SORT_KEY_MAX_DIGITS = 15;
+
+bool IsSortDigit(wchar_t c)
+{
+  return c >= L'0' && c <= L'9';
+}
+
+bool IsSortSymbol(wchar_t c)
+{
+  return (c >= 32 && c < L'0') || (c > L'9' && c < L'A') || (c > L'Z' && c < L'a') ||
+         (c > L'z' && c < 128);
+}
+
+wchar_t FoldSortCharacter(wchar_t c, bool localeCollation)
+{
+  if (!localeCollation && c > 128)
+    c = GetCollationWeight(c);
+  if (c >= L'A' && c <= L'Z')
+    c += L'a' - L'A';
+  return c;
+}
+} // namespace
+
+bool StringUtils::AlphaNumericSortKeys(const std::vector<std::wstring>& labels,
+                                       std::vector<std::vector<uint32_t>>& keys)
+{
+  // A key is a sequence of weights. Symbols and other characters map to a single weight, with
+  // symbols ordered first. A run of digits becomes a marker with the weight of a digit followed
+  // by the 64 bit value of the number, so numbers are ordered by value among themselves and like
+  // their first digit against other characters. This only works as long as no other character
+  // has a weight in between the digits.
+  const bool localeCollation = g_langInfo.UseLocaleCollation();
+
+  // with locale collation the weight of a character is its rank among all characters in the list
+  std::vector<std::pair<wchar_t, uint32_t>> ranks;
+  if (localeCollation)
+  {
+    std::vector<wchar_t> chars;
+    for (wchar_t c = L'0'; c <= L'9'; ++c)
+      chars.push_back(c);
+    for (const auto& label : labels)
+    {
+      for (wchar_t c : label)
+      {
+        if (c != 0 && !IsSortDigit(c) && !IsSortSymbol(c))
+          chars.push_back(FoldSortCharacter(c, true));
+      }
+    }
+    std::sort(chars.begin(), chars.end());
+    chars.erase(std::unique(chars.begin(), chars.end()), chars.end());
+
+    const std::collate<wchar_t>& coll =
+        std::use_facet<std::collate<wchar_t>>(g_langInfo.GetSystemLocale());
+    auto collate = [&coll](wchar_t left, wchar_t right) {
+      return coll.compare(&left, &left + 1, &right, &right + 1);
+    };
+
+    std::vector<wchar_t> ordered(chars);
+    std::stable_sort(ordered.begin(), ordered.end(),
+                     [&collate](wchar_t left, wchar_t right) { return collate(left, right) < 0; });
+
+    ranks.reserve(ordered.size());
+    uint32_t rank = 0;
+    uint32_t firstDigit = UINT32_MAX;
+    uint32_t lastDigit = 0;
+    for (size_t i = 0; i < ordered.size(); ++i)
+    {
+      if (i > 0 && collate(ordered[i - 1], ordered[i]) != 0)
+        ++rank;
+      ranks.emplace_back(ordered[i], rank);
+      if (IsSortDigit(ordered[i]))
+      {
+        firstDigit = std::min(firstDigit, rank);
+        lastDigit = std::max(lastDigit, rank);
+      }
+    }
+    for (const auto& it : ranks)
+    {
+      if (!IsSortDigit(it.first) && it.second >= firstDigit && it.second <= lastDigit)
+        return false;
+    }
+    std::sort(ranks.begin(), ranks.end());
+  }
+
+  auto weight = [&](wchar_t c) -> uint32_t {
+    if (!localeCollation)
+      return SORT_KEY_CHARACTER + static_cast<uint32_t>(c);
+    auto it = std::lower_bound(ranks.begin(), ranks.end(), std::make_pair(c, uint32_t(0)));
+    return SORT_KEY_CHARACTER + it->second;
+  };
+  const uint32_t numberWeight = weight(L'0');
+
+  keys.clear();
+  keys.reserve(labels.size());
+  for (const auto& label : labels)
+  {
+    // AlphaNumericCompare() stops at the first null character
+    const size_t length = std::min(label.size(), label.find(L'\0'));
+    std::vector<uint32_t> key;
+    key.reserve(length);
+    for (size_t i = 0; i < length;)
+    {
+      const wchar_t c = label[i];
+      if (IsSortDigit(c))
+      {
+        uint64_t number = 0;
+        for (int digits = 0;
+             i < length && IsSortDigit(label[i]) && digits < SORT_KEY_MAX_DIGITS; ++digits)
+          number = number * 10 + (label[i++] - L'0');
+        key.push_back(numberWeight);
+        key.push_back(static_cast<uint32_t>(number >> 32));
+        key.push_back(static_cast<uint32_t>(number));
+        continue;
+      }
+
+      if (IsSortSymbol(c))
+        key.push_back(SORT_KEY_SYMBOL + static_cast<uint32_t>(c));
+      else
+      {
+        const uint32_t w = weight(FoldSortCharacter(c, localeCollation));
+        // a character folding to a digit would be mistaken for a number
+        if (!localeCollation && w >= weight(L'0') && w <= weight(L'9'))
+          return false;
+        key.push_back(w);
+      }
+      ++i;
+    }
+    keys.push_back(std::move(key));
+  }
+
+  return true;
+}
+
 /*
   Convert the UTF8 character to which z points into a 31-bit Unicode point.
   Return how many bytes (0 to 3) of UTF8 data encode the character.
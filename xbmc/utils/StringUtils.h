@@ -237,6 +237,21 @@ public:
                                              size_t iMaxStrings = 0);
   static int FindNumber(const std::string& strInput, const std::string &strFind);
   static int64_t AlphaNumericCompare(const wchar_t *left, const wchar_t *right);
+  /*!
+   \brief Build binary sort keys that order like AlphaNumericCompare()
+
+   Comparing two keys with operator< gives the same order as AlphaNumericCompare() on their
+   labels, so sorting by key only decodes every label once instead of on every comparison.
+   The keys depend on all labels of the list when locale collation is used, so they can only be
+   compared with keys built by the same call.
+
+   \param labels the labels to build the keys for
+   \param keys receives one key per label
+   \return false if the labels contain characters whose order can't be expressed by a key, the
+   caller has to compare the labels with AlphaNumericCompare() then
+   */
+  static bool AlphaNumericSortKeys(const std::vector<std::wstring>& labels,
+                                   std::vector<std::vector<uint32_t>>& keys);
   static int AlphaNumericCollation(int nKey1, const void* pKey1, int nKey2, const void* pKey2);
   static long TimeStringToSeconds(const std::string &timeString);
   static void RemoveCRLF(std::string& strLine);
@@ -144,7 +144,7 @@ CVariant::CVariant(VariantType type)
       m_data.dvalue = 0.0;
       break;
     case VariantTypeString:
-      m_data.string = new std::string();
+      assignString("", 0);
       break;
     case VariantTypeWideString:
       m_data.wstring = new std::wstring();
@@ -208,25 +208,25 @@ CVariant::CVariant(bool boolean)
 CVariant::CVariant(const char *str)
 {
   m_type = VariantTypeString;
-  m_data.string = new std::string(str);
+  assignString(str, strlen(str));
 }
 
 CVariant::CVariant(const char *str, unsigned int length)
 {
   m_type = VariantTypeString;
-  m_data.string = new std::string(str, length);
+  assignString(str, length);
 }
 
 CVariant::CVariant(const std::string &str)
 {
   m_type = VariantTypeString;
-  m_data.string = new std::string(str);
+  assignString(str.c_str(), str.size());
 }
 
 CVariant::CVariant(std::string &&str)
 {
   m_type = VariantTypeString;
-  m_data.string = new std::string(std::move(str));
+  assignString(std::move(str));
 }
 
 CVariant::CVariant(const wchar_t *str)
@@ -259,7 +259,7 @@ CVariant::CVariant(const std::vector<std::string> &strArray)
   m_data.array = new VariantArray;
   m_data.array->reserve(strArray.size());
   for (const auto& item : strArray)
-    m_data.array->push_back(CVariant(item));
+    m_data.array->emplace_back(item);
 }
 
 CVariant::CVariant(const std::map<std::string, std::string> &strMap)
@@ -267,7 +267,7 @@ CVariant::CVariant(const std::map<std::string, std::string> &strMap)
   m_type = VariantTypeObject;
   m_data.map = new VariantMap;
   for (std::map<std::string, std::string>::const_iterator it = strMap.begin(); it != strMap.end(); ++it)
-    m_data.map->insert(make_pair(it->first, CVariant(it->second)));
+    m_data.map->emplace_hint(m_data.map->end(), it->first, CVariant(it->second));
 }
 
 CVariant::CVariant(const std::map<std::string, CVariant> &variantMap)
@@ -301,8 +301,10 @@ void CVariant::cleanup()
   switch (m_type)
   {
   case VariantTypeString:
-    delete m_data.string;
+    if (m_stringLength == LONG_STRING)
+      delete m_data.string;
     m_data.string = nullptr;
+    m_stringLength = LONG_STRING;
     break;
 
   case VariantTypeWideString:
@@ -325,6 +327,39 @@ void CVariant::cleanup()
   m_type = VariantTypeNull;
 }
 
+void CVariant::assignString(const char* str, size_t length)
+{
+  if (length < SHORT_STRING_SIZE)
+  {
+    memcpy(m_data.shortString, str, length);
+    m_data.shortString[length] = '\0';
+    m_stringLength = static_cast<uint8_t>(length);
+  }
+  else
+  {
+    m_data.string = new std::string(str, length);
+    m_stringLength = LONG_STRING;
+  }
+}
+
+void CVariant::assignString(std::string&& str)
+{
+  if (str.size() < SHORT_STRING_SIZE)
+    assignString(str.c_str(), str.size());
+  else
+  {
+    m_data.string = new std::string(std::move(str));
+    m_stringLength = LONG_STRING;
+  }
+}
+
+std::string_view CVariant::stringView() const
+{
+  if (m_stringLength == LONG_STRING)
+    return *m_data.string;
+  return std::string_view(m_data.shortString, m_stringLength);
+}
+
 bool CVariant::isInteger() const
 {
   return isSignedInteger() || isUnsignedInteger();
@@ -391,7 +426,7 @@ int64_t CVariant::asInteger(int64_t fallback) const
     case VariantTypeDouble:
       return (int64_t)m_data.dvalue;
     case VariantTypeString:
-      return str2int64(*m_data.string, fallback);
+      return str2int64(std::string(stringView()), fallback);
     case VariantTypeWideString:
       return str2int64(*m_data.wstring, fallback);
     default:
@@ -417,7 +452,7 @@ uint64_t CVariant::asUnsignedInteger(uint64_t fallback) const
     case VariantTypeDouble:
       return (uint64_t)m_data.dvalue;
     case VariantTypeString:
-      return str2uint64(*m_data.string, fallback);
+      return str2uint64(std::string(stringView()), fallback);
     case VariantTypeWideString:
       return str2uint64(*m_data.wstring, fallback);
     default:
@@ -443,7 +478,7 @@ double CVariant::asDouble(double fallback) const
     case VariantTypeUnsignedInteger:
       return (double)m_data.unsignedinteger;
     case VariantTypeString:
-      return str2double(*m_data.string, fallback);
+      return str2double(std::string(stringView()), fallback);
     case VariantTypeWideString:
       return str2double(*m_data.wstring, fallback);
     default:
@@ -464,7 +499,7 @@ float CVariant::asFloat(float fallback) const
     case VariantTypeUnsignedInteger:
       return (float)m_data.unsignedinteger;
     case VariantTypeString:
-      return (float)str2double(*m_data.string, static_cast<double>(fallback));
+      return (float)str2double(std::string(stringView()), static_cast<double>(fallback));
     case VariantTypeWideString:
       return (float)str2double(*m_data.wstring, static_cast<double>(fallback));
     default:
@@ -487,9 +522,12 @@ bool CVariant::asBoolean(bool fallback) const
     case VariantTypeDouble:
       return (m_data.dvalue != 0);
     case VariantTypeString:
-      if (m_data.string->empty() || m_data.string->compare("0") == 0 || m_data.string->compare("false") == 0)
+    {
+      const std::string_view str = stringView();
+      if (str.empty() || str == "0" || str == "false")
         return false;
       return true;
+    }
     case VariantTypeWideString:
       if (m_data.wstring->empty() || m_data.wstring->compare(L"0") == 0 || m_data.wstring->compare(L"false") == 0)
         return false;
@@ -506,7 +544,7 @@ std::string CVariant::asString(const std::string &fallback /* = "" */) const
   switch (m_type)
   {
     case VariantTypeString:
-      return *m_data.string;
+      return std::string(stringView());
     case VariantTypeBoolean:
       return m_data.boolean ? "true" : "false";
     case VariantTypeInteger:
@@ -606,7 +644,11 @@ CVariant &CVariant::operator=(const CVariant &rhs)
     m_data.dvalue = rhs.m_data.dvalue;
     break;
   case VariantTypeString:
-    m_data.string = new std::string(*rhs.m_data.string);
+    if (rhs.m_stringLength == LONG_STRING)
+      m_data.string = new std::string(*rhs.m_data.string);
+    else
+      m_data = rhs.m_data;
+    m_stringLength = rhs.m_stringLength;
     break;
   case VariantTypeWideString:
     m_data.wstring = new std::wstring(*rhs.m_data.wstring);
@@ -634,6 +676,7 @@ CVariant& CVariant::operator=(CVariant&& rhs) noexcept
     cleanup();
 
   m_type = rhs.m_type;
+  m_stringLength = rhs.m_stringLength;
   m_data = rhs.m_data;
 
   //Should be enough to just set m_type here
@@ -648,6 +691,7 @@ CVariant& CVariant::operator=(CVariant&& rhs) noexcept
     rhs.m_data.map = nullptr;
 
   rhs.m_type = VariantTypeNull;
+  rhs.m_stringLength = LONG_STRING;
 
   return *this;
 }
@@ -667,7 +711,7 @@ bool CVariant::operator==(const CVariant &rhs) const
     case VariantTypeDouble:
       return m_data.dvalue == rhs.m_data.dvalue;
     case VariantTypeString:
-      return *m_data.string == *rhs.m_data.string;
+      return stringView() == rhs.stringView();
     case VariantTypeWideString:
       return *m_data.wstring == *rhs.m_data.wstring;
     case VariantTypeArray:
@@ -730,7 +774,7 @@ void CVariant::append(CVariant&& variant)
 const char *CVariant::c_str() const
 {
   if (m_type == VariantTypeString)
-    return m_data.string->c_str();
+    return m_stringLength == LONG_STRING ? m_data.string->c_str() : m_data.shortString;
   else
     return NULL;
 }
@@ -738,12 +782,15 @@ const char *CVariant::c_str() const
 void CVariant::swap(CVariant &rhs)
 {
   VariantType  temp_type = m_type;
+  uint8_t      temp_length = m_stringLength;
   VariantUnion temp_data = m_data;
 
   m_type = rhs.m_type;
+  m_stringLength = rhs.m_stringLength;
   m_data = rhs.m_data;
 
   rhs.m_type = temp_type;
+  rhs.m_stringLength = temp_length;
   rhs.m_data = temp_data;
 }
 
@@ -818,7 +865,7 @@ unsigned int CVariant::size() const
   else if (m_type == VariantTypeArray)
     return m_data.array->size();
   else if (m_type == VariantTypeString)
-    return m_data.string->size();
+    return stringView().size();
   else if (m_type == VariantTypeWideString)
     return m_data.wstring->size();
   else
@@ -832,7 +879,7 @@ bool CVariant::empty() const
   else if (m_type == VariantTypeArray)
     return m_data.array->empty();
   else if (m_type == VariantTypeString)
-    return m_data.string->empty();
+    return stringView().empty();
   else if (m_type == VariantTypeWideString)
     return m_data.wstring->empty();
   else if (m_type == VariantTypeNull)
@@ -848,7 +895,12 @@ void CVariant::clear()
   else if (m_type == VariantTypeArray)
     m_data.array->clear();
   else if (m_type == VariantTypeString)
-    m_data.string->clear();
+  {
+    if (m_stringLength == LONG_STRING)
+      m_data.string->clear();
+    else
+      assignString("", 0);
+  }
   else if (m_type == VariantTypeWideString)
     m_data.wstring->clear();
 }
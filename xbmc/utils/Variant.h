@@ -11,6 +11,7 @@
 #include <map>
 #include <stdint.h>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <wchar.h>
 
@@ -145,6 +146,14 @@ public:
 
 private:
   void cleanup();
+  void assignString(const char* str, size_t length);
+  void assignString(std::string&& str);
+  std::string_view stringView() const;
+
+  // strings shorter than this are stored inline without a heap allocation
+  static constexpr size_t SHORT_STRING_SIZE = 16;
+  static constexpr uint8_t LONG_STRING = 0xFF;
+
   union VariantUnion
   {
     int64_t integer;
@@ -155,9 +164,11 @@ private:
     std::wstring *wstring;
     VariantArray *array;
     VariantMap *map;
+    char shortString[SHORT_STRING_SIZE];
   };
 
   VariantType m_type;
+  uint8_t m_stringLength = LONG_STRING; ///< length of an inline string or LONG_STRING
   VariantUnion m_data;
 
   static VariantArray EMPTY_ARRAY;
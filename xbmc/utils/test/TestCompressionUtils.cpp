@@ -0,0 +1,81 @@
+/*
+ *  Copyright (C) 2023 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "utils/CompressionUtils.h"
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+std::string TestData()
+{
+  std::string data;
+  for (int i = 0; i < 2000; i++)
+    data += "{\"label\":\"Movie " + std::to_string(i) + "\",\"movieid\":" + std::to_string(i) + "},";
+  return data;
+}
+} // unnamed namespace
+
+TEST(TestCompressionUtils, Gzip)
+{
+  const std::string data = TestData();
+  std::string compressed;
+  ASSERT_TRUE(CCompressionUtils::Gzip(data.c_str(), data.size(), compressed));
+  ASSERT_GT(compressed.size(), 10U);
+  EXPECT_LT(compressed.size(), data.size() / 4);
+
+  // gzip magic number and deflate compression method
+  EXPECT_EQ('\x1f', compressed[0]);
+  EXPECT_EQ('\x8b', compressed[1]);
+  EXPECT_EQ('\x08', compressed[2]);
+}
+
+TEST(TestCompressionUtils, DeflateRawRoundTrip)
+{
+  for (const std::string& data : {std::string(), std::string("a"), TestData()})
+  {
+    std::string compressed;
+    ASSERT_TRUE(CCompressionUtils::DeflateRaw(data.c_str(), data.size(), compressed));
+
+    // flushed streams end with an empty stored block
+    ASSERT_GE(compressed.size(), 4U);
+    EXPECT_EQ(std::string("\x00\x00\xff\xff", 4), compressed.substr(compressed.size() - 4));
+
+    std::string decompressed;
+    ASSERT_TRUE(CCompressionUtils::InflateRaw(compressed.c_str(), compressed.size(), decompressed,
+                                              data.size() + 1));
+    EXPECT_EQ(data, decompressed);
+
+    // permessage-deflate strips the empty block, the data still has to be complete
+    ASSERT_TRUE(CCompressionUtils::InflateRaw(compressed.c_str(), compressed.size() - 4,
+                                              decompressed, data.size() + 1));
+    EXPECT_EQ(data, decompressed);
+  }
+}
+
+TEST(TestCompressionUtils, InflateRawLimit)
+{
+  const std::string data = TestData();
+  std::string compressed;
+  ASSERT_TRUE(CCompressionUtils::DeflateRaw(data.c_str(), data.size(), compressed));
+
+  std::string decompressed;
+  EXPECT_FALSE(CCompressionUtils::InflateRaw(compressed.c_str(), compressed.size(), decompressed,
+                                             data.size() / 2));
+  EXPECT_TRUE(decompressed.empty());
+}
+
+TEST(TestCompressionUtils, InflateRawInvalid)
+{
+  const std::string data = "not deflated at all";
+  std::string decompressed;
+  EXPECT_FALSE(
+      CCompressionUtils::InflateRaw(data.c_str(), data.size(), decompressed, 1024 * 1024));
+}
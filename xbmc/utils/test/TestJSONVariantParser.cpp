@@ -7,8 +7,13 @@
  */
 
 #include "utils/JSONVariantParser.h"
+#include "utils/JSONVariantWriter.h"
 #include "utils/Variant.h"
 
+#include <chrono>
+#include <iostream>
+#include <string>
+
 #include <gtest/gtest.h>
 
 TEST(TestJSONVariantParser, CannotParseNullptr)
@@ -187,3 +192,41 @@ TEST(TestJSONVariantParser, CanParseArray)
   ASSERT_TRUE(variant[0]["foo"].isString());
   ASSERT_STREQ("bar", variant[0]["foo"].asString().c_str());
 }
+
+// Micro benchmark, run with --gtest_also_run_disabled_tests
+TEST(TestJSONVariantParser, DISABLED_Benchmark)
+{
+  // a response similar to a large AudioLibrary.GetSongs result
+  CVariant songs(CVariant::VariantTypeArray);
+  for (int i = 0; i < 10000; ++i)
+  {
+    CVariant song(CVariant::VariantTypeObject);
+    song["songid"] = i;
+    song["label"] = "Song " + std::to_string(i);
+    song["title"] = "A somewhat longer song title " + std::to_string(i);
+    song["artist"].push_back("Artist");
+    song["genre"].push_back("Rock");
+    song["duration"] = 180 + i % 120;
+    song["rating"] = 0.5 * (i % 10);
+    song["file"] = "/storage/music/Artist/Album/" + std::to_string(i) + ".flac";
+    songs.push_back(std::move(song));
+  }
+  CVariant response(CVariant::VariantTypeObject);
+  response["songs"] = std::move(songs);
+
+  std::string json;
+  ASSERT_TRUE(CJSONVariantWriter::Write(response, json, true));
+
+  constexpr int runs = 20;
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < runs; ++i)
+  {
+    CVariant parsed;
+    ASSERT_TRUE(CJSONVariantParser::Parse(json, parsed));
+    ASSERT_TRUE(CJSONVariantWriter::Write(parsed, json, true));
+  }
+  const auto end = std::chrono::steady_clock::now();
+  std::cout << "parse and write " << json.size() << " bytes: "
+            << std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() / runs
+            << " us per run\n";
+}
@@ -17,6 +17,10 @@
 #include "utils/StringUtils.h"
 #include "utils/log.h"
 
+#include <chrono>
+#include <iostream>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 TEST(TestRegExp, RegFind)
@@ -123,6 +127,140 @@ TEST(TestRegExp, operatorEqual)
   EXPECT_STREQ("string", match.c_str());
 }
 
+TEST(TestRegExp, RegCompShared)
+{
+  CRegExp regex, other;
+  std::string match;
+
+  EXPECT_TRUE(regex.RegCompShared("^(?<first>Test)\\s*(?<second>.*)\\."));
+  EXPECT_TRUE(other.RegCompShared("^(?<first>Test)\\s*(?<second>.*)\\."));
+  EXPECT_EQ(0, regex.RegFind("Test string."));
+  EXPECT_EQ(-1, other.RegFind("No match."));
+  // match state is per object even though the compiled code is shared
+  EXPECT_TRUE(regex.GetNamedSubPattern("second", match));
+  EXPECT_STREQ("string", match.c_str());
+  EXPECT_FALSE(other.GetNamedSubPattern("second", match));
+
+  EXPECT_FALSE(regex.RegCompShared("(unbalanced"));
+  EXPECT_FALSE(regex.RegCompShared("(unbalanced"));
+  EXPECT_FALSE(regex.IsCompiled());
+
+  CRegExp::ClearSharedCache();
+  EXPECT_TRUE(regex.RegCompShared("^Test"));
+  EXPECT_EQ(0, regex.RegFind("Test string."));
+  // clearing the cache does not affect expressions already in use
+  EXPECT_EQ(0, other.RegFind("Test again."));
+}
+
+TEST(TestRegExpSet, FirstMatchWins)
+{
+  CRegExpSet set(true, CRegExp::autoUtf8);
+
+  EXPECT_TRUE(set.Add("s([0-9]+)e([0-9]+)"));
+  EXPECT_TRUE(set.Add("([0-9]+)x([0-9]+)"));
+  EXPECT_TRUE(set.Add("(part)[ ._-]*([0-9]+)"));
+  EXPECT_EQ(3u, set.Size());
+  EXPECT_TRUE(set.IsCombined());
+
+  EXPECT_EQ(0, set.RegFind("Show.S01E02.mkv"));
+  EXPECT_STREQ("01", set.GetRegExp(0).GetMatch(1).c_str());
+  EXPECT_STREQ("02", set.GetRegExp(0).GetMatch(2).c_str());
+
+  // the second expression matches further left, the first one still takes precedence
+  EXPECT_EQ(0, set.RegFind("1x05 Show s02e03.mkv"));
+  EXPECT_STREQ("02", set.GetRegExp(0).GetMatch(1).c_str());
+
+  EXPECT_EQ(1, set.RegFind("Show 3x04.avi"));
+  EXPECT_STREQ("04", set.GetRegExp(1).GetMatch(2).c_str());
+  EXPECT_EQ(-1, set.RegFind("Show 3x04.avi", 2));
+
+  EXPECT_EQ(2, set.RegFind("Movie PART 2.avi"));
+  EXPECT_EQ(-1, set.RegFind("Movie.avi"));
+
+  // iterate all matching expressions in order
+  std::vector<int> matches;
+  for (int i = set.RegFind("s01e02 1x02 part1"); i >= 0; i = set.RegFind("s01e02 1x02 part1", i + 1))
+    matches.push_back(i);
+  EXPECT_EQ((std::vector<int>{0, 1, 2}), matches);
+}
+
+TEST(TestRegExpSet, Fallback)
+{
+  CRegExpSet set(false, CRegExp::autoUtf8);
+
+  EXPECT_TRUE(set.Add("(a+)b"));
+  EXPECT_FALSE(set.Add("(broken"));
+  // back references can't be renumbered in a combined expression
+  EXPECT_TRUE(set.Add("([xy])\\1"));
+  EXPECT_EQ(3u, set.Size());
+  EXPECT_FALSE(set.IsCombined());
+
+  EXPECT_EQ(2, set.RegFind("xyy"));
+  EXPECT_STREQ("y", set.GetRegExp(2).GetMatch(1).c_str());
+  EXPECT_EQ(0, set.RegFind("aab yy"));
+  EXPECT_EQ(2, set.RegFind("aab yy", 1));
+  EXPECT_EQ(-1, set.RegFind("AAB"));
+}
+
+// Micro benchmark, run with --gtest_also_run_disabled_tests
+TEST(TestRegExpSet, DISABLED_Benchmark)
+{
+  const std::vector<std::string> patterns = {
+      "s([0-9]+)[ ._x-]*e([0-9]+(?:(?:[a-i]|\\.[1-9])(?![0-9]))?)([^\\\\/]*)$",
+      "[\\._ -]()e(?:p[ ._-]?)?([0-9]+(?:(?:[a-i]|\\.[1-9])(?![0-9]))?)([^\\\\/]*)$",
+      "([0-9]{4})[\\.-]([0-9]{2})[\\.-]([0-9]{2})",
+      "([0-9]{2})[\\.-]([0-9]{2})[\\.-]([0-9]{4})",
+      "[\\\\/\\._ \\[\\(-]([0-9]+)x([0-9]+(?:(?:[a-i]|\\.[1-9])(?![0-9]))?)([^\\\\/]*)$",
+      "[\\\\/\\._ -]([0-9]+)([0-9][0-9](?:(?:[a-i]|\\.[1-9])(?![0-9]))?)([\\._ -][^\\\\/]*)$",
+      "[\\/._ -]p(?:ar)?t[_. -]()([ivx]+|[0-9]+)([._ -][^\\/]*)$"};
+
+  std::vector<std::string> files;
+  for (int i = 0; i < 2000; ++i)
+  {
+    switch (i % 4)
+    {
+      case 0:
+        files.push_back("/media/tv/Show " + std::to_string(i) + "/Show.S01E" + std::to_string(i % 30) + ".mkv");
+        break;
+      case 1:
+        files.push_back("/media/tv/Show/Show " + std::to_string(i % 9) + "x" + std::to_string(i % 30) + ".avi");
+        break;
+      case 2:
+        files.push_back("/media/tv/Daily/2021-03-" + std::to_string(10 + i % 18) + ".mp4");
+        break;
+      default:
+        files.push_back("/media/movies/Some Movie (" + std::to_string(1950 + i % 70) + ").mkv");
+        break;
+    }
+  }
+
+  auto run = [&](const char* name, auto f) {
+    int found = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (const auto& file : files)
+      found += f(file) >= 0;
+    const auto end = std::chrono::steady_clock::now();
+    std::cout << name << ": "
+              << std::chrono::duration_cast<std::chrono::microseconds>(end - start).count()
+              << " us for " << files.size() << " files, " << found << " matched\n";
+  };
+
+  run("RegComp per file", [&](const std::string& file) {
+    for (size_t i = 0; i < patterns.size(); ++i)
+    {
+      CRegExp reg(true, CRegExp::autoUtf8);
+      if (reg.RegComp(patterns[i]) && reg.RegFind(file) >= 0)
+        return static_cast<int>(i);
+    }
+    return -1;
+  });
+
+  CRegExpSet set(true, CRegExp::autoUtf8);
+  for (const auto& pattern : patterns)
+    set.Add(pattern);
+  run("CRegExpSet", [&](const std::string& file) { return set.RegFind(file); });
+}
+
 class TestRegExpLog : public testing::Test
 {
 protected:
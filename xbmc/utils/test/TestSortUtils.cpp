@@ -7,8 +7,13 @@
  */
 
 #include "utils/SortUtils.h"
+#include "utils/StringUtils.h"
 #include "utils/Variant.h"
 
+#include <chrono>
+#include <iostream>
+#include <string>
+
 #include <gtest/gtest.h>
 
 TEST(TestSortUtils, Sort_SortBy)
@@ -103,6 +108,86 @@ TEST(TestSortUtils, Sort_SortDescription)
   EXPECT_STREQ("R Artist", (*items.at(6))[FieldArtist].asString().c_str());
 }
 
+TEST(TestSortUtils, Sort_NumbersFoldersSpecial)
+{
+  SortItems items;
+  auto add = [&items](const std::string& label, bool folder, SortSpecial special) {
+    SortItemPtr item(new SortItem());
+    (*item)[FieldLabel] = label;
+    (*item)[FieldFolder] = folder;
+    (*item)[FieldSortSpecial] = special;
+    items.push_back(item);
+  };
+  add("Episode 10", false, SortSpecialNone);
+  add("..", true, SortSpecialOnTop);
+  add("episode 9", false, SortSpecialNone);
+  add("Extras", true, SortSpecialNone);
+  add("Episode 1", false, SortSpecialNone);
+  add("Add source", false, SortSpecialOnBottom);
+
+  SortUtils::Sort(SortByLabel, SortOrderAscending, SortAttributeNone, items);
+  EXPECT_EQ("..", (*items[0])[FieldLabel].asString());
+  EXPECT_EQ("Extras", (*items[1])[FieldLabel].asString());
+  EXPECT_EQ("Episode 1", (*items[2])[FieldLabel].asString());
+  EXPECT_EQ("episode 9", (*items[3])[FieldLabel].asString());
+  EXPECT_EQ("Episode 10", (*items[4])[FieldLabel].asString());
+  EXPECT_EQ("Add source", (*items[5])[FieldLabel].asString());
+
+  SortUtils::Sort(SortByLabel, SortOrderDescending, SortAttributeIgnoreFolders, items);
+  EXPECT_EQ("..", (*items[0])[FieldLabel].asString());
+  EXPECT_EQ("Extras", (*items[1])[FieldLabel].asString());
+  EXPECT_EQ("Episode 10", (*items[2])[FieldLabel].asString());
+  EXPECT_EQ("episode 9", (*items[3])[FieldLabel].asString());
+  EXPECT_EQ("Episode 1", (*items[4])[FieldLabel].asString());
+  EXPECT_EQ("Add source", (*items[5])[FieldLabel].asString());
+}
+
+TEST(TestSortUtils, Sort_LargeList)
+{
+  // large enough to be sorted in parallel, with duplicates to check the order is stable
+  DatabaseResults items(30000);
+  for (size_t i = 0; i < items.size(); ++i)
+  {
+    items[i][FieldLabel] = "Item " + std::to_string((i * 7919) % 1000);
+    items[i][FieldId] = static_cast<int>(i);
+  }
+
+  SortUtils::Sort(SortByLabel, SortOrderAscending, SortAttributeNone, items);
+  ASSERT_EQ(30000U, items.size());
+  for (size_t i = 1; i < items.size(); ++i)
+  {
+    const std::wstring& left = items[i - 1][FieldSort].asWideString();
+    const std::wstring& right = items[i][FieldSort].asWideString();
+    const int64_t compare = StringUtils::AlphaNumericCompare(left.c_str(), right.c_str());
+    ASSERT_LE(compare, 0);
+    if (compare == 0)
+      ASSERT_LT(items[i - 1][FieldId].asInteger(), items[i][FieldId].asInteger());
+  }
+}
+
+// Micro benchmark, run with --gtest_also_run_disabled_tests
+TEST(TestSortUtils, DISABLED_Benchmark)
+{
+  constexpr size_t count = 30000;
+  SortItems items;
+  for (size_t i = 0; i < count; ++i)
+  {
+    SortItemPtr item(new SortItem());
+    (*item)[FieldLabel] = "The Movie Title " + std::to_string((i * 7919) % count);
+    items.push_back(item);
+  }
+
+  for (SortOrder order : {SortOrderAscending, SortOrderDescending})
+  {
+    const auto start = std::chrono::steady_clock::now();
+    SortUtils::Sort(SortByLabel, order, SortAttributeIgnoreArticle, items);
+    const auto end = std::chrono::steady_clock::now();
+    std::cout << "sorting " << count << " items: "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count()
+              << " ms\n";
+  }
+}
+
 TEST(TestSortUtils, GetFieldsForSorting)
 {
   Fields fields;
@@ -356,6 +356,28 @@ TEST(TestStringUtils, AlphaNumericCompare)
   EXPECT_LT(var, ref);
 }
 
+TEST(TestStringUtils, AlphaNumericSortKeys)
+{
+  const std::vector<std::wstring> labels = {
+      L"abc123", L"123abc", L"abc12",  L"abc0012", L"ABC2",  L"abc",  L"",
+      L"!abc",   L"a b",    L"a-b",    L"\u00e9t\u00e9", L"ete", L"zz", L"1234567890123456789",
+      L"12345678901234567", L"9"};
+
+  std::vector<std::vector<uint32_t>> keys;
+  ASSERT_TRUE(StringUtils::AlphaNumericSortKeys(labels, keys));
+  ASSERT_EQ(labels.size(), keys.size());
+
+  for (size_t l = 0; l < labels.size(); ++l)
+  {
+    for (size_t r = 0; r < labels.size(); ++r)
+    {
+      const int64_t compare = StringUtils::AlphaNumericCompare(labels[l].c_str(), labels[r].c_str());
+      EXPECT_EQ(compare < 0, keys[l] < keys[r]) << l << " " << r;
+      EXPECT_EQ(compare > 0, keys[r] < keys[l]) << l << " " << r;
+    }
+  }
+}
+
 TEST(TestStringUtils, TimeStringToSeconds)
 {
   EXPECT_EQ(77455, StringUtils::TimeStringToSeconds("21:30:55"));
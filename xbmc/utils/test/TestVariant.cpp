@@ -63,6 +63,40 @@ TEST(TestVariant, VariantTypeString)
   EXPECT_STREQ("VariantTypeString3", c.asString().c_str());
 }
 
+TEST(TestVariant, VariantTypeStringLength)
+{
+  // around the size of strings stored inline
+  for (size_t length : {0, 1, 14, 15, 16, 17, 100})
+  {
+    const std::string str(length, 'x');
+    CVariant a(str);
+    CVariant b{std::string(str)};
+    CVariant c(a);
+    CVariant d;
+    d = std::move(b);
+
+    EXPECT_EQ(length, a.size());
+    EXPECT_EQ(length == 0, a.empty());
+    EXPECT_EQ(str, a.asString());
+    EXPECT_EQ(str, c.asString());
+    EXPECT_EQ(str, d.asString());
+    EXPECT_STREQ(str.c_str(), d.c_str());
+    EXPECT_TRUE(a == c);
+    EXPECT_TRUE(a == d);
+    EXPECT_FALSE(a == CVariant(str + "y"));
+
+    d.swap(c);
+    EXPECT_EQ(str, c.asString());
+    d.clear();
+    EXPECT_TRUE(d.empty());
+    EXPECT_TRUE(d.isString());
+  }
+
+  CVariant embedded("a\0b", 3);
+  EXPECT_EQ(3u, embedded.size());
+  EXPECT_EQ(std::string("a\0b", 3), embedded.asString());
+}
+
 TEST(TestVariant, VariantTypeWideString)
 {
   CVariant a(L"VariantTypeWideString");
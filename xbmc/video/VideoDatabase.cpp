@@ -349,13 +349,23 @@ void CVideoDatabase::CreateAnalytics()
               "DELETE FROM streamdetails WHERE idFile=old.idFile; "
               "END");
 
+  // Full-text indices used by searches and "contains" filters (SQLite only)
+  CreateFullTextIndex("movie", "idMovie",
+                      {StringUtils::Format("c{:02}", VIDEODB_ID_TITLE),
+                       StringUtils::Format("c{:02}", VIDEODB_ID_ORIGINALTITLE)});
+  CreateFullTextIndex("tvshow", "idShow", {StringUtils::Format("c{:02}", VIDEODB_ID_TV_TITLE)});
+  CreateFullTextIndex("episode", "idEpisode",
+                      {StringUtils::Format("c{:02}", VIDEODB_ID_EPISODE_TITLE)});
+  CreateFullTextIndex("musicvideo", "idMVideo",
+                      {StringUtils::Format("c{:02}", VIDEODB_ID_MUSICVIDEO_TITLE)});
+
   CreateViews();
 }
 
 void CVideoDatabase::CreateViews()
 {
   CLog::Log(LOGINFO, "create episode_view");
-  std::string episodeview = PrepareSQL("CREATE VIEW episode_view AS SELECT "
+  std::string episodeview = PrepareSQL("SELECT "
                                       "  episode.*,"
                                       "  files.strFileName AS strFileName,"
                                       "  path.strPath AS strPath,"
@@ -394,7 +404,21 @@ void CVideoDatabase::CreateViews()
                                       VIDEODB_ID_TV_STUDIOS, VIDEODB_ID_TV_PREMIERED,
                                       VIDEODB_ID_TV_MPAA, VIDEODB_ID_EPISODE_RATING_ID,
                                       VIDEODB_ID_EPISODE_IDENT_ID);
-  m_pDS->exec(episodeview);
+  CreateMaterializedView("episode_view", episodeview, "idEpisode",
+                         {"idShow, idSeason", "idFile"});
+  CreateMaterializedViewTriggers("episode_view", "episode", "idEpisode", MediaTypeEpisode);
+  CreateMaterializedViewTrigger(
+      "episode_view", "idEpisode", "tvshow",
+      PrepareSQL("UPDATE OF c%02d, c%02d, c%02d, c%02d, c%02d", VIDEODB_ID_TV_TITLE,
+                 VIDEODB_ID_TV_GENRE, VIDEODB_ID_TV_STUDIOS, VIDEODB_ID_TV_PREMIERED,
+                 VIDEODB_ID_TV_MPAA),
+      "SELECT idEpisode FROM episode WHERE idShow = NEW.idShow");
+  CreateMaterializedViewTrigger(
+      "episode_view", "idEpisode", "seasons", "INSERT",
+      "SELECT idEpisode FROM episode WHERE idShow = NEW.idShow AND idSeason = NEW.idSeason");
+  CreateMaterializedViewTrigger(
+      "episode_view", "idEpisode", "seasons", "DELETE",
+      "SELECT idEpisode FROM episode WHERE idShow = OLD.idShow AND idSeason = OLD.idSeason");
 
   CLog::Log(LOGINFO, "create tvshowcounts");
   std::string tvshowcounts = PrepareSQL("CREATE VIEW tvshowcounts AS SELECT "
@@ -522,7 +546,7 @@ void CVideoDatabase::CreateViews()
 
   CLog::Log(LOGINFO, "create movie_view");
 
-  std::string movieview = PrepareSQL("CREATE VIEW movie_view AS SELECT"
+  std::string movieview = PrepareSQL("SELECT"
                                       "  movie.*,"
                                       "  sets.strSet AS strSet,"
                                       "  sets.strOverview AS strSetOverview,"
@@ -553,7 +577,63 @@ void CVideoDatabase::CreateViews()
                                       "  LEFT JOIN uniqueid ON"
                                       "    uniqueid.uniqueid_id=movie.c%02d",
                                       VIDEODB_ID_RATING_ID, VIDEODB_ID_IDENT_ID);
-  m_pDS->exec(movieview);
+  CreateMaterializedView("movie_view", movieview, "idMovie", {"idSet", "idFile"});
+  CreateMaterializedViewTriggers("movie_view", "movie", "idMovie", MediaTypeMovie);
+  CreateMaterializedViewTrigger("movie_view", "idMovie", "sets", "UPDATE OF strSet, strOverview",
+                                "SELECT idMovie FROM movie WHERE idSet = NEW.idSet");
+  CreateMaterializedViewTrigger("movie_view", "idMovie", "sets", "DELETE",
+                                "SELECT idMovie FROM movie WHERE idSet = OLD.idSet");
+}
+
+void CVideoDatabase::CreateMaterializedViewTriggers(const std::string& view,
+                                                    const std::string& table,
+                                                    const std::string& idColumn,
+                                                    const std::string& mediaType)
+{
+  const std::string id = table + "." + idColumn;
+
+  CreateMaterializedViewTrigger(view, idColumn, table, "INSERT", "NEW." + idColumn);
+  CreateMaterializedViewTrigger(view, idColumn, table, "UPDATE",
+                                "OLD." + idColumn + ", NEW." + idColumn);
+  CreateMaterializedViewTrigger(view, idColumn, table, "DELETE", "OLD." + idColumn);
+
+  // file, path and resume point
+  const std::string byFile = "SELECT " + id + " FROM " + table + " WHERE idFile IN ({})";
+  CreateMaterializedViewTrigger(view, idColumn, "files", "INSERT",
+                                StringUtils::Format(byFile, "NEW.idFile"));
+  CreateMaterializedViewTrigger(view, idColumn, "files",
+                                "UPDATE OF strFilename, idPath, playCount, lastPlayed, dateAdded",
+                                StringUtils::Format(byFile, "OLD.idFile, NEW.idFile"));
+  CreateMaterializedViewTrigger(view, idColumn, "files", "DELETE",
+                                StringUtils::Format(byFile, "OLD.idFile"));
+  CreateMaterializedViewTrigger(view, idColumn, "bookmark", "INSERT",
+                                StringUtils::Format(byFile, "NEW.idFile"));
+  CreateMaterializedViewTrigger(view, idColumn, "bookmark", "UPDATE",
+                                StringUtils::Format(byFile, "OLD.idFile, NEW.idFile"));
+  CreateMaterializedViewTrigger(view, idColumn, "bookmark", "DELETE",
+                                StringUtils::Format(byFile, "OLD.idFile"));
+
+  const std::string byPath = "SELECT " + id + " FROM " + table + " JOIN files ON files.idFile = " +
+                             table + ".idFile WHERE files.idPath = {}";
+  CreateMaterializedViewTrigger(view, idColumn, "path", "INSERT",
+                                StringUtils::Format(byPath, "NEW.idPath"));
+  CreateMaterializedViewTrigger(view, idColumn, "path", "UPDATE OF strPath",
+                                StringUtils::Format(byPath, "NEW.idPath"));
+  CreateMaterializedViewTrigger(view, idColumn, "path", "DELETE",
+                                StringUtils::Format(byPath, "OLD.idPath"));
+
+  // ratings and unique ids are linked by media id and type
+  for (const char* linked : {"rating", "uniqueid"})
+  {
+    const std::string byMedia = "SELECT {0}.media_id WHERE {0}.media_type = '" + mediaType + "'";
+    CreateMaterializedViewTrigger(view, idColumn, linked, "INSERT",
+                                  StringUtils::Format(byMedia, "NEW"));
+    CreateMaterializedViewTrigger(view, idColumn, linked, "UPDATE",
+                                  StringUtils::Format(byMedia, "OLD") + " UNION " +
+                                      StringUtils::Format(byMedia, "NEW"));
+    CreateMaterializedViewTrigger(view, idColumn, linked, "DELETE",
+                                  StringUtils::Format(byMedia, "OLD"));
+  }
 }
 
 //********************************************************************************************************************************
@@ -5906,7 +5986,7 @@ void CVideoDatabase::UpdateTables(int iVersion)
 
 int CVideoDatabase::GetSchemaVersion() const
 {
-  return 121;
+  return 123;
 }
 
 bool CVideoDatabase::LookupByFolders(const std::string &path, bool shows)
@@ -8990,14 +9070,20 @@ void CVideoDatabase::GetMoviesByName(const std::string& strSearch, CFileItemList
       strSQL = PrepareSQL("SELECT movie.idMovie, movie.c%02d, path.strPath, movie.idSet FROM movie "
                           "INNER JOIN files ON files.idFile=movie.idFile INNER JOIN path ON "
                           "path.idPath=files.idPath "
-                          "WHERE movie.c%02d LIKE '%%%s%%' OR movie.c%02d LIKE '%%%s%%'",
+                          "WHERE (movie.c%02d LIKE '%%%s%%' OR movie.c%02d LIKE '%%%s%%')",
                           VIDEODB_ID_TITLE, VIDEODB_ID_TITLE, strSearch.c_str(),
                           VIDEODB_ID_ORIGINALTITLE, strSearch.c_str());
     else
       strSQL = PrepareSQL("SELECT movie.idMovie,movie.c%02d, movie.idSet FROM movie WHERE "
-                          "movie.c%02d like '%%%s%%' OR movie.c%02d LIKE '%%%s%%'",
+                          "(movie.c%02d like '%%%s%%' OR movie.c%02d LIKE '%%%s%%')",
                           VIDEODB_ID_TITLE, VIDEODB_ID_TITLE, strSearch.c_str(),
                           VIDEODB_ID_ORIGINALTITLE, strSearch.c_str());
+
+    // let the full-text index narrow down the rows to check
+    const std::string fullText = GetFullTextCondition("movie", "movie.idMovie", strSearch);
+    if (!fullText.empty())
+      strSQL += " AND " + fullText;
+
     m_pDS->query( strSQL );
 
     while (!m_pDS->eof())
@@ -9045,6 +9131,12 @@ void CVideoDatabase::GetTvShowsByName(const std::string& strSearch, CFileItemLis
       strSQL = PrepareSQL("SELECT tvshow.idShow, tvshow.c%02d, path.strPath FROM tvshow INNER JOIN tvshowlinkpath ON tvshowlinkpath.idShow=tvshow.idShow INNER JOIN path ON path.idPath=tvshowlinkpath.idPath WHERE tvshow.c%02d LIKE '%%%s%%'", VIDEODB_ID_TV_TITLE, VIDEODB_ID_TV_TITLE, strSearch.c_str());
     else
       strSQL = PrepareSQL("select tvshow.idShow,tvshow.c%02d from tvshow where tvshow.c%02d like '%%%s%%'",VIDEODB_ID_TV_TITLE,VIDEODB_ID_TV_TITLE,strSearch.c_str());
+
+    // let the full-text index narrow down the rows to check
+    const std::string fullText = GetFullTextCondition("tvshow", "tvshow.idShow", strSearch);
+    if (!fullText.empty())
+      strSQL += " AND " + fullText;
+
     m_pDS->query( strSQL );
 
     while (!m_pDS->eof())
@@ -9089,6 +9181,12 @@ void CVideoDatabase::GetEpisodesByName(const std::string& strSearch, CFileItemLi
       strSQL = PrepareSQL("SELECT episode.idEpisode, episode.c%02d, episode.c%02d, episode.idShow, tvshow.c%02d, path.strPath FROM episode INNER JOIN tvshow ON tvshow.idShow=episode.idShow INNER JOIN files ON files.idFile=episode.idFile INNER JOIN path ON path.idPath=files.idPath WHERE episode.c%02d LIKE '%%%s%%'", VIDEODB_ID_EPISODE_TITLE, VIDEODB_ID_EPISODE_SEASON, VIDEODB_ID_TV_TITLE, VIDEODB_ID_EPISODE_TITLE, strSearch.c_str());
     else
       strSQL = PrepareSQL("SELECT episode.idEpisode, episode.c%02d, episode.c%02d, episode.idShow, tvshow.c%02d FROM episode INNER JOIN tvshow ON tvshow.idShow=episode.idShow WHERE episode.c%02d like '%%%s%%'", VIDEODB_ID_EPISODE_TITLE, VIDEODB_ID_EPISODE_SEASON, VIDEODB_ID_TV_TITLE, VIDEODB_ID_EPISODE_TITLE, strSearch.c_str());
+
+    // let the full-text index narrow down the rows to check
+    const std::string fullText = GetFullTextCondition("episode", "episode.idEpisode", strSearch);
+    if (!fullText.empty())
+      strSQL += " AND " + fullText;
+
     m_pDS->query( strSQL );
 
     while (!m_pDS->eof())
@@ -9136,6 +9234,12 @@ void CVideoDatabase::GetMusicVideosByName(const std::string& strSearch, CFileIte
       strSQL = PrepareSQL("SELECT musicvideo.idMVideo, musicvideo.c%02d, path.strPath FROM musicvideo INNER JOIN files ON files.idFile=musicvideo.idFile INNER JOIN path ON path.idPath=files.idPath WHERE musicvideo.c%02d LIKE '%%%s%%'", VIDEODB_ID_MUSICVIDEO_TITLE, VIDEODB_ID_MUSICVIDEO_TITLE, strSearch.c_str());
     else
       strSQL = PrepareSQL("select musicvideo.idMVideo,musicvideo.c%02d from musicvideo where musicvideo.c%02d like '%%%s%%'",VIDEODB_ID_MUSICVIDEO_TITLE,VIDEODB_ID_MUSICVIDEO_TITLE,strSearch.c_str());
+
+    // let the full-text index narrow down the rows to check
+    const std::string fullText = GetFullTextCondition("musicvideo", "musicvideo.idMVideo", strSearch);
+    if (!fullText.empty())
+      strSQL += " AND " + fullText;
+
     m_pDS->query( strSQL );
 
     while (!m_pDS->eof())
@@ -9754,6 +9858,9 @@ void CVideoDatabase::CleanDatabase(CGUIDialogProgressBarHandle* handle,
 
       CommitTransaction();
 
+      // verify the stored rows of the materialized views after the bulk changes
+      CheckMaterializedViews();
+
       if (handle)
         handle->SetTitle(g_localizeStrings.Get(331));
 
@@ -11205,8 +11312,27 @@ bool CVideoDatabase::GetFilter(CDbUrl &videoUrl, Filter &filter, SortDescription
         // of the path (season and episodeid) appended later
        (xsp.GetType() == "episodes" && itemType == "tvshows"))
     {
-      std::set<std::string> playlists;
-      filter.AppendWhere(xsp.GetWhereClause(*this, playlists));
+      // the ids of playlists listing their own type can be resolved from the item's view
+      std::string view;
+      std::string idField;
+      if (xsp.GetType() == itemType)
+      {
+        if (itemType == "movies")
+          idField = "idMovie";
+        else if (itemType == "tvshows")
+          idField = "idShow";
+        else if (itemType == "episodes")
+          idField = "idEpisode";
+        else if (itemType == "musicvideos")
+          idField = "idMVideo";
+        if (!idField.empty())
+        {
+          view = itemType.substr(0, itemType.size() - 1) + "_view";
+          idField = view + "." + idField;
+        }
+      }
+      filter.AppendWhere(
+          GetSmartPlaylistWhereClause(xsp, option->second.asString(), itemType, view, idField));
 
       if (xsp.GetLimit() > 0)
         sorting.limitEnd = xsp.GetLimit();
@@ -1089,6 +1089,14 @@ private:
    */
   virtual void CreateViews();
 
+  /*! \brief Refresh the rows of a materialized view of a media type whenever the
+     media, its file, path, resume bookmark, ratings or unique ids change
+   */
+  void CreateMaterializedViewTriggers(const std::string& view,
+                                      const std::string& table,
+                                      const std::string& idColumn,
+                                      const std::string& mediaType);
+
   /*! \brief Helper to get a database id given a query.
    Returns an integer, -1 if not found, and greater than 0 if found.
    \param query the SQL that will retrieve a database id.
@@ -1120,7 +1120,19 @@ namespace VIDEO
 
   bool CVideoInfoScanner::EnumerateEpisodeItem(const CFileItem *item, EPISODELIST& episodeList)
   {
-    SETTINGS_TVSHOWLIST expression = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_tvshowEnumRegExps;
+    const SETTINGS_TVSHOWLIST& expression =
+        CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_tvshowEnumRegExps;
+
+    // (re)build the matcher whenever the expressions changed
+    if (!m_episodeRegExps || m_episodeRegExps->Size() != expression.size() ||
+        !std::equal(expression.begin(), expression.end(), m_episodeRegExps->GetPatterns().begin(),
+                    [](const TVShowRegexp& re, const std::string& pattern)
+                    { return re.regexp == pattern; }))
+    {
+      m_episodeRegExps = std::make_unique<CRegExpSet>(true, CRegExp::autoUtf8);
+      for (const auto& re : expression)
+        m_episodeRegExps->Add(re.regexp);
+    }
 
     std::string strLabel;
 
@@ -1136,16 +1148,12 @@ namespace VIDEO
     // URLDecode in case an episode is on a http/https/dav/davs:// source and URL-encoded like foo%201x01%20bar.avi
     strLabel = CURL::Decode(CURL::GetRedacted(strLabel));
 
-    for (unsigned int i=0;i<expression.size();++i)
+    int match = -1;
+    while ((match = m_episodeRegExps->RegFind(strLabel, match + 1)) >= 0)
     {
-      CRegExp reg(true, CRegExp::autoUtf8);
-      if (!reg.RegComp(expression[i].regexp))
-        continue;
-
+      const unsigned int i = static_cast<unsigned int>(match);
+      CRegExp& reg = m_episodeRegExps->GetRegExp(i);
       int regexppos, regexp2pos;
-      //CLog::Log(LOGDEBUG,"running expression {} on {}",expression[i].regexp,strLabel);
-      if ((regexppos = reg.RegFind(strLabel.c_str())) < 0)
-        continue;
 
       EPISODE episode;
       episode.strPath = item->GetPath();
@@ -1220,7 +1228,7 @@ namespace VIDEO
 
       CRegExp reg2(true, CRegExp::autoUtf8);
       // check the remainder of the string for any further episodes.
-      if (!byDate && reg2.RegComp(CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_tvshowMultiPartEnumRegExp))
+      if (!byDate && reg2.RegCompShared(CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_tvshowMultiPartEnumRegExp))
       {
         int offset = 0;
 
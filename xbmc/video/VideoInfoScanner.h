@@ -13,11 +13,13 @@
 #include "addons/Scraper.h"
 #include "guilib/GUIListItem.h"
 
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
 
 class CRegExp;
+class CRegExpSet;
 class CFileItem;
 class CFileItemList;
 
@@ -242,6 +244,7 @@ namespace VIDEO
     CVideoDatabase m_database;
     std::set<std::string> m_pathsToCount;
     std::set<int> m_pathsToClean;
+    std::unique_ptr<CRegExpSet> m_episodeRegExps; // compiled m_tvshowEnumRegExps
 
   private:
     static void AddLocalItemArtwork(CGUIListItem::ArtMap& itemArt,
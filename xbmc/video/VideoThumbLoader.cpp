@@ -27,6 +27,7 @@
 #include "settings/SettingUtils.h"
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
+#include "utils/CPUInfo.h"
 #include "utils/EmbeddedArt.h"
 #include "utils/StringUtils.h"
 #include "utils/URIUtils.h"
@@ -37,6 +38,7 @@
 
 #include <algorithm>
 #include <cstdlib>
+#include <mutex>
 #include <utility>
 
 using namespace XFILE;
@@ -179,8 +181,63 @@ bool CThumbExtractor::DoWork()
   return false;
 }
 
+CChapterThumbExtractor::CChapterThumbExtractor(const CFileItem& item,
+                                               std::vector<Chapter> chapters)
+  : m_item(item), m_chapters(std::move(chapters))
+{
+}
+
+CChapterThumbExtractor::~CChapterThumbExtractor() = default;
+
+bool CChapterThumbExtractor::operator==(const CJob* job) const
+{
+  if (strcmp(job->GetType(), GetType()) == 0)
+  {
+    const CChapterThumbExtractor* jobExtract = dynamic_cast<const CChapterThumbExtractor*>(job);
+    if (jobExtract && jobExtract->m_item.GetPath() == m_item.GetPath() &&
+        jobExtract->m_chapters.size() == m_chapters.size() &&
+        std::equal(m_chapters.begin(), m_chapters.end(), jobExtract->m_chapters.begin(),
+                   [](const Chapter& lhs, const Chapter& rhs) { return lhs.target == rhs.target; }))
+      return true;
+  }
+  return false;
+}
+
+bool CChapterThumbExtractor::DoWork()
+{
+  if (m_chapters.empty())
+    return false;
+
+  CLog::Log(LOGDEBUG, "{} - trying to extract {} chapter thumbs from video file {}", __FUNCTION__,
+            m_chapters.size(), CURL::GetRedacted(m_item.GetPath()));
+
+  std::vector<int64_t> positions;
+  std::vector<CTextureDetails> details(m_chapters.size());
+  positions.reserve(m_chapters.size());
+  for (size_t i = 0; i < m_chapters.size(); ++i)
+  {
+    positions.emplace_back(m_chapters[i].pos);
+    details[i].file = CTextureCache::GetCacheFile(m_chapters[i].target) + ".jpg";
+  }
+
+  const std::vector<bool> extracted = CDVDFileInfo::ExtractThumbs(m_item, positions, details);
+
+  bool result = false;
+  for (size_t i = 0; i < m_chapters.size(); ++i)
+  {
+    if (!extracted[i])
+      continue;
+
+    CServiceBroker::GetTextureCache()->AddCachedTexture(m_chapters[i].target, details[i]);
+    m_chapters[i].extracted = true;
+    result = true;
+  }
+
+  return result;
+}
+
 CVideoThumbLoader::CVideoThumbLoader() :
-  CThumbLoader(), CJobQueue(true, 1, CJob::PRIORITY_LOW_PAUSABLE)
+  CThumbLoader(), CJobQueue(true, GetMaxExtractJobs(), CJob::PRIORITY_LOW_PAUSABLE)
 {
   m_videoDatabase = new CVideoDatabase();
 }
@@ -715,6 +772,14 @@ bool CVideoThumbLoader::GetEmbeddedThumb(const std::string& path,
   return !art.Empty();
 }
 
+unsigned int CVideoThumbLoader::GetMaxExtractJobs()
+{
+  const unsigned int jobs =
+      CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_videoThumbExtractJobs;
+  const int cpus = CServiceBroker::GetCPUInfo()->GetCPUCount();
+  return std::max(1u, std::min(jobs, static_cast<unsigned int>(std::max(cpus, 1))));
+}
+
 void CVideoThumbLoader::OnJobComplete(unsigned int jobID, bool success, CJob* job)
 {
   if (success)
@@ -723,7 +788,11 @@ void CVideoThumbLoader::OnJobComplete(unsigned int jobID, bool success, CJob* jo
     loader->m_item.SetPath(loader->m_listpath);
 
     if (m_pObserver)
+    {
+      // several extractions may finish at the same time
+      std::unique_lock<CCriticalSection> lock(m_observerSection);
       m_pObserver->OnItemLoaded(&loader->m_item);
+    }
     CFileItemPtr pItem(new CFileItem(loader->m_item));
     CGUIMessage msg(GUI_MSG_NOTIFY_ALL, 0, 0, GUI_MSG_UPDATE_ITEM, 0, pItem);
     CServiceBroker::GetGUI()->GetWindowManager().SendThreadMessage(msg);
@@ -56,6 +56,41 @@ public:
   bool m_fillStreamDetails; ///< fill in stream details?
 };
 
+/*!
+ \ingroup thumbs,jobs
+ \brief Chapter thumb extractor job class
+
+ Extracts the thumbs of several chapters of one video file with a single open of the file.
+
+ \sa CThumbExtractor and CDVDFileInfo::ExtractThumbs
+ */
+class CChapterThumbExtractor : public CJob
+{
+public:
+  struct Chapter
+  {
+    unsigned int index; ///< chapter number
+    std::string target; ///< thumbpath
+    int64_t pos; ///< position to extract thumb from
+    bool extracted = false; ///< set by DoWork
+  };
+
+  CChapterThumbExtractor(const CFileItem& item, std::vector<Chapter> chapters);
+  ~CChapterThumbExtractor() override;
+
+  bool DoWork() override;
+
+  const char* GetType() const override
+  {
+    return kJobTypeMediaFlags;
+  }
+
+  bool operator==(const CJob* job) const override;
+
+  CFileItem m_item;
+  std::vector<Chapter> m_chapters;
+};
+
 class CVideoThumbLoader : public CThumbLoader, public CJobQueue
 {
 public:
@@ -121,8 +156,14 @@ public:
                                const std::string& type,
                                EmbeddedArt& art);
 
+  /*! \brief The number of thumb extraction jobs to run in parallel
+   Configured by the thumbextractjobs advanced setting, limited to the number of cores.
+   */
+  static unsigned int GetMaxExtractJobs();
+
 protected:
   CVideoDatabase *m_videoDatabase;
+  CCriticalSection m_observerSection;
   ArtCache m_artCache;
 
   /*! \brief Tries to detect missing data/info from a file and adds those
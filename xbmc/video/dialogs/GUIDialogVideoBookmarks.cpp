@@ -38,6 +38,7 @@
 #include "video/VideoThumbLoader.h"
 #include "view/ViewState.h"
 
+#include <algorithm>
 #include <mutex>
 #include <string>
 #include <vector>
@@ -52,7 +53,7 @@
 
 CGUIDialogVideoBookmarks::CGUIDialogVideoBookmarks()
     : CGUIDialog(WINDOW_DIALOG_VIDEO_BOOKMARKS, "VideoOSDBookmarks.xml"),
-    CJobQueue(false, 1, CJob::PRIORITY_NORMAL)
+    CJobQueue(false, CVideoThumbLoader::GetMaxExtractJobs(), CJob::PRIORITY_NORMAL)
 {
   m_vecItems = new CFileItemList;
   m_loadType = LOAD_EVERY_TIME;
@@ -269,6 +270,7 @@ void CGUIDialogVideoBookmarks::OnRefreshList()
   // add chapters if around
   const auto& components = CServiceBroker::GetAppComponents();
   const auto appPlayer = components.GetComponent<CApplicationPlayer>();
+  std::vector<CChapterThumbExtractor::Chapter> pendingChapters;
   for (int i = 1; i <= appPlayer->GetChapterCount(); ++i)
   {
     std::string chapterName;
@@ -292,10 +294,7 @@ void CGUIDialogVideoBookmarks::OnRefreshList()
       item->SetArt("thumb", cachefile);
     else if (i > m_jobsStarted && CServiceBroker::GetSettingsComponent()->GetSettings()->GetBool(CSettings::SETTING_MYVIDEOS_EXTRACTCHAPTERTHUMBS))
     {
-      CFileItem item(m_filePath, false);
-      CJob* job = new CThumbExtractor(item, m_filePath, true, chapterPath, pos * 1000, false);
-      AddJob(job);
-      m_mapJobsChapter[job] = i;
+      pendingChapters.push_back({static_cast<unsigned int>(i), chapterPath, pos * 1000});
       m_jobsStarted++;
     }
 
@@ -305,6 +304,24 @@ void CGUIDialogVideoBookmarks::OnRefreshList()
     items.push_back(item);
   }
 
+  // spread the chapters over a few jobs, each extracting its share with a single open of the file
+  if (!pendingChapters.empty())
+  {
+    const size_t numJobs = std::min<size_t>(pendingChapters.size(),
+                                            CVideoThumbLoader::GetMaxExtractJobs());
+    std::vector<std::vector<CChapterThumbExtractor::Chapter>> batches(numJobs);
+    for (size_t i = 0; i < pendingChapters.size(); ++i)
+      batches[i % batches.size()].push_back(pendingChapters[i]);
+
+    const CFileItem fileItem(m_filePath, false);
+    for (auto& batch : batches)
+    {
+      CJob* job = new CChapterThumbExtractor(fileItem, std::move(batch));
+      m_chapterJobs.insert(job);
+      AddJob(job);
+    }
+  }
+
   // sort items by resume point
   std::sort(items.begin(), items.end(), [](const CFileItemPtr &item1, const CFileItemPtr &item2) {
     return item1->GetProperty("resumepoint").asDouble() < item2->GetProperty("resumepoint").asDouble();
@@ -479,7 +496,7 @@ void CGUIDialogVideoBookmarks::OnWindowLoaded()
   m_viewControl.SetParentWindow(GetID());
   m_viewControl.AddView(GetControl(CONTROL_THUMBS));
   m_jobsStarted = 0;
-  m_mapJobsChapter.clear();
+  m_chapterJobs.clear();
   m_vecItems->Clear();
 }
 
@@ -487,7 +504,7 @@ void CGUIDialogVideoBookmarks::OnWindowUnload()
 {
   //stop running thumb extraction jobs
   CancelJobs();
-  m_mapJobsChapter.clear();
+  m_chapterJobs.clear();
   m_vecItems->Clear();
   CGUIDialog::OnWindowUnload();
   m_viewControl.Reset();
@@ -575,16 +592,26 @@ bool CGUIDialogVideoBookmarks::OnAddEpisodeBookmark()
 void CGUIDialogVideoBookmarks::OnJobComplete(unsigned int jobID,
                                              bool success, CJob* job)
 {
-  if (success && IsActive())
+  // chapter jobs run in parallel, guard the job set
+  std::unique_lock<CCriticalSection> lock(m_refreshSection);
+  SETJOBSCHAPS::iterator iter = m_chapterJobs.find(job);
+  if (iter != m_chapterJobs.end())
   {
-    MAPJOBSCHAPS::iterator iter = m_mapJobsChapter.find(job);
-    if (iter != m_mapJobsChapter.end())
+    m_chapterJobs.erase(iter);
+    if (success && IsActive())
     {
-      unsigned int chapterIdx = (*iter).second;
-      CGUIMessage m(GUI_MSG_REFRESH_LIST, GetID(), 0, 1, chapterIdx);
-      CServiceBroker::GetAppMessenger()->SendGUIMessage(m);
-      m_mapJobsChapter.erase(iter);
+      const CChapterThumbExtractor* extractor = static_cast<const CChapterThumbExtractor*>(job);
+      for (const auto& chapter : extractor->m_chapters)
+      {
+        if (!chapter.extracted)
+          continue;
+
+        CGUIMessage m(GUI_MSG_REFRESH_LIST, GetID(), 0, 1, chapter.index);
+        CServiceBroker::GetAppMessenger()->SendGUIMessage(m);
+      }
     }
   }
+  lock.unlock();
+
   CJobQueue::OnJobComplete(jobID, success, job);
 }
@@ -13,11 +13,13 @@
 #include "video/VideoDatabase.h"
 #include "view/GUIViewControl.h"
 
+#include <set>
+
 class CFileItemList;
 
 class CGUIDialogVideoBookmarks : public CGUIDialog, public CJobQueue
 {
-  typedef std::map<CJob*, unsigned int> MAPJOBSCHAPS;
+  typedef std::set<CJob*> SETJOBSCHAPS;
 
 public:
   CGUIDialogVideoBookmarks(void);
@@ -72,5 +74,5 @@ private:
   int m_jobsStarted;
   std::string m_filePath;
   CCriticalSection m_refreshSection;
-  MAPJOBSCHAPS m_mapJobsChapter;
+  SETJOBSCHAPS m_chapterJobs;
 };